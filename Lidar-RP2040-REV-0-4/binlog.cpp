@@ -0,0 +1,181 @@
+/**
+ * @file binlog.cpp
+ * @brief This file contains the implementation of the deferred binary log.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the per-core record rings, the format table, and the Core 1
+ * drain that formats records off the hot path.
+ */
+
+#include "binlog.h"
+#include "diag_governor.h"
+
+/**
+ * @brief Format strings indexed by BinLogFormatId.
+ *
+ * @details Only integer and floating point conversions are supported. Length
+ * modifiers are ignored; every argument is a 32-bit word.
+ */
+static const char* const binlog_formats[BLOG_FORMAT_COUNT] = {
+  "Core 0: Sensor %d sync failure #%lu - Expected: 0x%02X, Got: 0x%02X",
+  "Core 0: Sensor %d - Too many sync failures, performing emergency health check",
+  "Core 0: Sensor %d checksum mismatch - Calculated: 0x%02X, Received: 0x%02X",
+  "Core 0: Bad frame data: %08lX %08lX %02lX",
+  "Core 0: Sensor %d frame validation failed - Dist: %d (range: %d-%d), Strength: %d (min: %d)",
+  "Core 0: Sensor %d frame timeout after %lu microseconds (partial frame, index: %d)",
+  "Core 0: CRITICAL - Sensor %d buffer overflow! Dropping frames (util: %d/%d)",
+  "Core 1: TRIGGER! Sensor=%d, Distance=%dcm, Velocity=%.1fcm/s, Switch=%d",
+  "Core 1: TRIGGER! Fused (sources 0x%02X), Distance=%dcm, Velocity=%.1fcm/s, Switch=%d",
+  "Core 1: Executing GUI command: 0x%02X",
+  "Core 1: Fusion mode %d -> %d (0 = dual, 1 = sensor A only, 2 = sensor B only, 3 = no sensor)",
+};
+
+/**
+ * @brief A single-producer/single-consumer record ring owned by one core.
+ */
+struct BinLogRing {
+  BinLogRecord records[BINLOG_RING_SIZE];
+  std::atomic<uint16_t> head{0};    ///< Written only by the owning core.
+  std::atomic<uint16_t> tail{0};    ///< Written only by the Core 1 drain.
+  std::atomic<uint32_t> dropped{0}; ///< Written only by the owning core.
+};
+
+static BinLogRing binlog_rings[2];
+
+/**
+ * @brief Appends a record to the calling core's ring.
+ *
+ * @details Never blocks. If the ring is full the record is discarded and the
+ * core's dropped counter is incremented.
+ *
+ * @param id The format ID.
+ * @param arg_count The number of arguments.
+ * @param float_mask Bit n set if argument n is a float.
+ * @param args The raw argument words.
+ */
+void binlogWrite(BinLogFormatId id, uint8_t arg_count, uint8_t float_mask, const uint32_t* args) {
+  BinLogRing& ring = binlog_rings[get_core_num()];
+  uint16_t head = ring.head.load(std::memory_order_relaxed);
+  uint16_t tail = ring.tail.load(std::memory_order_acquire);
+
+  if ((uint16_t)(head - tail) >= BINLOG_RING_SIZE) {
+    ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return;
+  }
+
+  BinLogRecord& record = ring.records[head & (BINLOG_RING_SIZE - 1)];
+  record.format_id = id;
+  record.arg_count = arg_count;
+  record.float_mask = float_mask;
+  for (uint8_t i = 0; i < arg_count; i++) {
+    record.args[i] = args[i];
+  }
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Gets the number of records dropped by a core since boot.
+ * @param core The core number (0 or 1).
+ * @return The dropped record count.
+ */
+uint32_t binlogDroppedCount(uint8_t core) {
+  return binlog_rings[core].dropped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Formats one record into a line of text.
+ * @param record The record.
+ * @param out The output buffer.
+ * @param size The size of the output buffer.
+ * @return The length of the formatted line.
+ */
+static size_t formatRecord(const BinLogRecord& record, char* out, size_t size) {
+  if (record.format_id >= BLOG_FORMAT_COUNT) {
+    return snprintf(out, size, "binlog: unknown format %d", record.format_id);
+  }
+
+  const char* fmt = binlog_formats[record.format_id];
+  size_t pos = 0;
+  uint8_t arg = 0;
+
+  while (*fmt && pos < size - 1) {
+    if (*fmt != '%' || fmt[1] == '%') {
+      out[pos++] = *fmt;
+      fmt += (*fmt == '%') ? 2 : 1;
+      continue;
+    }
+
+    // Copy one conversion spec, dropping length modifiers
+    char spec[12];
+    uint8_t spec_len = 0;
+    spec[spec_len++] = *fmt++;
+    while (*fmt && !strchr("diuxXcfeEgG", *fmt)) {
+      if (*fmt != 'l' && *fmt != 'h' && spec_len < sizeof(spec) - 2) spec[spec_len++] = *fmt;
+      fmt++;
+    }
+    char conversion = *fmt;
+    if (conversion) fmt++;
+    spec[spec_len++] = conversion;
+    spec[spec_len] = '\0';
+
+    uint32_t word = (arg < record.arg_count) ? record.args[arg] : 0;
+    int written;
+    if (record.float_mask & (1 << arg)) {
+      float value;
+      memcpy(&value, &word, sizeof(value));
+      written = snprintf(out + pos, size - pos, spec, (double)value);
+    } else if (conversion == 'd' || conversion == 'i') {
+      written = snprintf(out + pos, size - pos, spec, (int)word);
+    } else {
+      written = snprintf(out + pos, size - pos, spec, (unsigned int)word);
+    }
+    arg++;
+    if (written > 0) pos += min((size_t)written, size - 1 - pos);
+  }
+  out[pos] = '\0';
+  return pos;
+}
+
+/**
+ * @brief Formats pending records and writes them to Serial. Called from the Core 1 loop.
+ *
+ * @details Returns immediately if another writer holds the serial mutex. A record is
+ * only written, and only then removed from its ring, when the USB transmit space
+ * left to text output can take the whole line, so the drain never blocks on the
+ * host or delays GUI packets. Newly dropped records are reported once per drain.
+ */
+void binlogDrain() {
+  static uint32_t reported_dropped[2] = { 0, 0 };
+  char line[DEBUG_BUFFER_SIZE];
+  uint8_t drained = 0;
+
+  if (!mutex_try_enter(&serial_mutex, nullptr)) return;
+
+  for (uint8_t core = 0; core < 2; core++) {
+    BinLogRing& ring = binlog_rings[core];
+
+    uint32_t dropped = ring.dropped.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped[core]) {
+      size_t len = snprintf(line, sizeof(line), "binlog: core %d dropped %lu records",
+                            core, (unsigned long)(dropped - reported_dropped[core]));
+      if (diagTextTxSpace() < (int)len + 2) break;
+      Serial.println(line);
+      reported_dropped[core] = dropped;
+    }
+
+    while (drained < BINLOG_DRAIN_PER_CALL) {
+      uint16_t tail = ring.tail.load(std::memory_order_relaxed);
+      if (tail == ring.head.load(std::memory_order_acquire)) break;
+
+      size_t len = formatRecord(ring.records[tail & (BINLOG_RING_SIZE - 1)], line, sizeof(line));
+      if (diagTextTxSpace() < (int)len + 2) break;
+      Serial.println(line);
+      ring.tail.store(tail + 1, std::memory_order_release);
+      drained++;
+    }
+  }
+
+  mutex_exit(&serial_mutex);
+}
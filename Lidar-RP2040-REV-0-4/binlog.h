@@ -0,0 +1,98 @@
+/**
+ * @file binlog.h
+ * @brief This file contains the declarations for the deferred binary log.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Hot-path diagnostics are logged as a format ID plus raw 32-bit arguments
+ * into a lock-free single-producer/single-consumer ring owned by the calling core.
+ * Nothing is formatted and no mutex is taken at the call site. Core 1 formats the
+ * records and writes them to Serial when it is idle, and only as far as the USB
+ * transmit buffer has room. A full ring drops the new record and counts it instead
+ * of blocking the caller.
+ */
+#ifndef BINLOG_H
+#define BINLOG_H
+
+#include "globals.h"
+#include <atomic>
+#include <type_traits>
+
+/** @brief Records per core ring - must be a power of two */
+#define BINLOG_RING_SIZE 32
+/** @brief Maximum number of arguments per record */
+#define BINLOG_MAX_ARGS 6
+/** @brief Maximum records formatted per binlogDrain() call - bounds the time taken from Core 1 */
+#define BINLOG_DRAIN_PER_CALL 4
+
+/**
+ * @brief Format IDs of all binary log call sites. The format strings live in binlog.cpp.
+ */
+enum BinLogFormatId : uint8_t {
+  BLOG_SYNC_FAILURE,          ///< Sensor, failure count, expected byte, received byte.
+  BLOG_SYNC_FAILURE_LIMIT,    ///< Sensor.
+  BLOG_CHECKSUM_MISMATCH,     ///< Sensor, calculated, received.
+  BLOG_BAD_FRAME_DATA,        ///< Frame bytes 0-3, 4-7 and 8, packed big-endian.
+  BLOG_VALIDATION_FAILED,     ///< Sensor, distance, min, max, strength, min strength.
+  BLOG_FRAME_TIMEOUT,         ///< Sensor, timeout, partial frame index.
+  BLOG_BUFFER_OVERFLOW,       ///< Sensor, queue fill, queue size.
+  BLOG_TRIGGER,               ///< Sensor, distance, velocity (float), switch code.
+  BLOG_TRIGGER_FUSED,         ///< Sources, distance, velocity (float), switch code.
+  BLOG_GUI_COMMAND,           ///< Command byte.
+  BLOG_FUSION_MODE,           ///< Previous and new FusionMode.
+  BLOG_FORMAT_COUNT
+};
+
+/**
+ * @brief One binary log record.
+ */
+struct BinLogRecord {
+  uint8_t format_id;                ///< BinLogFormatId of the call site.
+  uint8_t arg_count;                ///< Number of valid entries in args.
+  uint8_t float_mask;               ///< Bit n set if args[n] holds a float.
+  uint32_t args[BINLOG_MAX_ARGS];   ///< Raw argument words.
+};
+
+void binlogWrite(BinLogFormatId id, uint8_t arg_count, uint8_t float_mask, const uint32_t* args);
+void binlogDrain();
+uint32_t binlogDroppedCount(uint8_t core);
+
+/** @brief Converts an integer argument to its raw record word. */
+template <typename T>
+inline uint32_t binlogWord(T value) { return (uint32_t)value; }
+
+/** @brief Converts a float argument to its raw record word. */
+inline uint32_t binlogWord(float value) {
+  uint32_t word;
+  memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+/** @brief Doubles are logged as floats. */
+inline uint32_t binlogWord(double value) { return binlogWord((float)value); }
+
+/** @brief Builds the float mask of an argument list at compile time. */
+template <typename... Args>
+constexpr uint8_t binlogFloatMask() {
+  constexpr bool is_float[] = { std::is_floating_point<Args>::value..., false };
+  uint8_t mask = 0;
+  for (size_t i = 0; i < sizeof...(Args); i++) {
+    if (is_float[i]) mask |= (1 << i);
+  }
+  return mask;
+}
+
+/**
+ * @brief Logs a record without formatting or blocking.
+ * @param id The format ID of the call site.
+ * @param args Up to BINLOG_MAX_ARGS integer or floating point arguments.
+ */
+template <typename... Args>
+inline void binlog(BinLogFormatId id, Args... args) {
+  static_assert(sizeof...(Args) <= BINLOG_MAX_ARGS, "Too many binlog arguments");
+  const uint32_t words[] = { binlogWord(args)..., 0 };
+  binlogWrite(id, sizeof...(Args), binlogFloatMask<Args...>(), words);
+}
+
+#endif // BINLOG_H
@@ -98,4 +98,17 @@ void AdaptiveVelocityCalculator::addFrame(const LidarFrame& frame) {
     }
     history[0] = frame;
     if (count < MAX_HISTORY) count++;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Copies the estimator's internal state.
+ *
+ * @param state Receives the state.
+ */
+void AdaptiveVelocityCalculator::getState(VelocityEstimatorState& state) const {
+    memset(&state, 0, sizeof(state));
+    state.last_velocity = last_velocity;
+    state.last_movement_time = last_movement_time;
+    state.error_count = error_count;
+    state.history_count = count;
+}
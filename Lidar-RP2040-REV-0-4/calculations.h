@@ -15,6 +15,17 @@
 
 #include "globals.h"
 
+/**
+ * @brief Internal state of a velocity estimator, as captured in trigger snapshots (16 bytes).
+ */
+struct VelocityEstimatorState {
+  float last_velocity;          ///< The last calculated velocity in cm/s.
+  uint32_t last_movement_time;  ///< millis() of the last successful calculation.
+  uint32_t error_count;         ///< Consecutive failed calculations.
+  uint8_t history_count;        ///< Frames in the history.
+  uint8_t reserved[3];          ///< Zero.
+};
+
 /**
  * @class AdaptiveVelocityCalculator
  * @brief Calculates velocity adaptively from LiDAR frames.
@@ -69,6 +80,13 @@ public:
    * @param frame The LidarFrame to add.
    */
   void addFrame(const LidarFrame& frame);
+
+  /**
+   * @brief Copies the estimator's internal state.
+   *
+   * @param state Receives the state.
+   */
+  void getState(VelocityEstimatorState& state) const;
 };
 
 #endif // CALCULATIONS_H
\ No newline at end of file
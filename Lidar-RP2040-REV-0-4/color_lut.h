@@ -0,0 +1,203 @@
+/**
+ * @file color_lut.h
+ * @brief This file contains the compile-time color lookup tables and fixed-point color helpers.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The RP2040's Cortex-M0+ has no FPU, so every float multiply in the LED
+ * path is a soft-float call. The tables here are generated by the compiler and
+ * live in flash; at runtime a color is a table read plus integer multiplies.
+ * Gamma correction shares the gamma8 curve of the Adafruit_NeoPixel library
+ * rather than carrying a second table.
+ *
+ * Apart from gamma the helpers use no Arduino APIs, so host tools build this
+ * file unchanged (tools/color_lut).
+ */
+#ifndef COLOR_LUT_H
+#define COLOR_LUT_H
+
+#ifdef ARDUINO
+#include "globals.h"
+#include <Adafruit_NeoPixel.h>
+#else
+#include <stdint.h>
+
+/** @brief Host build: must match MIN_DISTANCE_CM in globals.h. */
+#define MIN_DISTANCE_CM 7
+/** @brief Host build: must match MAX_DISTANCE_CM in globals.h. */
+#define MAX_DISTANCE_CM 1200
+#endif
+
+/**
+ * @brief A 256-entry color table in 0x00RRGGBB format.
+ */
+struct ColorTable {
+  uint32_t colors[256];
+};
+
+/**
+ * @brief A brightness curve in 8.8 fixed point, with one extra entry for interpolation.
+ */
+struct CurveTable {
+  uint16_t values[257];
+};
+
+/**
+ * @brief Builds the distance gradient: red (near) to yellow (middle) to blue (far).
+ * @return The gradient table, indexed by position along the range (0-255).
+ */
+constexpr ColorTable makeGradientTable() {
+  ColorTable table = {};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t r = 0, g = 0, b = 0;
+    if (i < 128) {
+      r = 255;
+      g = 2 * i;
+      b = 0;
+    } else {
+      r = 510 - 2 * i;
+      g = 510 - 2 * i;
+      b = 2 * i - 255;
+    }
+    table.colors[i] = (r << 16) | (g << 8) | b;
+  }
+  return table;
+}
+
+/**
+ * @brief Builds the breathing curve: 2% to 100% of 255 along a parabola.
+ * @return The curve table, indexed by the distance from the dim point (0 = dim, 256 = peak).
+ */
+constexpr CurveTable makeBreathingTable() {
+  CurveTable table = {};
+  for (uint32_t i = 0; i <= 256; i++) {
+    double t = i / 256.0;
+    table.values[i] = (uint16_t)(255.0 * (0.02 + 0.98 * t * t) * 256.0 + 0.5);
+  }
+  return table;
+}
+
+/** @brief Distance gradient, generated at compile time. */
+inline constexpr ColorTable GRADIENT_TABLE = makeGradientTable();
+/** @brief Breathing curve, generated at compile time. */
+inline constexpr CurveTable BREATHING_TABLE = makeBreathingTable();
+
+/**
+ * @brief Packs 8-bit channels into a 0x00RRGGBB color.
+ */
+inline uint32_t packColor(uint32_t r, uint32_t g, uint32_t b) {
+  return (r << 16) | (g << 8) | b;
+}
+
+/**
+ * @brief Looks up the gradient color of a position.
+ * @param position The position along the range (0 = near, 255 = far).
+ * @return The color in 0x00RRGGBB format.
+ */
+inline uint32_t gradientColor8(uint8_t position) {
+  return GRADIENT_TABLE.colors[position];
+}
+
+/**
+ * @brief Calculates the gradient color of a distance, truncating each channel like the former float code.
+ *
+ * @details The channels are calculated from the exact position rather than
+ * interpolated between table entries: a channel rounded up by interpolation
+ * becomes two LSBs after the +20% saturation scale.
+ *
+ * @param distance_q8 The distance in 1/256 cm, clamped to MIN_DISTANCE_CM..MAX_DISTANCE_CM.
+ * @return The color in 0x00RRGGBB format.
+ */
+inline uint32_t distanceGradientColor(int32_t distance_q8) {
+  if (distance_q8 < (MIN_DISTANCE_CM << 8)) distance_q8 = MIN_DISTANCE_CM << 8;
+  if (distance_q8 > (MAX_DISTANCE_CM << 8)) distance_q8 = MAX_DISTANCE_CM << 8;
+
+  // Position along the range is offset / span (0 = close/hot, 1 = far/cool)
+  uint32_t offset = (uint32_t)(distance_q8 - (MIN_DISTANCE_CM << 8));
+  const uint32_t span = (uint32_t)(MAX_DISTANCE_CM - MIN_DISTANCE_CM) << 8;
+  if (2 * offset <= span) {
+    // First half: red to yellow
+    return packColor(255, 510 * offset / span, 0);
+  }
+  // Second half: yellow to blue
+  uint32_t rg = 510 * (span - offset) / span;
+  return packColor(rg, rg, (510 * offset - 255 * span) / span);
+}
+
+/**
+ * @brief Reads the breathing curve with linear interpolation.
+ * @param position_q8 The distance from the dim point in 1/256 table steps (0-65536).
+ * @return The brightness (0-255).
+ */
+inline uint8_t breathingLevel(uint32_t position_q8) {
+  uint32_t index = position_q8 >> 8;
+  if (index >= 256) return BREATHING_TABLE.values[256] >> 8;
+  uint32_t frac = position_q8 & 0xFF;
+  uint32_t value = BREATHING_TABLE.values[index] * (256 - frac) + BREATHING_TABLE.values[index + 1] * frac;
+  return (uint8_t)(value >> 16);
+}
+
+/**
+ * @brief Scales each channel of a color by num/den, saturating at 255.
+ * @param color The color in 0x00RRGGBB format.
+ * @param num The numerator.
+ * @param den The denominator.
+ * @return The scaled color.
+ */
+inline uint32_t scaleColor(uint32_t color, uint32_t num, uint32_t den) {
+  uint32_t r = ((color >> 16) & 0xFF) * num / den;
+  uint32_t g = ((color >> 8) & 0xFF) * num / den;
+  uint32_t b = (color & 0xFF) * num / den;
+  return packColor(r > 255 ? 255 : r, g > 255 ? 255 : g, b > 255 ? 255 : b);
+}
+
+/**
+ * @brief Adds two colors channel by channel, saturating at 255.
+ * @param a The first color.
+ * @param b The second color.
+ * @return The sum.
+ */
+inline uint32_t addColor(uint32_t a, uint32_t b) {
+  uint32_t r = ((a >> 16) & 0xFF) + ((b >> 16) & 0xFF);
+  uint32_t g = ((a >> 8) & 0xFF) + ((b >> 8) & 0xFF);
+  uint32_t bl = (a & 0xFF) + (b & 0xFF);
+  return packColor(r > 255 ? 255 : r, g > 255 ? 255 : g, bl > 255 ? 255 : bl);
+}
+
+/**
+ * @brief Calculates the distance display color of a smoothed sample.
+ * @param distance_q8 The smoothed distance in 1/256 cm.
+ * @param velocity_cm_s The velocity in centimeters per second.
+ * @param strength_q8 The smoothed signal strength in 1/256 steps.
+ * @return The color in 0x00RRGGBB format.
+ */
+inline uint32_t distanceColor(int32_t distance_q8, float velocity_cm_s, uint32_t strength_q8) {
+  // REV 2: Distance-based heat map colors (red → yellow → blue)
+  uint32_t color = distanceGradientColor(distance_q8);
+
+  // REV 2: Apply velocity-based saturation modulation
+  if (velocity_cm_s < -5.0f) {
+    // Approaching - make more vivid (+20% saturation)
+    color = scaleColor(color, 6, 5);
+  } else if (velocity_cm_s > 5.0f) {
+    // Receding - make more muted (-30% saturation)
+    color = scaleColor(color, 7, 10);
+  }
+
+  // Apply brightness based on signal strength (30-100%): (0.3 + 0.7 * s / 255) = (765 + 7 * s) / 2550
+  return scaleColor(color, 765 * 256 + 7 * strength_q8, 2550 * 256);
+}
+
+#ifdef ARDUINO
+/**
+ * @brief Gamma-corrects a brightness level with the NeoPixel library's curve.
+ * @param level The linear level (0-255).
+ * @return The perceptually corrected level.
+ */
+inline uint8_t gammaLevel(uint8_t level) {
+  return Adafruit_NeoPixel::gamma8(level);
+}
+#endif
+
+#endif // COLOR_LUT_H
@@ -0,0 +1,259 @@
+/**
+ * @file config_store.cpp
+ * @brief This file contains the implementation of the A/B flash configuration store.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The two slots are the first two sectors of the flash filesystem
+ * region (see flash_region.h). Records are validated where they lie in XIP
+ * flash; nothing is copied until the chosen image is applied. Saves and
+ * erases run as a small state machine stepped by configStoreService().
+ */
+
+#include "config_store.h"
+#include "crc.h"
+#include "flash_region.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_STORAGE
+#include "log.h"
+
+/** @brief Bytes programmed per save: the record rounded up to whole flash pages. */
+#define CONFIG_STORE_PROGRAM_SIZE (((sizeof(ConfigStoreRecord) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) * FLASH_PAGE_SIZE)
+/** @brief store_active_slot value while neither slot holds a valid record. */
+#define CONFIG_STORE_NO_SLOT 0xFF
+
+static_assert(sizeof(ConfigStoreRecord) <= FLASH_SECTOR_SIZE, "Configuration record does not fit in one flash sector");
+
+/**
+ * @brief Steps of the queued flash work.
+ */
+enum StoreStep : uint8_t {
+  STORE_IDLE,       ///< Nothing running.
+  STORE_ERASE,      ///< Erase the target slot of a save.
+  STORE_PROGRAM,    ///< Program and check the saved record.
+  STORE_WIPE_A,     ///< Erase slot A of a store erase.
+  STORE_WIPE_B      ///< Erase slot B of a store erase.
+};
+
+static uint8_t store_active_slot = CONFIG_STORE_NO_SLOT;  ///< Slot holding the newest valid record.
+static bool store_scanned = false;                        ///< True once the slots have been examined.
+static uint8_t store_program_buffer[CONFIG_STORE_PROGRAM_SIZE] __attribute__((aligned(4)));
+static StoreStep store_step = STORE_IDLE;
+static uint8_t store_target_slot = 0;       ///< Slot the running save writes.
+static ConfigImage store_queued_image;      ///< Newest image waiting to be saved.
+static bool store_queued = false;           ///< True if store_queued_image is waiting.
+static uint32_t store_queued_ticket = 0;    ///< Ticket of the waiting image.
+static uint32_t store_writing_ticket = 0;   ///< Ticket of the save being written.
+static uint32_t store_next_ticket = 0;      ///< Last ticket handed out.
+static uint32_t store_done_ticket = 0;      ///< Newest ticket whose record was verified.
+static uint32_t store_failed_ticket = 0;    ///< Newest ticket whose save failed or was dropped.
+
+/**
+ * @brief Checks that the filesystem region can hold both slots.
+ * @return True if the board's flash layout reserves at least two sectors.
+ */
+static bool storeRegionAvailable() {
+  return flashRegionSize() >= FLASH_REGION_CONFIG_OFFSET + 2 * FLASH_SECTOR_SIZE;
+}
+
+/**
+ * @brief Gets the region offset of a slot.
+ */
+static uint32_t slotOffset(uint8_t slot) {
+  return FLASH_REGION_CONFIG_OFFSET + slot * FLASH_SECTOR_SIZE;
+}
+
+/**
+ * @brief Gets a slot's record through the XIP window.
+ */
+static const ConfigStoreRecord* slotRecord(uint8_t slot) {
+  return (const ConfigStoreRecord*)flashRegionData(slotOffset(slot));
+}
+
+/**
+ * @brief Checks a record's marker, layout size and CRC-32.
+ */
+static bool recordValid(const ConfigStoreRecord* record) {
+  return record->magic == CONFIG_STORE_MAGIC &&
+         record->length == sizeof(ConfigImage) &&
+         crc32((const uint8_t*)record, offsetof(ConfigStoreRecord, crc)) == record->crc;
+}
+
+/**
+ * @brief Finds the slot with the newest valid record.
+ */
+static void scanSlots() {
+  store_scanned = true;
+  store_active_slot = CONFIG_STORE_NO_SLOT;
+  if (!storeRegionAvailable()) return;
+
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    const ConfigStoreRecord* record = slotRecord(slot);
+    if (!recordValid(record)) continue;
+    if (store_active_slot == CONFIG_STORE_NO_SLOT ||
+        (int32_t)(record->generation - slotRecord(store_active_slot)->generation) > 0) {
+      store_active_slot = slot;
+    }
+  }
+  if (LOG_DEBUG_ENABLED()) {
+    if (store_active_slot == CONFIG_STORE_NO_SLOT) safeSerialPrintln("Core 1: Config store holds no valid record");
+    else safeSerialPrintfln("Core 1: Config store slot %c, generation %lu",
+                            'A' + store_active_slot, slotRecord(store_active_slot)->generation);
+  }
+}
+
+/**
+ * @brief Gets the stored configuration.
+ *
+ * @details The returned image lies in XIP flash and stays valid until the
+ * second save after this call or an erase has run.
+ *
+ * @return The image of the newest valid record, or nullptr if there is none.
+ */
+const ConfigImage* configStoreActive() {
+  if (!store_scanned) scanSlots();
+  if (store_active_slot == CONFIG_STORE_NO_SLOT) return nullptr;
+  return &slotRecord(store_active_slot)->image;
+}
+
+/**
+ * @brief Gets the generation of the stored configuration.
+ * @return The newest valid record's generation, or 0 if there is none.
+ */
+uint32_t configStoreGeneration() {
+  if (!store_scanned) scanSlots();
+  if (store_active_slot == CONFIG_STORE_NO_SLOT) return 0;
+  return slotRecord(store_active_slot)->generation;
+}
+
+/**
+ * @brief Builds the record for the queued image and picks the inactive slot for it.
+ */
+static void beginSave() {
+  store_target_slot = (store_active_slot == 0) ? 1 : 0;
+  memset(store_program_buffer, 0xFF, sizeof(store_program_buffer));
+  ConfigStoreRecord* record = (ConfigStoreRecord*)store_program_buffer;
+  memset(record, 0, sizeof(ConfigStoreRecord));
+  record->magic = CONFIG_STORE_MAGIC;
+  record->generation = configStoreGeneration() + 1;
+  record->length = sizeof(ConfigImage);
+  record->image = store_queued_image;
+  record->crc = crc32((const uint8_t*)record, offsetof(ConfigStoreRecord, crc));
+  store_writing_ticket = store_queued_ticket;
+  store_queued = false;
+}
+
+/**
+ * @brief Checks the record just programmed and makes it the active one.
+ */
+static void finishSave() {
+  const ConfigStoreRecord* record = (const ConfigStoreRecord*)store_program_buffer;
+  uint8_t target = store_target_slot;
+  if (!recordValid(slotRecord(target)) || memcmp(slotRecord(target), record, sizeof(ConfigStoreRecord)) != 0) {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 1: ERROR - Config store slot %c failed verification", 'A' + target);
+    store_failed_ticket = store_writing_ticket;
+    scanSlots();
+    return;
+  }
+  store_active_slot = target;
+  store_done_ticket = store_writing_ticket;
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintfln("Core 1: Config saved to slot %c, generation %lu", 'A' + target, record->generation);
+}
+
+/**
+ * @brief Queues an image to be written to the inactive slot as the new newest record.
+ *
+ * @details The image is copied, so the caller may change the configuration
+ * straight away. The active slot is left untouched, so if power is lost
+ * before the new record is complete the previous configuration is still
+ * loaded at the next boot. The new record is read back and checked before it
+ * becomes active.
+ *
+ * @param image The image to store.
+ * @return The save's ticket, or 0 if the flash layout has no room for the store.
+ */
+uint32_t configStoreQueueSave(const ConfigImage& image) {
+  if (!store_scanned) scanSlots();
+  if (!storeRegionAvailable()) {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 1: ERROR - Flash layout has no filesystem region for the config store");
+    return 0;
+  }
+  store_queued_image = image;
+  store_queued = true;
+  store_queued_ticket = ++store_next_ticket;
+  return store_queued_ticket;
+}
+
+/**
+ * @brief Queues the erase of both slots, so the next boot starts from defaults.
+ *
+ * @details Saves that are queued or not yet complete are dropped and fail.
+ */
+void configStoreQueueErase() {
+  if (!storeRegionAvailable()) return;
+  // The queued ticket is the newest, so failing it also fails the one being written
+  if (store_queued) store_failed_ticket = store_queued_ticket;
+  else if (store_step == STORE_ERASE || store_step == STORE_PROGRAM) store_failed_ticket = store_writing_ticket;
+  store_queued = false;
+  store_step = STORE_WIPE_A;
+}
+
+/**
+ * @brief Does the next step of the queued flash work. Called from the Core 1 loop.
+ *
+ * @details A save takes two calls: the erase of the target slot (skipped if
+ * it is blank), then the program and the read-back check. An erase takes one
+ * call per slot. Each call performs at most one flash operation.
+ */
+void configStoreService() {
+  switch (store_step) {
+    case STORE_IDLE:
+      if (!store_queued) return;
+      beginSave();
+      store_step = STORE_ERASE;
+      // fall through
+    case STORE_ERASE:
+      if (!flashRegionBlank(slotOffset(store_target_slot), FLASH_SECTOR_SIZE)) {
+        flashRegionErase(slotOffset(store_target_slot), FLASH_SECTOR_SIZE);
+      }
+      store_step = STORE_PROGRAM;
+      break;
+    case STORE_PROGRAM:
+      flashRegionProgram(slotOffset(store_target_slot), store_program_buffer, CONFIG_STORE_PROGRAM_SIZE);
+      finishSave();
+      store_step = STORE_IDLE;
+      break;
+    case STORE_WIPE_A:
+    case STORE_WIPE_B: {
+      uint8_t slot = store_step - STORE_WIPE_A;
+      if (!flashRegionBlank(slotOffset(slot), FLASH_SECTOR_SIZE)) flashRegionErase(slotOffset(slot), FLASH_SECTOR_SIZE);
+      if (store_step == STORE_WIPE_A) {
+        store_step = STORE_WIPE_B;
+      } else {
+        scanSlots();
+        if (LOG_ERROR_ENABLED() && store_active_slot != CONFIG_STORE_NO_SLOT) safeSerialPrintln("Core 1: ERROR - Config store erase failed");
+        store_step = STORE_IDLE;
+      }
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Checks whether flash work is queued or running.
+ * @return True until every queued save and erase is complete.
+ */
+bool configStoreBusy() {
+  return store_queued || store_step != STORE_IDLE;
+}
+
+/**
+ * @brief Gets the outcome of a queued save.
+ * @param ticket The ticket returned by configStoreQueueSave().
+ * @return Done once this save or a newer one has been written and verified.
+ */
+ConfigCommitStatus configStoreCommitStatus(uint32_t ticket) {
+  if (ticket <= store_done_ticket) return CONFIG_COMMIT_DONE;
+  if (ticket <= store_failed_ticket) return CONFIG_COMMIT_FAILED;
+  return CONFIG_COMMIT_PENDING;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file config_store.h
+ * @brief This file contains the declarations for the A/B flash configuration store.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The configuration is kept as a ConfigImage in one of two flash
+ * sectors (slots A and B) at the start of the sketch's filesystem region.
+ * Every record carries a generation counter and a CRC-32. Loading reads the
+ * records in place through the XIP window and picks the newest valid one.
+ * Saving always erases and programs the other slot, so the previous record
+ * survives a power cut at any point of the save.
+ *
+ * Saves are queued and written by configStoreService() from the Core 1 loop,
+ * one flash operation per call, so the loop only stops for the erase and the
+ * program themselves. A save queued while another is waiting replaces it:
+ * only the newest image is written. Each save gets a ticket whose outcome is
+ * read with configStoreCommitStatus().
+ */
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include "storage.h"
+
+/** @brief Marks a programmed slot ("LCFG"). */
+#define CONFIG_STORE_MAGIC 0x4746434CUL
+
+/**
+ * @brief One slot record as stored in flash.
+ */
+struct ConfigStoreRecord {
+  uint32_t magic;        ///< CONFIG_STORE_MAGIC.
+  uint32_t generation;   ///< Incremented on every save; the newest valid record wins.
+  uint16_t length;       ///< sizeof(ConfigImage) when the record was written.
+  uint16_t reserved;     ///< Zero.
+  ConfigImage image;     ///< The configuration.
+  uint32_t crc;          ///< CRC-32 of all preceding bytes of the record.
+};
+
+/**
+ * @brief Outcome of a queued save.
+ */
+enum ConfigCommitStatus {
+  CONFIG_COMMIT_PENDING,   ///< Not written yet.
+  CONFIG_COMMIT_DONE,      ///< Written and verified, or superseded by a newer save that was.
+  CONFIG_COMMIT_FAILED     ///< Verification failed, or the store was erased first.
+};
+
+const ConfigImage* configStoreActive();
+uint32_t configStoreGeneration();
+uint32_t configStoreQueueSave(const ConfigImage& image);
+void configStoreQueueErase();
+void configStoreService();
+bool configStoreBusy();
+ConfigCommitStatus configStoreCommitStatus(uint32_t ticket);
+
+#endif // CONFIG_STORE_H
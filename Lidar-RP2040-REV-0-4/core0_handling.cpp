@@ -15,6 +15,11 @@
 #include "globals.h"
 #include "globals_config.h"  // NEW: Include runtime globals support
 #include "status.h"
+#include "lidar_sensor.h"
+#include "diag_governor.h"
+#include "trace.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE0
+#include "log.h"
 
 /**
  * @brief Main handler for the Core 0 loop.
@@ -25,7 +30,12 @@
  * LiDAR serial data. It also periodically reports the status of Core 0.
  */
 void loop0_handler() {
+  static Core0InitState traced_state = CORE0_STARTUP;
   processCore0StateMachine();
+  if (core0_state != traced_state) {
+    TRACE_INSTANT_EVENT(TRACE_CORE0_STATE, core0_state);
+    traced_state = core0_state;
+  }
   if (safeGetCore1Ready() && core0_state == CORE0_READY) {
     processLidarSerial();
   }
@@ -54,15 +64,15 @@ void processCore0StateMachine() {
     switch (core0_state) {
     case CORE0_STARTUP:
       if (safeMillisElapsed(core0_state_timer, current_time) >= RUNTIME_STARTUP_DELAY_MS) {
-        if (isDebugEnabled()) safeSerialPrintln("Core 0: Startup delay complete. Initializing serial at 115200 baud to configure sensor...");
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Startup delay complete. Initializing serial at 115200 baud to configure sensor...");
         core0_state = CORE0_SERIAL_INIT_LOW;
         core0_state_timer = current_time;
       }
       break;
     case CORE0_SERIAL_INIT_LOW:
       {
-        Serial1.begin(115200);
-        if (isDebugEnabled()) safeSerialPrintln("Core 0: Serial1 at 115200. Sending baud rate change command...");
+        lidarBeginAll(115200);
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintfln("Core 0: %d sensor port(s) at 115200. Sending baud rate change command...", LIDAR_SENSOR_COUNT);
         core0_state = CORE0_SET_BAUD_RATE;
         core0_state_timer = current_time;
         break;
@@ -71,8 +81,8 @@ void processCore0StateMachine() {
     case CORE0_SET_BAUD_RATE:
       {
         uint8_t setBaudCmd[] = { 0x5A, 0x08, 0x06, 0x00, 0x08, 0x07, 0x00, 0x77 };
-        Serial1.write(setBaudCmd, sizeof(setBaudCmd));
-        if (isDebugEnabled()) safeSerialPrintln("Core 0: Baud rate command sent. Sending save settings command...");
+        lidarWriteAll(setBaudCmd, sizeof(setBaudCmd));
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Baud rate command sent. Sending save settings command...");
         core0_state = CORE0_SAVE_SETTINGS;
         core0_state_timer = current_time;
         break;
@@ -82,8 +92,8 @@ void processCore0StateMachine() {
       {
         if (safeMillisElapsed(core0_state_timer, current_time) >= 100) { 
           uint8_t saveCmd[] = { 0x5A, 0x04, 0x11, 0x6F };
-          Serial1.write(saveCmd, sizeof(saveCmd));
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Save settings command sent. Waiting for sensor to apply...");
+          lidarWriteAll(saveCmd, sizeof(saveCmd));
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Save settings command sent. Waiting for sensor to apply...");
           core0_state = CORE0_BAUD_RATE_WAIT;
           core0_state_timer = current_time;
         }
@@ -93,7 +103,7 @@ void processCore0StateMachine() {
     case CORE0_BAUD_RATE_WAIT:
       {
         if (safeMillisElapsed(core0_state_timer, current_time) >= 1000) { 
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Wait complete. Re-initializing serial at 460800 baud...");
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Wait complete. Re-initializing serial at 460800 baud...");
           core0_state = CORE0_SERIAL_INIT_HIGH;
           core0_state_timer = current_time;
         }
@@ -102,15 +112,15 @@ void processCore0StateMachine() {
 
     case CORE0_SERIAL_INIT_HIGH:
       {
-        Serial1.begin(LIDAR_BAUD_RATE);
+        lidarBeginAll(LIDAR_BAUD_RATE);
         timing_info.lidar_init_start = current_time;
-        if (isDebugEnabled()) {
-          safeSerialPrintfln("Core 0: Serial1 re-initialized at %d baud", LIDAR_BAUD_RATE);
+        if (LOG_DEBUG_ENABLED()) {
+          safeSerialPrintfln("Core 0: Sensor ports re-initialized at %d baud", LIDAR_BAUD_RATE);
         }
         
-        if (isDebugEnabled()) safeSerialPrintln("Core 0: Sending LiDAR stop command...");
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Sending LiDAR stop command...");
         uint8_t stopCmd[] = { 0x5A, 0x05, 0x07, 0x00, 0x66 };
-        Serial1.write(stopCmd, sizeof(stopCmd));
+        lidarWriteAll(stopCmd, sizeof(stopCmd));
 
         core0_state = CORE0_LIDAR_STOP;
         core0_state_timer = current_time;
@@ -120,16 +130,16 @@ void processCore0StateMachine() {
     case CORE0_LIDAR_STOP:
       {
         if (safeMillisElapsed(core0_state_timer, current_time) >= RUNTIME_LIDAR_INIT_STEP_DELAY_MS) {
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Stop command delay complete, setting frequency...");
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Stop command delay complete, setting frequency...");
           #if USE_1000HZ_MODE
           uint8_t rateCmd[] = { 0x5A, 0x06, 0x03, 0xE8, 0x03, 0x4E };
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Setting 1000Hz mode");
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Setting 1000Hz mode");
           #else
           uint8_t rateCmd[] = { 0x5A, 0x06, 0x03, 0x20, 0x03, 0x86 };
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Setting 800Hz mode");
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Setting 800Hz mode");
           #endif
 
-          Serial1.write(rateCmd, sizeof(rateCmd));
+          lidarWriteAll(rateCmd, sizeof(rateCmd));
           core0_state = CORE0_LIDAR_RATE;
           core0_state_timer = current_time;
         }
@@ -139,9 +149,9 @@ void processCore0StateMachine() {
     case CORE0_LIDAR_RATE:
       {
         if (safeMillisElapsed(core0_state_timer, current_time) >= RUNTIME_LIDAR_INIT_STEP_DELAY_MS) {
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Frequency command delay complete, enabling LiDAR...");
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Frequency command delay complete, enabling LiDAR...");
           uint8_t enableCmd[] = { 0x5A, 0x05, 0x07, 0x01, 0x67 };
-          Serial1.write(enableCmd, sizeof(enableCmd));
+          lidarWriteAll(enableCmd, sizeof(enableCmd));
 
           core0_state = CORE0_LIDAR_ENABLE;
           core0_state_timer = current_time;
@@ -152,8 +162,8 @@ void processCore0StateMachine() {
     case CORE0_LIDAR_ENABLE:
       {
         if (safeMillisElapsed(core0_state_timer, current_time) >= RUNTIME_LIDAR_FINAL_DELAY_MS) {
-          if (isDebugEnabled()) safeSerialPrintln("Core 0: Enable command delay complete, clearing buffers...");
-          while (Serial1.available()) Serial1.read();
+          if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Enable command delay complete, clearing buffers...");
+          lidarFlushAll();
 
           core0_state = CORE0_LIDAR_CLEANUP;
           core0_state_timer = current_time;
@@ -166,7 +176,7 @@ void processCore0StateMachine() {
         timing_info.lidar_init_complete = current_time;
         timing_info.core0_init_complete = current_time;
 
-        if (isDebugEnabled()) {
+        if (LOG_DEBUG_ENABLED()) {
           safeSerialPrintfln("Core 0: LiDAR initialization complete in %lu ms", 
             timing_info.lidar_init_complete - timing_info.lidar_init_start);
           safeSerialPrintfln("Core 0: Total Core 0 initialization time: %lu ms",
@@ -180,7 +190,7 @@ void processCore0StateMachine() {
 
         safeSetLidarInitialized(true);
         core0_state = CORE0_READY;
-        if (isDebugEnabled()) safeSerialPrintln("Core 0: Ready for data collection");
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 0: Ready for data collection");
         break;
       }
 
@@ -197,7 +207,7 @@ void processCore0StateMachine() {
             mutex_enter_blocking(&comm_mutex);
             core_comm.last_frame_time = millis(); 
             mutex_exit(&comm_mutex);
-            if (isDebugEnabled()) {
+            if (LOG_DEBUG_ENABLED()) {
                 safeSerialPrintln("Core 0: System fully operational. Starting communication health monitor.");
             }
           }
@@ -222,15 +232,15 @@ void processCore0StateMachine() {
               uint32_t comm_timeout = safeMillisElapsed(last_frame_ms, current_time);
               if (comm_timeout > 2000) {
                 if (recovery_attempts == 0) {
-                  safeSerialPrintfln("Core 0: Communication timeout %lu ms, attempting buffer flush", comm_timeout);
+                  if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 0: Communication timeout %lu ms, attempting buffer flush", comm_timeout);
                   attemptRecovery(RECOVERY_LEVEL_BUFFER_FLUSH);
                   safeSetErrorFlag(ERROR_FLAG_COMM_TIMEOUT, true);
                 } else if (recovery_attempts == 1) {
-                  safeSerialPrintfln("Core 0: Communication timeout %lu ms, attempting soft reset", comm_timeout);
+                  if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 0: Communication timeout %lu ms, attempting soft reset", comm_timeout);
                   attemptRecovery(RECOVERY_LEVEL_SOFT_RESET);
                   safeSetErrorFlag(ERROR_FLAG_COMM_TIMEOUT, true);
                 } else if (recovery_attempts >= 2) {
-                  safeSerialPrintfln("Core 0: CRITICAL - Communication lost for %lu ms, full reinitialization", comm_timeout);
+                  if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 0: CRITICAL - Communication lost for %lu ms, full reinitialization", comm_timeout);
                   if (attemptRecovery(RECOVERY_LEVEL_FULL_REINIT)) {
                     core0_state = CORE0_STARTUP;
                     core0_state_timer = current_time;
@@ -243,9 +253,9 @@ void processCore0StateMachine() {
             }
           } else {
             // Config mode active - skip health monitoring
-            if (isDebugEnabled()) {
+            if (LOG_DEBUG_ENABLED()) {
               static uint32_t last_config_notice = 0;
-              if (safeMillisElapsed(last_config_notice, current_time) > 30000) { // Every 30 seconds
+              if (safeMillisElapsed(last_config_notice, current_time) > 30000 && diagAllow(DIAG_HEALTH)) { // Every 30 seconds
                 safeSerialPrintln("Core 0: Config mode active - health monitoring suspended");
                 last_config_notice = current_time;
               }
@@ -258,239 +268,60 @@ void processCore0StateMachine() {
 }
 
 /**
- * @brief Processes incoming serial data from the LiDAR sensor.
+ * @brief Processes incoming serial data from the LiDAR sensors.
  *
- * @details This function is responsible for reading and parsing the data stream from the LiDAR
- * sensor. It synchronizes with the data frames by looking for a specific byte
- * pattern. Once a frame is received, it validates the checksum and then extracts
- * the distance, strength, and temperature information. Valid frames are pushed
- * into a shared buffer for Core 1 to process. The function also includes
- * performance monitoring and error handling, such as detecting frame corruption
- * and timeouts.
+ * @details This function services every configured sensor round-robin. Each sensor's
+ * parser synchronizes with the data frames, validates the checksum and ranges, and
+ * pushes valid frames into that sensor's queue for Core 1 to process. Once per
+ * second the per-sensor statistics are rolled over and the adaptive frame timeout
+ * is updated from the fastest sensor's frame rate. If no frames are seen for a
+ * prolonged period, a health check is performed.
  */
 void processLidarSerial() {
-  static uint8_t sync_state = 0, frame_data[9], frame_index = 0;
-  static uint32_t frame_start_time = 0, last_frame_debug = 0;
-  static uint32_t valid_frames = 0, invalid_frames = 0;
-  static uint32_t last_raw_data_debug = 0;
   static uint32_t last_health_check = 0;
-  static uint32_t consecutive_sync_failures = 0;
+  static uint32_t frames_since_health_check = 0;
+  static uint32_t last_perf_update = 0;
 
   uint32_t current_time = millis();
 
   // Periodic health check if no frames are being processed
   if (safeMillisElapsed(last_health_check, current_time) > 10000) { // Every 10 seconds
-    if (valid_frames == 0 && invalid_frames == 0) {
-      if (isDebugEnabled()) {
+    if (frames_since_health_check == 0) {
+      if (LOG_DEBUG_ENABLED()) {
         safeSerialPrintln("Core 0: No frames processed recently, performing health check");
       }
       checkLidarSensorHealth();
     }
+    frames_since_health_check = 0;
     last_health_check = current_time;
   }
 
-  // Enhanced raw data monitoring (without resetting counters)
-  if (isDebugEnabled() && safeMillisElapsed(last_raw_data_debug, current_time) > 10000) {
-    //safeSerialPrintfln("Core 0: Serial status - Available: %d, Sync state: %d, Valid frames: %lu, Invalid: %lu", 
-     // Serial1.available(), sync_state, valid_frames, invalid_frames);
-    last_raw_data_debug = current_time;
-    // Note: Do NOT reset frame counters here - let the performance section handle it
-  }
-
-  // Look for frame sync
-  if (sync_state == 0 && Serial1.available() >= 2) {
-    uint8_t first_byte = Serial1.read();
-    if (first_byte == FRAME_SYNC_BYTE1 && Serial1.peek() == FRAME_SYNC_BYTE2) {
-      frame_data[0] = FRAME_SYNC_BYTE1;
-      frame_data[1] = Serial1.read();
-      frame_index = 2;
-      frame_start_time = micros();
-      sync_state = 1;
-      consecutive_sync_failures = 0; // Reset failure counter
-      
-      if (isDebugEnabled() && safeMillisElapsed(last_frame_debug, current_time) > 5000) {
-        //safeSerialPrintln("Core 0: Frame sync found, reading frame data");
-        last_frame_debug = current_time;
-      }
-    } else {
-      consecutive_sync_failures++;
-      
-      // Log sync issues periodically
-      if (isDebugEnabled() && consecutive_sync_failures % 100 == 0) {
-        safeSerialPrintfln("Core 0: Sync failure #%lu - Expected: 0x%02X, Got: 0x%02X", 
-          consecutive_sync_failures, FRAME_SYNC_BYTE1, first_byte);
-      }
-      
-      // If too many sync failures, perform health check
-      if (consecutive_sync_failures > 1000) {
-        safeSerialPrintln("Core 0: Too many sync failures, performing emergency health check");
-        checkLidarSensorHealth();
-        consecutive_sync_failures = 0;
-      }
-    }
-  }
-
-  // Read frame data
-  while (Serial1.available() && sync_state == 1 && frame_index < 9) {
-    frame_data[frame_index++] = Serial1.read();
-    
-    if (frame_index >= 9) {
-      sync_state = 0;
-      
-      // Calculate and verify checksum
-      uint8_t checksum = 0;
-      for (int i = 0; i < 8; i++) {
-        checksum += frame_data[i];
-      }
-      
-      if (checksum == frame_data[8]) {
-        // Checksum valid - clear error flags
-        safeSetErrorFlag(ERROR_FLAG_FRAME_CORRUPTION, false);
-        static uint32_t consecutive_good_frames = 0;
-        consecutive_good_frames++;
-        
-        // Clear communication timeout after several good frames
-        safeSetErrorFlag(ERROR_FLAG_COMM_TIMEOUT, false);
-        if (consecutive_good_frames >= 5) {
-          mutex_enter_blocking(&comm_mutex);
-          core_comm.recovery_attempts = 0;
-          mutex_exit(&comm_mutex);
-          consecutive_good_frames = 0;
-        }
-        
-        // Parse frame data
-        LidarFrame new_frame;
-        new_frame.distance = frame_data[2] | (frame_data[3] << 8);
-        new_frame.strength = frame_data[4] | (frame_data[5] << 8);
-        new_frame.temperature = frame_data[6] | (frame_data[7] << 8);
-
-        // Enhanced frame validation and debugging
-        if (isDebugEnabled() && safeMillisElapsed(last_frame_debug, current_time) > 5000) {
-          //safeSerialPrintfln("Core 0: Raw frame data - Dist: %d cm, Strength: %d, Temp: %d", 
-           // new_frame.distance, new_frame.strength, new_frame.temperature);
-          
-          // Show raw bytes for debugging
-          //safeSerialPrint("Core 0: Raw bytes: ");
-          for (int i = 0; i < 9; i++) {
-            //safeSerialPrintf("0x%02X ", frame_data[i]);
-          }
-          //safeSerialPrintln("");
-          last_frame_debug = current_time;
-        }
-
-        // Validate frame data ranges - USE RUNTIME GLOBAL for strength threshold
-        if (new_frame.distance >= MIN_DISTANCE_CM && new_frame.distance <= MAX_DISTANCE_CM &&
-            new_frame.strength >= RUNTIME_MIN_STRENGTH_THRESHOLD) {
-          
-          new_frame.timestamp = micros();
-          new_frame.valid = true;
-          valid_frames++;
-
-          // Try to add frame to buffer
-          if (!atomicBufferPush(new_frame)) {
-            // REV 2: Suppress buffer overflow messages during config mode
-            bool config_active = false;
-            mutex_enter_blocking(&comm_mutex);
-            config_active = core_comm.config_mode_active;
-            mutex_exit(&comm_mutex);
-
-            if (!config_active) {
-              static uint32_t last_overflow_report = 0;
-              if (safeMillisElapsed(last_overflow_report, current_time) > RUNTIME_CRITICAL_ERROR_REPORT_INTERVAL_MS) {
-                safeSerialPrintfln("Core 0: CRITICAL - Buffer overflow! Dropping frames (util: %d/%d)", 
-                  getBufferUtilization(), FRAME_BUFFER_SIZE);
-                last_overflow_report = current_time;
-              }
-            }
-          } else {
-            // Update communication timestamp on successful frame processing
-            mutex_enter_blocking(&comm_mutex);
-            core_comm.last_frame_time = current_time;
-            mutex_exit(&comm_mutex);
-          }
-
-        } else {
-          // Frame data out of valid range
-          invalid_frames++;
-          safeSetErrorFlag(ERROR_FLAG_FRAME_CORRUPTION, true);
-          
-          if (isDebugEnabled()) {
-            safeSerialPrintfln("Core 0: Frame validation failed - Dist: %d (range: %d-%d), Strength: %d (min: %d)", 
-              new_frame.distance, MIN_DISTANCE_CM, MAX_DISTANCE_CM, 
-              new_frame.strength, RUNTIME_MIN_STRENGTH_THRESHOLD);
-          }
-          
-          // Reset consecutive good frames counter
-          static uint32_t* consecutive_good_frames_ptr = nullptr;
-          if (consecutive_good_frames_ptr == nullptr) {
-            static uint32_t consecutive_good_frames_static = 0;
-            consecutive_good_frames_ptr = &consecutive_good_frames_static;
-          }
-          *consecutive_good_frames_ptr = 0;
-        }
-      } else {
-        // Checksum failed
-        invalid_frames++;
-        safeSetErrorFlag(ERROR_FLAG_FRAME_CORRUPTION, true);
-        
-        if (isDebugEnabled()) {
-          safeSerialPrintfln("Core 0: Checksum mismatch - Calculated: 0x%02X, Received: 0x%02X", 
-            checksum, frame_data[8]);
-          
-          // Show the problematic frame data
-          safeSerialPrint("Core 0: Bad frame data: ");
-          for (int i = 0; i < 9; i++) {
-            safeSerialPrintf("0x%02X ", frame_data[i]);
-          }
-          safeSerialPrintln("");
-        }
-        
-        // Reset consecutive good frames counter
-        static uint32_t* consecutive_good_frames_ptr = nullptr;
-        if (consecutive_good_frames_ptr == nullptr) {
-          static uint32_t consecutive_good_frames_static = 0;
-          consecutive_good_frames_ptr = &consecutive_good_frames_static;
-        }
-        *consecutive_good_frames_ptr = 0;
-      }
-    }
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) {
+    lidar_sensors[i]->poll(current_time);
   }
 
-  // Handle frame timeout
-  if (sync_state > 0 && safeMicrosElapsed(frame_start_time, micros()) > timing_info.adaptive_timeout_us) {
-    sync_state = 0;
-    static uint32_t last_timeout_report = 0;
-    
-    if (isDebugEnabled() && safeMillisElapsed(last_timeout_report, current_time) > 5000) {
-      safeSerialPrintfln("Core 0: Frame timeout after %lu microseconds (partial frame, index: %d)", 
-        timing_info.adaptive_timeout_us, frame_index);
-      last_timeout_report = current_time;
+  // Update performance metrics
+  if (safeMillisElapsed(last_perf_update, current_time) > 1000) {
+    uint32_t total_frames = 0;
+    uint32_t fastest_sensor_fps = 0;
+    for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) {
+      lidar_sensors[i]->rollStatistics();
+      uint32_t fps = lidar_sensors[i]->getStats().frames_per_second;
+      total_frames += fps;
+      if (fps > fastest_sensor_fps) fastest_sensor_fps = fps;
     }
-  }
+    frames_since_health_check += total_frames;
 
-  // Update performance metrics (FIXED VERSION)
-  static uint32_t last_perf_update = 0;
-  if (safeMillisElapsed(last_perf_update, current_time) > 1000) {
-    uint32_t total_frames = valid_frames + invalid_frames;
-    
     if (total_frames > 0) {
       timing_info.frames_per_second = total_frames;
-      updateAdaptiveTimeout(timing_info.frames_per_second);
-      
-      if (isDebugEnabled()) {
-        //safeSerialPrintfln("Core 0: Performance - %lu fps (%lu valid, %lu invalid), Timeout: %lu us", 
-         // total_frames, valid_frames, invalid_frames, timing_info.adaptive_timeout_us);
-      }
-      
-      // Reset frame counters AFTER checking and reporting
-      valid_frames = invalid_frames = 0;
+      updateAdaptiveTimeout(fastest_sensor_fps);
     } else {
       // No frames processed - potential problem
-      if (isDebugEnabled()) {
+      if (LOG_DEBUG_ENABLED() && diagAllow(DIAG_HEALTH)) {
         safeSerialPrintln("Core 0: WARNING - No frames processed in last second");
       }
     }
-    
+
     last_perf_update = current_time;
   }
 }
@@ -526,39 +357,37 @@ bool attemptRecovery(uint8_t recovery_level) {
   
   switch (recovery_level) {
     case RECOVERY_LEVEL_BUFFER_FLUSH:
-      mutex_enter_blocking(&buffer_mutex);
-      buffer_head = buffer_tail = buffer_count = 0;
-      mutex_exit(&buffer_mutex);
-      while (Serial1.available()) Serial1.read();
+      for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) flushFrameQueue(i);
+      lidarFlushAll();
       
       // Add sensor health check
       if (!checkLidarSensorHealth()) {
-        safeSerialPrintln("Core 0: WARNING - LiDAR sensor not responding to health check");
+        if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 0: WARNING - LiDAR sensor not responding to health check");
       }
       
-      safeSerialPrintfln("Core 0: Recovery Level 1 - Buffer flush completed (attempt %lu)", current_attempts);
+      if (LOG_INFO_ENABLED()) safeSerialPrintfln("Core 0: Recovery Level 1 - Buffer flush completed (attempt %lu)", current_attempts);
       break;
       
     case RECOVERY_LEVEL_SOFT_RESET:
-      Serial1.end();
+      lidarEndAll();
       delay(500); // Longer delay
-      Serial1.begin(LIDAR_BAUD_RATE);
+      lidarBeginAll(LIDAR_BAUD_RATE);
       delay(200);
       
       if (!checkLidarSensorHealth()) {
-        safeSerialPrintln("Core 0: ERROR - LiDAR sensor still not responding after soft reset");
+        if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 0: ERROR - LiDAR sensor still not responding after soft reset");
       }
       
-      safeSerialPrintfln("Core 0: Recovery Level 2 - Soft reset completed (attempt %lu)", current_attempts);
+      if (LOG_INFO_ENABLED()) safeSerialPrintfln("Core 0: Recovery Level 2 - Soft reset completed (attempt %lu)", current_attempts);
       break;
       
     case RECOVERY_LEVEL_FULL_REINIT:
-      safeSerialPrintfln("Core 0: Recovery Level 3 - Full reinitialization triggered (attempt %lu)", current_attempts);
+      if (LOG_INFO_ENABLED()) safeSerialPrintfln("Core 0: Recovery Level 3 - Full reinitialization triggered (attempt %lu)", current_attempts);
       
       // Reset recovery counter to prevent infinite reinit loops
       mutex_enter_blocking(&comm_mutex);
       if (core_comm.recovery_attempts > RUNTIME_MAX_RECOVERY_ATTEMPTS) {
-        safeSerialPrintln("Core 0: CRITICAL - Too many recovery attempts, system may be unstable");
+        if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 0: CRITICAL - Too many recovery attempts, system may be unstable");
         core_comm.recovery_attempts = 0; // Reset to prevent continuous reinit
         mutex_exit(&comm_mutex);
         return false; // Don't trigger reinit
@@ -594,21 +423,21 @@ bool attemptRecovery(uint8_t recovery_level) {
  *         false otherwise.
  */
 bool checkLidarSensorHealth() {
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintln("Core 0: Checking sensor health by monitoring data stream...");
   }
   
   // Instead of sending commands, just check if we're receiving data
-  int available = Serial1.available();
+  int available = lidarAvailableAll();
   
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintfln("Core 0: LiDAR health check - %d bytes in buffer", available);
   }
   
   // Sensor is healthy if there's data in the buffer or we've received frames recently
   bool sensor_healthy = available > 0;
   
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintfln("Core 0: LiDAR health check result: %s", 
       sensor_healthy ? "HEALTHY (streaming data)" : "NO DATA");
   }
@@ -16,12 +16,23 @@
 #include "globals_config.h"  // NEW: Include runtime globals support
 #include "init.h"
 #include "storage.h"
+#include "config_store.h"
 #include "gui.h"
 #include "status.h"
 #include "switch.h"
 #include "trigger.h"
 #include "calculations.h"
 #include "neopixel_integration.h"
+#include "sensor_fusion.h"
+#include "load_scheduler.h"
+#include "binlog.h"
+#include "diag_governor.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "recorder.h"
+#include "snapshot.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
 
 /**
  * @brief Main handler for the Core 1 loop.
@@ -33,43 +44,41 @@
  * status of Core 1.
  */
 void loop1_handler() {
+  static Core1InitState traced_core1_state = CORE1_STARTUP;
+  static SystemState traced_system_state = STATE_INIT;
   processCore1StateMachine();
+  if (core1_state != traced_core1_state) {
+    TRACE_INSTANT_EVENT(TRACE_CORE1_STATE, core1_state);
+    traced_core1_state = core1_state;
+  }
+  if (current_state != traced_system_state) {
+    TRACE_INSTANT_EVENT(TRACE_SYSTEM_STATE, current_state);
+    traced_system_state = current_state;
+  }
   handleStatusLED();
 
   if (core1_state != (Core1InitState)999) {  // Not in terminal state
-    updateNeoPixelStatus(NEO_INITIALIZING);
-  }
-
-  // Continuous error monitoring for red flash (only when system is ready)
-  if (core1_state == (Core1InitState)999) {  // In terminal state (ready)
-    static uint32_t last_error_check = 0;
-    if (safeMillisElapsed(last_error_check, millis()) >= 50) {  // Check every 50ms
-      uint32_t error_flags = 0;
-      mutex_enter_blocking(&comm_mutex);
-      error_flags = core_comm.error_flags;
-      mutex_exit(&comm_mutex);
-
-      if (error_flags != 0) {
-        updateNeoPixelStatus(NEO_ERROR);  // Force error display
-      }
-      last_error_check = millis();
-    }
+    setNeoPixelTarget(NEO_INITIALIZING);
   }
 
   if (current_state == STATE_CONFIG) {
     // CONFIG MODE: Only GUI commands and buffer drain
     processGuiCommands();
-    updateNeoPixelStatus(NEO_CONFIG);
+    setNeoPixelTarget(NEO_CONFIG);
 
     // REV 2: Simple buffer drain to prevent overflow - no processing
     LidarFrame discard_frame;
-    while (atomicBufferPop(discard_frame)) {
-      // Just discard frames to prevent buffer overflow
-      // No velocity calculation, no trigger logic, no data processing
+    for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) {
+      while (atomicBufferPop(i, discard_frame)) {
+        // Just discard frames to prevent buffer overflow
+        // No velocity calculation, no trigger logic, no data processing
+      }
     }
 
   } else if (current_state == STATE_RUNNING) {
-    // RUNNING MODE: Full processing
+    // RUNNING MODE: Full processing; the GUI may read status and subscribe to telemetry
+    processGuiCommands();
+
     static uint32_t last_switch_read = 0;
     if (safeMillisElapsed(last_switch_read, millis()) >= 10) {
       mutex_enter_blocking(&comm_mutex);
@@ -79,18 +88,28 @@ void loop1_handler() {
     }
 
     processIncomingFrames();
+    telemetryFlush();
 
-    if (isDebugEnabled()) {
+    if (LOG_DEBUG_ENABLED()) {
       handleDebugOutput();
     }
   }
 
+  // Background flash work: each service does at most one erase or program per pass
+  configStoreService();
+  recorderService();
+  snapshotService();
+
   static uint32_t last_status_report = 0;
   if (safeMillisElapsed(last_status_report, millis()) >= RUNTIME_STATUS_CHECK_INTERVAL_MS) {
     reportCore1Status();
     last_status_report = millis();
   }
 
+  // Format deferred log records while there is nothing else to do
+  binlogDrain();
+  diagReportSuppressed();
+
   yield();
 }
 
@@ -108,7 +127,7 @@ void processCore1StateMachine() {
   switch (core1_state) {
     case CORE1_STARTUP:
       if (safeMillisElapsed(core1_state_timer, current_time) >= 500) {
-        if (isDebugEnabled()) safeSerialPrintln("Core 1: Startup delay complete, initializing pins...");
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Startup delay complete, initializing pins...");
         core1_state = CORE1_PINS_INIT;
         core1_state_timer = current_time;
       }
@@ -116,14 +135,16 @@ void processCore1StateMachine() {
 
     case CORE1_PINS_INIT:
       initializePinsCore1();  // This includes NeoPixel initialization with blue breathing
-      if (isDebugEnabled()) safeSerialPrintln("Core 1: Pin initialization complete, loading configuration...");
+      if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Pin initialization complete, loading configuration...");
       core1_state = CORE1_CONFIG_LOAD;
       core1_state_timer = current_time;
       break;
 
     case CORE1_CONFIG_LOAD:
       loadConfiguration();
-      if (isDebugEnabled()) safeSerialPrintln("Core 1: Configuration loaded, checking for config mode...");
+      recorderInit();
+      snapshotInit();
+      if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Configuration loaded, checking for config mode...");
       core1_state = CORE1_CONFIG_MODE_CHECK;
       core1_state_timer = current_time;
       break;
@@ -137,8 +158,8 @@ void processCore1StateMachine() {
         core_comm.config_mode_active = true;
         mutex_exit(&comm_mutex);
 
-        updateNeoPixelStatus(NEO_CONFIG);
-        if (isDebugEnabled()) {
+        setNeoPixelTarget(NEO_CONFIG);
+        if (LOG_DEBUG_ENABLED()) {
           safeSerialPrintln("Core 1: Configuration mode triggered by serial input");
           safeSerialPrintln("Core 1: WARNING - Config mode active. Reset required to exit.");
         }
@@ -146,7 +167,7 @@ void processCore1StateMachine() {
         break;
       }
       if (safeMillisElapsed(core1_state_timer, current_time) >= RUNTIME_CONFIG_MODE_TIMEOUT_MS) {
-        if (isDebugEnabled()) safeSerialPrintln("Core 1: Config mode timeout - entering normal operation");
+        if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Config mode timeout - entering normal operation");
         current_state = STATE_RUNNING;
 
         // REV 2: Ensure config mode flag is clear for normal operation
@@ -162,8 +183,8 @@ void processCore1StateMachine() {
       // Set appropriate NeoPixel display based on system state
       if (current_state == STATE_RUNNING) {
         // Clear initialization display, ready for distance-based colors
-        updateNeoPixelStatus(NEO_DISTANCE, 1000, 0, 255);  // Default distant reading
-        if (isDebugEnabled()) {
+        setNeoPixelTarget(NEO_DISTANCE, 1000, 0, 255);  // Default distant reading
+        if (LOG_DEBUG_ENABLED()) {
           safeSerialPrintln("====================================");
           safeSerialPrintln("ENTERING NORMAL OPERATION MODE");
           safeSerialPrintln("LiDAR processing active");
@@ -172,7 +193,7 @@ void processCore1StateMachine() {
           safeSerialPrintln("====================================");
         }
       } else if (current_state == STATE_CONFIG) {
-        if (isDebugEnabled()) {
+        if (LOG_DEBUG_ENABLED()) {
           safeSerialPrintln("====================================");
           safeSerialPrintln("ENTERING CONFIGURATION MODE");
           safeSerialPrintln("Ready for GUI commands on Serial");
@@ -184,92 +205,382 @@ void processCore1StateMachine() {
       }
 
       timing_info.core1_init_complete = current_time;
-      if (isDebugEnabled()) {
+      if (LOG_DEBUG_ENABLED()) {
         safeSerialPrintfln("Core 1: Total initialization time: %lu ms",
                            timing_info.core1_init_complete - timing_info.core1_init_start);
       }
       safeSetCore1Ready(true);
-      if (isDebugEnabled()) safeSerialPrintln("Core 1: Initialization complete - READY");
+      if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Initialization complete - READY");
       core1_state = (Core1InitState)999;  // Terminal state
       break;
   }
 }
 
 /**
- * @brief Processes incoming LiDAR frames from Core 0.
+ * @brief The latest result of one trigger pipeline, used to drive the output and display.
+ */
+struct PipelineOutput {
+  bool trigger_state;   ///< Latched trigger state after the last sample.
+  bool has_sample;      ///< True once a sample has been processed.
+  uint16_t distance;    ///< Distance of the last sample.
+  uint16_t strength;    ///< Strength of the last sample.
+  float velocity;       ///< Velocity after the last sample.
+};
+
+/**
+ * @brief Per-sensor processing state for the Core 1 pipeline.
  *
- * @details This function is the core of the data processing pipeline on Core 1. It pops
- * LiDAR frames from the shared atomic buffer, where they are placed by Core 0.
- * For each frame, it calculates the velocity, checks against the configured
- * trigger conditions (distance and velocity), and manages the trigger output.
- * It also updates the NeoPixel status based on the current distance and
- * velocity, and handles debug output if enabled.
+ * @details Every sensor gets its own velocity estimator, debouncer and latch so that
+ * frames from different sensors never mix in a velocity history or trigger decision.
  */
-void processIncomingFrames() {
-  static uint32_t frames_processed_count = 0;
-  static AdaptiveVelocityCalculator velocity_calc;
-  static bool last_trigger_state = false;
+struct SensorPipeline {
+  AdaptiveVelocityCalculator velocity_calc;  ///< Velocity estimator fed by this sensor only.
+  TriggerDebouncer debouncer;                ///< Debouncer for this sensor's raw trigger.
+  TriggerLatch latch;                        ///< Latch for this sensor's debounced trigger.
+  bool last_raw_trigger = false;             ///< Raw trigger condition of the last processed frame.
+  PipelineOutput output;                     ///< Latest result of this sensor's pipeline.
+};
+
+static SensorPipeline sensor_pipelines[LIDAR_SENSOR_COUNT];
+static LoadScheduler load_scheduler;
+
+/**
+ * @brief Evaluates the configured distance and velocity conditions for one sample.
+ * @param distance The distance in centimeters.
+ * @param velocity The velocity in cm/s.
+ * @param switch_code The current switch position.
+ * @return True if the raw (undebounced) trigger condition is met.
+ */
+static bool evaluateRawTrigger(uint16_t distance, float velocity, uint8_t switch_code) {
+  bool distance_ok = (distance <= currentConfig.distance_thresholds[switch_code]);
+  bool velocity_ok = !currentConfig.use_velocity_trigger || (velocity >= currentConfig.velocity_min_thresholds[switch_code] && velocity <= currentConfig.velocity_max_thresholds[switch_code]);
+  return distance_ok && velocity_ok;
+}
+
+/**
+ * @brief Reads the current switch code in a thread-safe manner.
+ * @return The switch code.
+ */
+static uint8_t getSwitchCode() {
+  mutex_enter_blocking(&comm_mutex);
+  uint8_t switch_code = core_comm.switch_code;
+  mutex_exit(&comm_mutex);
+  return switch_code;
+}
+
+/**
+ * @brief Offers one processed sample and its trigger stages to the snapshot ring.
+ */
+static inline void snapshotSample(uint32_t timestamp, uint16_t distance, uint16_t strength, float velocity,
+                                  uint8_t source, uint8_t switch_code, bool raw, bool debounced, bool latched) {
+  SnapshotSample sample;
+  sample.timestamp = timestamp;
+  sample.distance = distance;
+  sample.strength = strength;
+  sample.velocity = velocity;
+  sample.source = source;
+  sample.flags = (raw ? SNAPSHOT_FLAG_RAW_TRIGGER : 0) | (debounced ? SNAPSHOT_FLAG_DEBOUNCED : 0) |
+                 (latched ? SNAPSHOT_FLAG_LATCHED : 0);
+  sample.switch_code = switch_code;
+  sample.reserved = 0;
+  snapshotRecord(sample);
+}
+
+/**
+ * @brief Marks the last offered sample as a snapshot trigger point.
+ * @param source The pipeline that fired.
+ * @param switch_code The current switch position.
+ * @param fusion_mode The fusion mode, or SNAPSHOT_NO_FUSION.
+ * @param first The source's velocity estimator.
+ * @param second The second estimator of the fused pipeline, or nullptr.
+ */
+static inline void snapshotFire(uint8_t source, uint8_t switch_code, uint8_t fusion_mode,
+                                const AdaptiveVelocityCalculator& first, const AdaptiveVelocityCalculator* second) {
+  SnapshotTriggerInfo info;
+  memset(&info, 0, sizeof(info));
+  info.source = source;
+  info.switch_code = switch_code;
+  info.load_mode = (uint8_t)load_scheduler.getMode();
+  info.fusion_mode = fusion_mode;
+  first.getState(info.estimators[0]);
+  if (second != nullptr) second->getState(info.estimators[1]);
+  snapshotTrigger(info);
+}
+
+#if ENABLE_DUAL_SENSOR_VOTING
+/** @brief Sensors 0 and 1 are voted; independent pipelines start after them. */
+#define FIRST_INDEPENDENT_SENSOR 2
+
+static DualSensorFusion sensor_fusion;
+static TriggerDebouncer fused_debouncer;
+static TriggerLatch fused_latch;
+static PipelineOutput fused_output;
+
+/**
+ * @brief Runs sensors 0 and 1 through the voting stage and the fused trigger pipeline.
+ *
+ * @details Frames are popped from both queues as the fusion stage has room for them.
+ * Each frame still updates its own sensor's velocity history, so the per-sensor
+ * velocities handed to the fusion stage are never mixed. A sensor whose slot is
+ * full but whose queue is not is reported as still delivering. In dual mode the raw
+ * trigger additionally requires both sensors to agree on the distance.
+ *
+ * @param max_frames The maximum number of frames to pop from the two queues.
+ * @param switch_code The switch position, read once for the whole batch.
+ * @param queue_depth The fullest queue's fill level, reported with telemetry records.
+ * @return The number of frames popped.
+ */
+static uint32_t processFusedFrames(uint32_t max_frames, uint8_t switch_code, uint8_t queue_depth) {
+  uint32_t frames = 0;
   LidarFrame frame;
+  FusedSample sample;
+
+  while (frames < max_frames) {
+    bool popped = false;
+    uint32_t now_ms = millis();
+    for (uint8_t slot = 0; slot < 2; slot++) {
+      if (!sensor_fusion.needsFrame(slot)) {
+        // Still delivering even though its pending frame waits for a partner
+        if (getBufferUtilization(slot) > 0) sensor_fusion.noteQueued(slot, now_ms);
+      } else if (atomicBufferPop(slot, frame)) {
+        recorderRecord(frame);
+        SensorPipeline& pipeline = sensor_pipelines[slot];
+        pipeline.velocity_calc.addFrame(frame);
+        sensor_fusion.offer(slot, frame, pipeline.velocity_calc.calculateVelocity());
+        frames++;
+        popped = true;
+      }
+    }
 
-  // REV 2: Only process frames in RUNNING mode for performance
-  // Process multiple frames per call to prevent buffer buildup
-  int frames_this_cycle = 0;
-  const int MAX_FRAMES_PER_CYCLE = 5;  // Prevent excessive processing time
+    bool produced = sensor_fusion.fuse(now_ms, sample);
+    if (produced) {
+      bool raw_trigger = evaluateRawTrigger(sample.distance, sample.velocity, switch_code);
+      if (sensor_fusion.getMode() == FUSION_DUAL) raw_trigger = raw_trigger && sample.agreed;
+
+      bool debounced_trigger = fused_debouncer.update(raw_trigger);
+      bool fused_trigger = fused_latch.update(debounced_trigger);
+      snapshotSample(sample.timestamp, sample.distance, sample.strength, sample.velocity, SNAPSHOT_SOURCE_FUSED,
+                     switch_code, raw_trigger, debounced_trigger, fused_trigger);
+      if (fused_trigger && !fused_output.trigger_state) {
+        snapshotFire(SNAPSHOT_SOURCE_FUSED, switch_code, (uint8_t)sensor_fusion.getMode(),
+                     sensor_pipelines[0].velocity_calc, &sensor_pipelines[1].velocity_calc);
+        if (LOG_DEBUG_ENABLED() && diagAllow(DIAG_TRIGGER)) {
+          binlog(BLOG_TRIGGER_FUSED, sample.sources, sample.distance, sample.velocity, switch_code);
+        }
+      }
 
-  while (atomicBufferPop(frame) && frames_this_cycle < MAX_FRAMES_PER_CYCLE) {
-    frames_processed_count++;
-    frames_this_cycle++;
+      fused_output.trigger_state = fused_trigger;
+      fused_output.has_sample = true;
+      fused_output.distance = sample.distance;
+      fused_output.strength = sample.strength;
+      fused_output.velocity = sample.velocity;
+      if (load_scheduler.shedDisplay()) {
+        telemetrySkip();
+      } else {
+        telemetryRecord(sample.timestamp, sample.distance, sample.strength, sample.velocity,
+                        fused_trigger, TELEMETRY_SOURCE_FUSED, queue_depth);
+      }
+    }
 
-    velocity_calc.addFrame(frame);
-    float calculated_velocity = velocity_calc.calculateVelocity();
+    if (!popped && !produced) break;
+  }
+  return frames;
+}
+#else
+#define FIRST_INDEPENDENT_SENSOR 0
+#endif
 
-    uint8_t switch_code;
-    mutex_enter_blocking(&comm_mutex);
-    switch_code = core_comm.switch_code;
-    mutex_exit(&comm_mutex);
+/**
+ * @brief Folds one pipeline result into the combined trigger output and display choice.
+ * @param output The pipeline result.
+ * @param final_trigger Set if the pipeline's latch is active.
+ * @param shown Updated to point at the nearest result with a sample.
+ */
+static void combineOutput(const PipelineOutput& output, bool& final_trigger, const PipelineOutput*& shown) {
+  final_trigger = final_trigger || output.trigger_state;
+  if (output.has_sample && (shown == nullptr || output.distance < shown->distance)) {
+    shown = &output;
+  }
+}
 
-    bool distance_ok = (frame.distance <= currentConfig.distance_thresholds[switch_code]);
-    bool velocity_ok = !currentConfig.use_velocity_trigger || (calculated_velocity >= currentConfig.velocity_min_thresholds[switch_code] && calculated_velocity <= currentConfig.velocity_max_thresholds[switch_code]);
+/**
+ * @brief Processes incoming LiDAR frames from Core 0.
+ *
+ * @details This function is the core of the data processing pipeline on Core 1. For
+ * each sensor it pops frames from that sensor's queue, calculates the velocity,
+ * checks against the configured trigger conditions (distance and velocity), and
+ * runs the sensor's own debouncer and latch. With dual-sensor voting enabled,
+ * sensors 0 and 1 are instead fused and share one trigger pipeline. The trigger
+ * output is active while any pipeline's latch is active. Telemetry and the
+ * NeoPixel display follow the pipeline with the nearest reading. Every processed
+ * sample is also offered to the GUI telemetry stream, and every popped frame,
+ * decimated or not, to the flash frame recorder. Processed samples also feed the
+ * trigger snapshot ring, and each latch's rising edge marks a snapshot trigger.
+ *
+ * The batch size per sensor and the load mode come from the load scheduler. Under
+ * sustained backpressure the NeoPixel and telemetry updates are skipped first,
+ * then frames that cannot change an idle trigger are decimated. The trigger
+ * output itself is always updated.
+ */
+void processIncomingFrames() {
+  static uint32_t frames_processed_count = 0;
+  static bool last_output_state = false;
+  static LidarFrame frame_batch[LOAD_MAX_BATCH];
 
-    bool raw_trigger = distance_ok && velocity_ok;
-    bool debounced_trigger = trigger_debouncer.update(raw_trigger);
-    bool final_trigger = trigger_latch.update(debounced_trigger);
+  // REV 2: Only process frames in RUNNING mode for performance
+  // Process a batch per call sized by the queue depth to prevent buffer buildup
+  const uint8_t queue_depth = getMaxBufferUtilization();
+  const uint8_t frames_per_cycle = load_scheduler.update(queue_depth);
+  uint32_t start_cycles = rp2040.getCycleCount();
+  uint32_t frames_this_call = 0;
+
+  // Shared state is read once per batch; the per-frame loop below is pure computation
+  const uint8_t switch_code = getSwitchCode();
+
+#if ENABLE_DUAL_SENSOR_VOTING
+  frames_this_call += processFusedFrames(2 * frames_per_cycle, switch_code, queue_depth);
+#endif
+
+  for (uint8_t sensor = FIRST_INDEPENDENT_SENSOR; sensor < LIDAR_SENSOR_COUNT; sensor++) {
+    SensorPipeline& pipeline = sensor_pipelines[sensor];
+    TRACE_BEGIN_EVENT(TRACE_QUEUE_POP, sensor);
+    uint8_t batch_count = atomicBufferPopBatch(sensor, frame_batch, frames_per_cycle);
+    TRACE_END_EVENT(TRACE_QUEUE_POP, sensor);
+    frames_this_call += batch_count;
+
+    for (uint8_t i = 0; i < batch_count; i++) {
+      const LidarFrame& frame = frame_batch[i];
+      recorderRecord(frame);
+      bool trigger_idle = !pipeline.last_raw_trigger && !pipeline.output.trigger_state;
+      if (load_scheduler.shouldDecimate(frame.distance, currentConfig.distance_thresholds[switch_code],
+                                        pipeline.output.velocity, trigger_idle)) {
+        continue;
+      }
 
-    digitalWrite(TRIG_PULSE_LOW_PIN, final_trigger ? LOW : HIGH);
+      TRACE_BEGIN_EVENT(TRACE_VELOCITY, sensor);
+      pipeline.velocity_calc.addFrame(frame);
+      float calculated_velocity = pipeline.velocity_calc.calculateVelocity();
+      TRACE_END_EVENT(TRACE_VELOCITY, sensor);
+
+      bool raw_trigger = evaluateRawTrigger(frame.distance, calculated_velocity, switch_code);
+      pipeline.last_raw_trigger = raw_trigger;
+      bool debounced_trigger = pipeline.debouncer.update(raw_trigger);
+      bool sensor_trigger = pipeline.latch.update(debounced_trigger);
+      snapshotSample(frame.timestamp, frame.distance, frame.strength, calculated_velocity, sensor,
+                     switch_code, raw_trigger, debounced_trigger, sensor_trigger);
+
+      if (sensor_trigger && !pipeline.output.trigger_state) {
+        snapshotFire(sensor, switch_code, SNAPSHOT_NO_FUSION, pipeline.velocity_calc, nullptr);
+        if (LOG_DEBUG_ENABLED() && diagAllow(DIAG_TRIGGER)) {
+          binlog(BLOG_TRIGGER, sensor, frame.distance, calculated_velocity, switch_code);
+        }
+      }
 
-    // REV 2: Trigger flash on rising edge (trigger activation)
-    if (final_trigger && !last_trigger_state) {
-      triggerNeoPixelFlash();  // Start flash sequence tied to trigger latch
-      if (isDebugEnabled()) {
-        safeSerialPrintfln("Core 1: TRIGGER! Distance=%dcm, Velocity=%.1fcm/s, Switch=%d",
-                           frame.distance, calculated_velocity, switch_code);
+      pipeline.output.trigger_state = sensor_trigger;
+      pipeline.output.has_sample = true;
+      pipeline.output.distance = frame.distance;
+      pipeline.output.strength = frame.strength;
+      pipeline.output.velocity = calculated_velocity;
+      if (load_scheduler.shedDisplay()) {
+        telemetrySkip();
+      } else {
+        telemetryRecord(frame.timestamp, frame.distance, frame.strength, calculated_velocity,
+                        sensor_trigger, sensor, queue_depth);
       }
     }
-    last_trigger_state = final_trigger;
+  }
 
-    mutex_enter_blocking(&comm_mutex);
-    core_comm.trigger_output = final_trigger;
-    core_comm.velocity = calculated_velocity;
-    core_comm.distance = frame.distance;
-    core_comm.strength = frame.strength;
-    mutex_exit(&comm_mutex);
+  // Combine the pipeline latches and pick the nearest reading for display
+  bool final_trigger = false;
+  const PipelineOutput* shown = nullptr;
+#if ENABLE_DUAL_SENSOR_VOTING
+  combineOutput(fused_output, final_trigger, shown);
+#endif
+  for (uint8_t sensor = FIRST_INDEPENDENT_SENSOR; sensor < LIDAR_SENSOR_COUNT; sensor++) {
+    combineOutput(sensor_pipelines[sensor].output, final_trigger, shown);
+  }
+
+  digitalWrite(TRIG_PULSE_LOW_PIN, final_trigger ? LOW : HIGH);
 
-    // REV 2: Update NeoPixel with current data (only in normal operation)
+  if (final_trigger != last_output_state) {
+    TRACE_INSTANT_EVENT(TRACE_TRIGGER, final_trigger);
+  }
+
+  // REV 2: Trigger flash on rising edge (trigger activation)
+  if (final_trigger && !last_output_state) {
+    triggerNeoPixelFlash();  // Start flash sequence tied to trigger latch
+  }
+  last_output_state = final_trigger;
+
+  // The trigger state is always published; under load the display fields and the NeoPixel are shed first
+  bool update_display = (shown != nullptr && !load_scheduler.shedDisplay());
+  mutex_enter_blocking(&comm_mutex);
+  core_comm.trigger_output = final_trigger;
+  if (update_display) {
+    core_comm.velocity = shown->velocity;
+    core_comm.distance = shown->distance;
+    core_comm.strength = shown->strength;
+  }
+  mutex_exit(&comm_mutex);
+
+  if (update_display) {
+    // REV 2: Publish current data for the NeoPixel (only in normal operation)
     // Trigger flash takes priority and will override this temporarily
     if (current_state == STATE_RUNNING) {
       // Convert LiDAR strength (0-4096) to brightness (0-255)
-      uint8_t brightness = (frame.strength > 4096) ? 255 : (frame.strength * 255) / 4096;
-      updateNeoPixelStatus(NEO_DISTANCE, frame.distance, calculated_velocity, brightness);
+      uint8_t brightness = (shown->strength > 4096) ? 255 : (shown->strength * 255) / 4096;
+      setNeoPixelTarget(NEO_DISTANCE, shown->distance, shown->velocity, brightness);
     }
   }
 
+  // Per-frame cost of the whole call, including the pops and the publication above
+  static uint32_t batch_cycles_total = 0;
+  static uint32_t batch_cycles_per_frame_max = 0;
+  if (frames_this_call > 0) {
+    uint32_t cycles = rp2040.getCycleCount() - start_cycles;
+    uint32_t cycles_per_frame = cycles / frames_this_call;
+    frames_processed_count += frames_this_call;
+    batch_cycles_total += cycles;
+    if (cycles_per_frame > batch_cycles_per_frame_max) batch_cycles_per_frame_max = cycles_per_frame;
+  }
+
   static uint32_t last_processing_report = 0;
-  if (isDebugEnabled() && safeMillisElapsed(last_processing_report, millis()) >= RUNTIME_PERFORMANCE_REPORT_INTERVAL_MS) {
+  if (LOG_DEBUG_ENABLED() && safeMillisElapsed(last_processing_report, millis()) >= RUNTIME_PERFORMANCE_REPORT_INTERVAL_MS) {
     if (frames_processed_count > 0) {
-      safeSerialPrintfln("Core 1: Processed %lu frames in last %d ms",
-                         frames_processed_count, RUNTIME_PERFORMANCE_REPORT_INTERVAL_MS);
+      safeSerialPrintfln("Core 1: Processed %lu frames from %d sensor(s) in last %d ms",
+                         frames_processed_count, LIDAR_SENSOR_COUNT, RUNTIME_PERFORMANCE_REPORT_INTERVAL_MS);
+      safeSerialPrintfln("Core 1: Pipeline cost %lu cycles/frame avg, %lu worst batch",
+                         batch_cycles_total / frames_processed_count, batch_cycles_per_frame_max);
     }
+#if ENABLE_DUAL_SENSOR_VOTING
+    const FusionStats& fstats = sensor_fusion.getStats();
+    safeSerialPrintfln("Core 1: Fusion - %lu pairs, %lu agree, %lu disagree, %lu unmatched, %lu single, %lu cycles/pair avg, %lu max",
+                       fstats.pairs, fstats.agreements, fstats.disagreements, fstats.unmatched, fstats.single_samples,
+                       (fstats.pairs + fstats.single_samples) ? fstats.cycles_total / (fstats.pairs + fstats.single_samples) : 0,
+                       fstats.cycles_max);
+#endif
+    const LoadStats& lstats = load_scheduler.getStats();
+    safeSerialPrintfln("Core 1: Load - normal %lu ms, shed %lu ms, decimate %lu ms, %lu mode changes, %lu decimated, max batch %lu",
+                       lstats.mode_time_us[LOAD_NORMAL] / 1000, lstats.mode_time_us[LOAD_SHED] / 1000,
+                       lstats.mode_time_us[LOAD_DECIMATE] / 1000, lstats.mode_changes,
+                       lstats.decimated_frames, lstats.max_batch);
+    load_scheduler.resetStats();
+    const NeoPixelShowStats& nstats = neopixel.getShowStats();
+    safeSerialPrintfln("Core 1: LED - %lu shows, %lu redundant updates skipped, %lu cycles/refresh avg, %lu max",
+                       nstats.shows, nstats.redundant,
+                       nstats.renders ? nstats.render_cycles_total / nstats.renders : 0, nstats.render_cycles_max);
+    neopixel.resetShowStats();
+#if ENABLE_FRAME_RECORDER
+    const RecorderStats& rstats = recorderGetStats();
+    uint32_t bytes_per_frame_x100 = rstats.frames_recorded ? (uint32_t)((uint64_t)rstats.encoded_bytes * 100 / rstats.frames_recorded) : 0;
+    safeSerialPrintfln("Core 1: Recorder - %lu frames, %lu.%02lu bytes/frame, %lu dropped, %lu missed, %lu sectors written, %lu erased%s",
+                       rstats.frames_recorded, bytes_per_frame_x100 / 100, bytes_per_frame_x100 % 100,
+                       rstats.frames_dropped, rstats.frames_missed, rstats.sectors_written, rstats.sectors_erased,
+                       recorderLogFull() ? ", log full" : "");
+#endif
     frames_processed_count = 0;
+    batch_cycles_total = 0;
+    batch_cycles_per_frame_max = 0;
     last_processing_report = millis();
   }
 }
@@ -280,16 +591,16 @@ void processIncomingFrames() {
  * @details This function is called from Core 1's setup1() function. It is responsible for
  * initializing the functionalities that will be handled by Core 1. It records
  * the start time for Core 1 initialization and kicks off the Core 1 state
- * machine. Now includes global configuration loading.
+ * machine. Runtime globals start at their defaults until the config store is read.
  */
 void setup1_handler() {
   timing_info.core1_init_start = millis();
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintfln("Core 1: Initializing at %lu ms", timing_info.core1_init_start);
   }
   
-  // NEW: Load global configuration early in Core 1 initialization
-  loadGlobalConfiguration();
+  // Defaults until CORE1_CONFIG_LOAD reads the config store, so Core 0's start-up sequence never sees zeros
+  loadDefaultGlobals();
   
   core1_state_timer = millis();
   core1_state = CORE1_STARTUP;
@@ -0,0 +1,76 @@
+/**
+ * @file crc.cpp
+ * @brief This file contains the implementation of the CRC helpers.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the reflected CRC-32 and the MSB-first CRC-16 one nibble
+ * at a time.
+ */
+
+#include "crc.h"
+
+/** @brief CRC-32 remainders of the 16 nibble values (reflected polynomial 0xEDB88320). */
+static const uint32_t crc32_nibble_table[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/** @brief CRC-16 remainders of the 16 nibble values (polynomial 0x1021). */
+static const uint16_t crc16_nibble_table[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/**
+ * @brief Continues a CRC-32 over more data.
+ * @param crc The value returned for the preceding data, or 0 to start.
+ * @param data A pointer to the data.
+ * @param length The length of the data.
+ * @return The CRC-32 of all data so far.
+ */
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+  crc = ~crc;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0F];
+    crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Calculates the CRC-32 of a block of data.
+ * @param data A pointer to the data.
+ * @param length The length of the data.
+ * @return The CRC-32.
+ */
+uint32_t crc32(const uint8_t* data, size_t length) {
+  return crc32Update(0, data, length);
+}
+
+/**
+ * @brief Continues a CRC-16/CCITT-FALSE over more data.
+ * @param crc The value returned for the preceding data, or 0xFFFF to start.
+ * @param data A pointer to the data.
+ * @param length The length of the data.
+ * @return The CRC-16 of all data so far.
+ */
+uint16_t crc16Update(uint16_t crc, const uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    crc = (crc << 4) ^ crc16_nibble_table[(crc >> 12) ^ (data[i] >> 4)];
+    crc = (crc << 4) ^ crc16_nibble_table[(crc >> 12) ^ (data[i] & 0x0F)];
+  }
+  return crc;
+}
+
+/**
+ * @brief Calculates the CRC-16/CCITT-FALSE of a block of data.
+ * @param data A pointer to the data.
+ * @param length The length of the data.
+ * @return The CRC-16.
+ */
+uint16_t crc16(const uint8_t* data, size_t length) {
+  return crc16Update(0xFFFF, data, length);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file crc.h
+ * @brief This file contains the declarations for the CRC helpers.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details CRC-32 (IEEE 802.3, the same as zlib.crc32 on the host) for bulk
+ * transfers and CRC-16/CCITT-FALSE (the same as binascii.crc_hqx(data, 0xFFFF))
+ * for GUI protocol v2 frames. Both use 16-entry tables, trading a little speed
+ * for a few dozen bytes of flash instead of a full 256-entry table.
+ */
+#ifndef CRC_H
+#define CRC_H
+
+#include "globals.h"
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length);
+uint32_t crc32(const uint8_t* data, size_t length);
+uint16_t crc16Update(uint16_t crc, const uint8_t* data, size_t length);
+uint16_t crc16(const uint8_t* data, size_t length);
+
+#endif // CRC_H
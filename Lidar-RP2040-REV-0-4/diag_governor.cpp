@@ -0,0 +1,171 @@
+/**
+ * @file diag_governor.cpp
+ * @brief This file contains the implementation of the diagnostic output governor.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the per-core token buckets, the suppressed-message counters and
+ * the GUI activity tracking used to give GUI packets priority on Serial.
+ */
+
+#include "diag_governor.h"
+#include "globals_config.h"
+#include "binlog.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
+#include <atomic>
+
+/**
+ * @brief Rate and burst of one category.
+ */
+struct DiagBucketConfig {
+  uint32_t period_ms;    ///< Milliseconds per sustained message; 0 = taken from the runtime config.
+  uint32_t burst;        ///< Messages allowed back to back.
+};
+
+/**
+ * @brief Bucket settings indexed by DiagCategory.
+ */
+static const DiagBucketConfig diag_bucket_config[DIAG_CATEGORY_COUNT] = {
+  { 1000 / DIAG_PARSE_RATE_PER_S, DIAG_PARSE_BURST },
+  { DIAG_TIMEOUT_INTERVAL_MS / LIDAR_SENSOR_COUNT, LIDAR_SENSOR_COUNT },
+  { 0, DIAG_OVERFLOW_BURST },
+  { 1000 / DIAG_HEALTH_RATE_PER_S, DIAG_HEALTH_BURST },
+  { 1000 / DIAG_TRIGGER_RATE_PER_S, DIAG_TRIGGER_BURST },
+};
+
+/**
+ * @brief Token bucket state. Each core only touches its own buckets.
+ */
+struct DiagBucket {
+  uint32_t tokens;                    ///< Available tokens, in milliseconds of refill (one token = one period).
+  uint32_t last_refill_ms;
+  bool initialized;
+  std::atomic<uint32_t> suppressed;   ///< Messages suppressed since boot.
+};
+
+static DiagBucket diag_buckets[2][DIAG_CATEGORY_COUNT];
+static std::atomic<uint32_t> last_gui_traffic_ms{0};
+static std::atomic<uint32_t> text_dropped{0};   ///< Text lines dropped to keep the GUI reserve free.
+
+/**
+ * @brief Checks whether a diagnostic message of a category may be emitted now.
+ *
+ * @details Takes one token from the calling core's bucket for the category. Never
+ * blocks and takes no lock. When the bucket is empty the message is counted as
+ * suppressed and false is returned. Queue overflow messages are paced by the
+ * critical error report interval (GUI parameter 12).
+ *
+ * @param category The diagnostic category.
+ * @return True if the message may be emitted.
+ */
+bool diagAllow(DiagCategory category) {
+  DiagBucket& bucket = diag_buckets[get_core_num()][category];
+  const DiagBucketConfig& config = diag_bucket_config[category];
+  uint32_t period = config.period_ms ? config.period_ms : RUNTIME_CRITICAL_ERROR_REPORT_INTERVAL_MS;
+  uint32_t now = millis();
+  uint32_t capacity = config.burst * period;
+
+  if (!bucket.initialized) {
+    bucket.tokens = capacity;
+    bucket.last_refill_ms = now;
+    bucket.initialized = true;
+  } else {
+    // Every elapsed millisecond refills one millisecond's worth of a token
+    uint32_t elapsed = safeMillisElapsed(bucket.last_refill_ms, now);
+    if (elapsed > 0) {
+      bucket.tokens = (elapsed >= capacity || bucket.tokens + elapsed > capacity) ? capacity : bucket.tokens + elapsed;
+      bucket.last_refill_ms = now;
+    }
+  }
+
+  if (bucket.tokens >= period) {
+    bucket.tokens -= period;
+    return true;
+  }
+  bucket.suppressed.store(bucket.suppressed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  return false;
+}
+
+/**
+ * @brief Reports newly suppressed message counts. Called from the Core 1 loop.
+ *
+ * @details Runs every DIAG_REPORT_INTERVAL_MS and logs one record per core and
+ * category whose count grew since the last report.
+ */
+void diagReportSuppressed() {
+  static const char* const category_names[DIAG_CATEGORY_COUNT] = { "parse", "timeout", "overflow", "health", "trigger" };
+  static uint32_t reported[2][DIAG_CATEGORY_COUNT] = {};
+  static uint32_t reported_text_dropped = 0;
+  static uint32_t last_report = 0;
+
+  uint32_t now = millis();
+  if (safeMillisElapsed(last_report, now) < DIAG_REPORT_INTERVAL_MS) return;
+  last_report = now;
+
+  for (uint8_t core = 0; core < 2; core++) {
+    for (uint8_t category = 0; category < DIAG_CATEGORY_COUNT; category++) {
+      uint32_t suppressed = diag_buckets[core][category].suppressed.load(std::memory_order_relaxed);
+      if (suppressed != reported[core][category]) {
+        if (LOG_INFO_ENABLED()) safeSerialPrintfln("Core %d: Suppressed %lu %s messages in last %d ms", core,
+                           (unsigned long)(suppressed - reported[core][category]),
+                           category_names[category], DIAG_REPORT_INTERVAL_MS);
+        reported[core][category] = suppressed;
+      }
+    }
+  }
+
+  uint32_t dropped = text_dropped.load(std::memory_order_relaxed);
+  if (dropped != reported_text_dropped) {
+    if (LOG_INFO_ENABLED()) safeSerialPrintfln("Core 1: Dropped %lu text lines behind GUI packets in last %d ms",
+                       (unsigned long)(dropped - reported_text_dropped), DIAG_REPORT_INTERVAL_MS);
+    reported_text_dropped = dropped;
+  }
+}
+
+/**
+ * @brief Records that a GUI packet was just received or sent.
+ */
+void diagNoteGuiTraffic() {
+  last_gui_traffic_ms.store(millis(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether the GUI protocol has been active recently.
+ * @return True if a GUI packet was seen within DIAG_GUI_ACTIVE_MS.
+ */
+bool diagGuiActive() {
+  uint32_t last = last_gui_traffic_ms.load(std::memory_order_relaxed);
+  return last != 0 && safeMillisElapsed(last, millis()) < DIAG_GUI_ACTIVE_MS;
+}
+
+/**
+ * @brief Gets the USB transmit space available to text output.
+ *
+ * @details While the GUI is active, DIAG_GUI_TX_RESERVE bytes are held back so
+ * that a response packet never has to wait behind queued text.
+ *
+ * @return The number of bytes text output may write without blocking.
+ */
+int diagTextTxSpace() {
+  int space = Serial.availableForWrite();
+  if (diagGuiActive()) space -= DIAG_GUI_TX_RESERVE;
+  return (space > 0) ? space : 0;
+}
+
+/**
+ * @brief Checks whether a line of text may be written to Serial now.
+ *
+ * @details Always true while the GUI is inactive. While it is active the line
+ * must fit in diagTextTxSpace(); otherwise it is counted as dropped. Call with
+ * the serial mutex held so the space cannot change before the write.
+ *
+ * @param length The number of bytes to write, including any line ending.
+ * @return True if the line may be written.
+ */
+bool diagTextFits(size_t length) {
+  if (!diagGuiActive() || diagTextTxSpace() >= (int)length) return true;
+  text_dropped.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file diag_governor.h
+ * @brief This file contains the declarations for the diagnostic output governor.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details All rate-limited diagnostic output goes through diagAllow(), which keeps
+ * one token bucket per category on each core. A message that finds its bucket
+ * empty is suppressed and counted, and the suppressed counts are reported
+ * periodically from Core 1. While the GUI protocol is active, text output only
+ * uses USB transmit space beyond a reserve kept for GUI packets; text lines
+ * that do not fit are dropped and counted rather than queued ahead of them.
+ */
+#ifndef DIAG_GOVERNOR_H
+#define DIAG_GOVERNOR_H
+
+#include "globals.h"
+
+/**
+ * @brief Defines the diagnostic output categories, each with its own token bucket.
+ */
+enum DiagCategory {
+  DIAG_PARSE,       ///< Per-frame parse errors: sync, checksum, validation.
+  DIAG_TIMEOUT,     ///< Frame timeouts, reported rarely since a silent sensor times out continuously.
+  DIAG_OVERFLOW,    ///< Frame queue overflow.
+  DIAG_HEALTH,      ///< Communication health and recovery notices.
+  DIAG_TRIGGER,     ///< Trigger activations.
+  DIAG_CATEGORY_COUNT
+};
+
+bool diagAllow(DiagCategory category);
+void diagReportSuppressed();
+void diagNoteGuiTraffic();
+bool diagGuiActive();
+int diagTextTxSpace();
+bool diagTextFits(size_t length);
+
+#endif // DIAG_GOVERNOR_H
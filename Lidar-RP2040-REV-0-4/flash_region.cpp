@@ -0,0 +1,116 @@
+/**
+ * @file flash_region.cpp
+ * @brief This file contains the implementation of raw access to the flash filesystem region.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Erase and program follow arduino-pico's EEPROM library: interrupts
+ * off, Core 0 idled, then the SDK flash call. Callers keep each call short
+ * (one sector erase or a few pages) so the pause stays bounded. Every pause is
+ * timed with micros(), which reads the hardware timer and keeps counting with
+ * interrupts off.
+ */
+
+#include "flash_region.h"
+#include "trace.h"
+
+/** @brief Linker symbols bounding the filesystem region (defined by the arduino-pico linker script). */
+extern uint8_t _FS_start;
+extern uint8_t _FS_end;
+
+static FlashRegionStats flash_stats;
+
+/**
+ * @brief Gets the size of the region.
+ * @return The region size in bytes; 0 if the flash layout has no filesystem.
+ */
+uint32_t flashRegionSize() {
+  return (uint32_t)(&_FS_end - &_FS_start);
+}
+
+/**
+ * @brief Gets a pointer to region contents through the XIP window.
+ * @param offset The offset in the region.
+ * @return The mapped address.
+ */
+const uint8_t* flashRegionData(uint32_t offset) {
+  return &_FS_start + offset;
+}
+
+/**
+ * @brief Checks whether part of the region is erased.
+ * @param offset The offset in the region (4-byte aligned).
+ * @param size The number of bytes (multiple of 4).
+ * @return True if every byte reads 0xFF.
+ */
+bool flashRegionBlank(uint32_t offset, uint32_t size) {
+  const uint32_t* words = (const uint32_t*)flashRegionData(offset);
+  for (uint32_t i = 0; i < size / 4; i++) {
+    if (words[i] != 0xFFFFFFFFUL) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Gets the flash offset of a region offset, as used by the SDK flash functions.
+ */
+static uint32_t flashOffset(uint32_t offset) {
+  return (uint32_t)((uintptr_t)&_FS_start - XIP_BASE) + offset;
+}
+
+/**
+ * @brief Adds one stall to the counters.
+ * @param start_us micros() before Core 0 was paused.
+ * @param max_us The longest stall of this kind, updated.
+ */
+static void noteStall(uint32_t start_us, uint32_t& max_us) {
+  uint32_t stall_us = micros() - start_us;
+  if (stall_us > max_us) max_us = stall_us;
+  flash_stats.stall_total_us += stall_us;
+}
+
+/**
+ * @brief Erases part of the region with Core 0 paused.
+ * @param offset The offset in the region (sector aligned).
+ * @param size The number of bytes (multiple of FLASH_SECTOR_SIZE).
+ */
+void flashRegionErase(uint32_t offset, uint32_t size) {
+  TRACE_BEGIN_EVENT(TRACE_FLASH_WRITE, offset / FLASH_SECTOR_SIZE);
+  uint32_t start_us = micros();
+  noInterrupts();
+  rp2040.idleOtherCore();
+  flash_range_erase(flashOffset(offset), size);
+  rp2040.resumeOtherCore();
+  interrupts();
+  noteStall(start_us, flash_stats.erase_max_us);
+  flash_stats.erases++;
+  TRACE_END_EVENT(TRACE_FLASH_WRITE, offset / FLASH_SECTOR_SIZE);
+}
+
+/**
+ * @brief Programs erased flash in the region with Core 0 paused.
+ * @param offset The offset in the region (page aligned).
+ * @param data The bytes to program.
+ * @param size The number of bytes (multiple of FLASH_PAGE_SIZE).
+ */
+void flashRegionProgram(uint32_t offset, const uint8_t* data, uint32_t size) {
+  TRACE_BEGIN_EVENT(TRACE_FLASH_WRITE, offset / FLASH_SECTOR_SIZE);
+  uint32_t start_us = micros();
+  noInterrupts();
+  rp2040.idleOtherCore();
+  flash_range_program(flashOffset(offset), data, size);
+  rp2040.resumeOtherCore();
+  interrupts();
+  noteStall(start_us, flash_stats.program_max_us);
+  flash_stats.programs++;
+  TRACE_END_EVENT(TRACE_FLASH_WRITE, offset / FLASH_SECTOR_SIZE);
+}
+
+/**
+ * @brief Gets the flash write counters.
+ * @return The counters since boot.
+ */
+const FlashRegionStats& flashRegionGetStats() {
+  return flash_stats;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file flash_region.h
+ * @brief This file contains the declarations for raw access to the flash filesystem region.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The firmware does not mount a filesystem. The flash region the board
+ * package reserves for one (Tools > Flash Size, "FS") is used directly instead:
+ *
+ *   offset 0                            config store, slots A and B (config_store.h)
+ *   FLASH_REGION_SNAPSHOT_OFFSET        persisted trigger snapshots, if any (snapshot.h)
+ *   FLASH_REGION_RECORDER_OFFSET        frame recorder log (recorder.h)
+ *
+ * Offsets are relative to the start of the region. Reads go through the XIP
+ * window; erases and programs pause Core 0 for their duration, because
+ * neither core can execute from flash while it is busy. The longest pause of
+ * each kind is measured (flashRegionGetStats()).
+ */
+#ifndef FLASH_REGION_H
+#define FLASH_REGION_H
+
+#include "globals.h"
+#include <hardware/flash.h>
+
+/** @brief Start of the config store. */
+#define FLASH_REGION_CONFIG_OFFSET 0
+/** @brief Start of the persisted trigger snapshots, after the two config store slots. */
+#define FLASH_REGION_SNAPSHOT_OFFSET (2 * FLASH_SECTOR_SIZE)
+/** @brief Flash per persisted snapshot: 16 bytes per sample plus at most 256 bytes of header, in whole sectors. */
+#define FLASH_REGION_SNAPSHOT_SLOT_SIZE \
+  ((((SNAPSHOT_PRE_FRAMES + 1 + SNAPSHOT_POST_FRAMES) * 16 + 256) + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE * FLASH_SECTOR_SIZE)
+#if ENABLE_TRIGGER_SNAPSHOTS
+#define FLASH_REGION_SNAPSHOT_SIZE (SNAPSHOT_FLASH_SLOTS * FLASH_REGION_SNAPSHOT_SLOT_SIZE)
+#else
+#define FLASH_REGION_SNAPSHOT_SIZE 0
+#endif
+/** @brief Start of the frame recorder log, after the persisted snapshots. */
+#define FLASH_REGION_RECORDER_OFFSET (FLASH_REGION_SNAPSHOT_OFFSET + FLASH_REGION_SNAPSHOT_SIZE)
+
+/**
+ * @brief Flash write counters since boot. A stall is the time from pausing Core 0 to resuming it.
+ */
+struct FlashRegionStats {
+  uint32_t erases;            ///< Erase calls.
+  uint32_t programs;          ///< Program calls.
+  uint32_t erase_max_us;      ///< Longest erase stall.
+  uint32_t program_max_us;    ///< Longest program stall.
+  uint32_t stall_total_us;    ///< Sum of all stalls.
+};
+
+uint32_t flashRegionSize();
+const uint8_t* flashRegionData(uint32_t offset);
+bool flashRegionBlank(uint32_t offset, uint32_t size);
+void flashRegionErase(uint32_t offset, uint32_t size);
+void flashRegionProgram(uint32_t offset, const uint8_t* data, uint32_t size);
+const FlashRegionStats& flashRegionGetStats();
+
+#endif // FLASH_REGION_H
@@ -0,0 +1,216 @@
+/**
+ * @file frame_codec.cpp
+ * @brief This file contains the implementation of the LiDAR frame stream codec.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Encoding a frame is a few dozen instructions and touches only the
+ * sensor's predictor. The interval smoothing uses integer shifts only, so the
+ * firmware, the C++ host library and tools/frame_stream.py track exactly
+ * the same prediction.
+ */
+
+#include "frame_codec.h"
+#include <string.h>
+
+/**
+ * @brief Appends an unsigned LEB128 varint.
+ */
+static uint8_t* putVarint(uint8_t* out, uint32_t value) {
+  while (value >= 0x80) {
+    *out++ = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (uint8_t)value;
+  return out;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint of at most 5 bytes.
+ * @return The position after the varint, or nullptr if it is truncated or too long.
+ */
+static const uint8_t* getVarint(const uint8_t* in, const uint8_t* end, uint32_t& value) {
+  value = 0;
+  for (uint8_t shift = 0; shift < 35 && in < end; shift += 7) {
+    uint8_t byte = *in++;
+    value |= (uint32_t)(byte & 0x7F) << shift;
+    if (byte < 0x80) return in;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Maps a signed delta to an unsigned value with small magnitudes first (0, -1, 1, -2, ...).
+ */
+static uint32_t zigzag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+/**
+ * @brief Reverses zigzag().
+ */
+static int32_t unzigzag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/**
+ * @brief Gets the predicted interval in us.
+ */
+static uint32_t predictedInterval(const FrameCodecPredictor& predictor) {
+  return (uint32_t)((predictor.interval_q4 + 8) >> 4);
+}
+
+/**
+ * @brief Folds a measured interval into the smoothed interval (1/8 weight; the first one is taken as is).
+ */
+static void trackInterval(FrameCodecPredictor& predictor, uint32_t interval) {
+  int32_t interval_q4 = (int32_t)(interval << 4);
+  if (predictor.interval_q4 == 0) {
+    predictor.interval_q4 = interval_q4;
+  } else {
+    predictor.interval_q4 += (interval_q4 - predictor.interval_q4) >> 3;
+  }
+}
+
+/**
+ * @brief Forgets all predictors; the next frame of every sensor is a keyframe.
+ * @param state The encoder or decoder state.
+ */
+void frameCodecReset(FrameCodecState& state) {
+  memset(&state, 0, sizeof(state));
+}
+
+/**
+ * @brief Encodes one frame.
+ * @param state The encoder state.
+ * @param frame The frame; sensor_id must be below MAX_LIDAR_SENSORS.
+ * @param out Receives the encoding; must have room for FRAME_CODEC_MAX_FRAME_BYTES.
+ * @return The number of bytes written.
+ */
+size_t frameCodecEncode(FrameCodecState& state, const LidarFrame& frame, uint8_t* out) {
+  uint8_t sensor = frame.sensor_id & FRAME_CODEC_SENSOR_MASK;
+  FrameCodecPredictor& predictor = state.sensors[sensor];
+  uint32_t interval = frame.timestamp - predictor.timestamp;
+  uint8_t* start = out;
+
+  if (!predictor.valid || predictor.frames_since_keyframe >= FRAME_CODEC_KEYFRAME_INTERVAL ||
+      interval > FRAME_CODEC_MAX_INTERVAL_US) {
+    uint32_t nominal = predictor.valid ? predictedInterval(predictor) : 0;
+    *out++ = sensor | FRAME_CODEC_EXTENDED;
+    *out++ = FRAME_CODEC_EXT_KEYFRAME;
+    out = putVarint(out, frame.distance);
+    out = putVarint(out, frame.strength);
+    out = putVarint(out, frame.temperature);
+    out = putVarint(out, frame.timestamp);
+    out = putVarint(out, nominal);
+    predictor.interval_q4 = (int32_t)(nominal << 4);
+    predictor.frames_since_keyframe = 0;
+    predictor.valid = true;
+  } else {
+    int32_t distance_delta = (int32_t)frame.distance - predictor.distance;
+    int32_t residual = (int32_t)(interval - predictedInterval(predictor));
+    bool temperature_changed = frame.temperature != predictor.temperature;
+    uint8_t distance_code = (distance_delta >= -3 && distance_delta <= 3) ? (uint8_t)(distance_delta + 3)
+                                                                          : FRAME_CODEC_DISTANCE_ESCAPE;
+    uint8_t timing_code = residual == 0 ? 0 : residual == -1 ? 1 : residual == 1 ? 2 : FRAME_CODEC_TIMING_ESCAPE;
+
+    *out++ = sensor | (distance_code << FRAME_CODEC_DISTANCE_SHIFT) | (timing_code << FRAME_CODEC_TIMING_SHIFT) |
+             (temperature_changed ? FRAME_CODEC_EXTENDED : 0);
+    if (temperature_changed) *out++ = FRAME_CODEC_EXT_TEMPERATURE;
+    if (distance_code == FRAME_CODEC_DISTANCE_ESCAPE) out = putVarint(out, zigzag(distance_delta));
+    out = putVarint(out, zigzag((int32_t)frame.strength - predictor.strength));
+    if (timing_code == FRAME_CODEC_TIMING_ESCAPE) out = putVarint(out, zigzag(residual));
+    if (temperature_changed) out = putVarint(out, zigzag((int32_t)frame.temperature - predictor.temperature));
+    trackInterval(predictor, interval);
+    predictor.frames_since_keyframe++;
+  }
+
+  predictor.distance = frame.distance;
+  predictor.strength = frame.strength;
+  predictor.temperature = frame.temperature;
+  predictor.timestamp = frame.timestamp;
+  return out - start;
+}
+
+/**
+ * @brief Decodes one frame.
+ * @param state The decoder state.
+ * @param in The encoded stream, positioned at a frame boundary.
+ * @param length The bytes available from in.
+ * @param frame Receives the frame when decoded is set.
+ * @param decoded Set if the frame was decoded; clear if it belongs to a sensor
+ *        with no keyframe yet (joined mid-stream).
+ * @return The bytes consumed, or 0 if the data is truncated or malformed.
+ */
+size_t frameCodecDecode(FrameCodecState& state, const uint8_t* in, size_t length, LidarFrame& frame, bool& decoded) {
+  const uint8_t* end = in + length;
+  const uint8_t* p = in;
+  decoded = false;
+  if (p == end) return 0;
+
+  uint8_t header = *p++;
+  uint8_t extension = 0;
+  if (header & FRAME_CODEC_EXTENDED) {
+    if (p == end) return 0;
+    extension = *p++;
+  }
+  uint8_t sensor = header & FRAME_CODEC_SENSOR_MASK;
+  FrameCodecPredictor& predictor = state.sensors[sensor];
+
+  if (extension & FRAME_CODEC_EXT_KEYFRAME) {
+    uint32_t distance, strength, temperature, timestamp, nominal;
+    if (!(p = getVarint(p, end, distance)) || !(p = getVarint(p, end, strength)) ||
+        !(p = getVarint(p, end, temperature)) || !(p = getVarint(p, end, timestamp)) ||
+        !(p = getVarint(p, end, nominal)) || nominal > FRAME_CODEC_MAX_INTERVAL_US) {
+      return 0;
+    }
+    predictor.distance = (uint16_t)distance;
+    predictor.strength = (uint16_t)strength;
+    predictor.temperature = (uint16_t)temperature;
+    predictor.timestamp = timestamp;
+    predictor.interval_q4 = (int32_t)(nominal << 4);
+    predictor.frames_since_keyframe = 0;
+    predictor.valid = true;
+  } else {
+    uint8_t distance_code = (header >> FRAME_CODEC_DISTANCE_SHIFT) & FRAME_CODEC_DISTANCE_MASK;
+    uint8_t timing_code = (header >> FRAME_CODEC_TIMING_SHIFT) & FRAME_CODEC_TIMING_MASK;
+    uint32_t value;
+    int32_t distance_delta = (int32_t)distance_code - 3;
+    int32_t strength_delta, residual = timing_code == 1 ? -1 : timing_code == 2 ? 1 : 0;
+    int32_t temperature_delta = 0;
+
+    if (distance_code == FRAME_CODEC_DISTANCE_ESCAPE) {
+      if (!(p = getVarint(p, end, value))) return 0;
+      distance_delta = unzigzag(value);
+    }
+    if (!(p = getVarint(p, end, value))) return 0;
+    strength_delta = unzigzag(value);
+    if (timing_code == FRAME_CODEC_TIMING_ESCAPE) {
+      if (!(p = getVarint(p, end, value))) return 0;
+      residual = unzigzag(value);
+    }
+    if (extension & FRAME_CODEC_EXT_TEMPERATURE) {
+      if (!(p = getVarint(p, end, value))) return 0;
+      temperature_delta = unzigzag(value);
+    }
+    if (!predictor.valid) return p - in;
+
+    uint32_t interval = predictedInterval(predictor) + (uint32_t)residual;
+    if (interval > FRAME_CODEC_MAX_INTERVAL_US) return 0;  // The encoder sends a keyframe instead
+    predictor.distance = (uint16_t)(predictor.distance + distance_delta);
+    predictor.strength = (uint16_t)(predictor.strength + strength_delta);
+    predictor.temperature = (uint16_t)(predictor.temperature + temperature_delta);
+    predictor.timestamp += interval;
+    trackInterval(predictor, interval);
+    predictor.frames_since_keyframe++;
+  }
+
+  frame.distance = predictor.distance;
+  frame.strength = predictor.strength;
+  frame.temperature = predictor.temperature;
+  frame.timestamp = predictor.timestamp;
+  frame.sensor_id = sensor;
+  decoded = true;
+  return p - in;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file frame_codec.h
+ * @brief This file contains the declarations for the LiDAR frame stream codec.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details A lossless delta codec for LidarFrame streams, shared by the frame
+ * recorder and any other consumer that stores or sends frames. Each sensor
+ * in the stream has its own predictor. Frames normally encode to a header
+ * byte and a strength delta:
+ *
+ *   header  bits 0-1  sensor index
+ *           bits 2-4  distance delta -3..+3 cm (code - 3), or 7 = zig-zag varint follows
+ *           bits 5-6  timing residual 0 = 0 us, 1 = -1 us, 2 = +1 us, 3 = zig-zag varint follows
+ *           bit 7     extension byte follows
+ *   [ext]   bit 0 keyframe, bit 1 temperature delta follows
+ *   [distance varint] strength zig-zag varint [timing varint] [temperature zig-zag varint]
+ *
+ * The timing residual is the timestamp's offset from the previous timestamp
+ * plus a smoothed frame interval, so a steady frame rate costs nothing.
+ *
+ * A keyframe (header bits 2-6 zero) carries absolute values instead:
+ * distance, strength, temperature, timestamp and the smoothed interval in us,
+ * all as plain varints. Every sensor starts with one, gets another every
+ * FRAME_CODEC_KEYFRAME_INTERVAL frames and after a gap longer than
+ * FRAME_CODEC_MAX_INTERVAL_US, so a decoder can join a stream at any frame
+ * boundary. Frames of a sensor seen before its first keyframe are still
+ * parsed (every frame is self-delimiting) but reported as not decodable.
+ *
+ * The codec uses no Arduino APIs, so host tools build this file unchanged
+ * (tools/frame_codec).
+ */
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#ifdef ARDUINO
+#include "globals.h"
+#else
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Host build: must match MAX_LIDAR_SENSORS in globals.h. */
+#define MAX_LIDAR_SENSORS 4
+
+/** @brief Host build: must match LidarFrame in globals.h. */
+struct LidarFrame {
+  uint16_t distance;
+  uint16_t strength;
+  uint16_t temperature;
+  uint32_t timestamp;
+  uint8_t sensor_id;
+};
+#endif
+
+/** @brief Frames per sensor between keyframes - shorter lets decoders join a stream sooner, longer compresses better. */
+#define FRAME_CODEC_KEYFRAME_INTERVAL 256
+/** @brief Longest frame interval (us) coded as a residual; longer gaps start with a keyframe. */
+#define FRAME_CODEC_MAX_INTERVAL_US 65535
+/** @brief Largest encoding of one frame: header, extension and a keyframe (3 + 3 + 3 + 5 + 3 bytes). */
+#define FRAME_CODEC_MAX_FRAME_BYTES 19
+
+/**
+ * @brief Header and extension byte layout.
+ * @{
+ */
+#define FRAME_CODEC_SENSOR_MASK 0x03
+#define FRAME_CODEC_DISTANCE_SHIFT 2
+#define FRAME_CODEC_DISTANCE_MASK 0x07
+#define FRAME_CODEC_DISTANCE_ESCAPE 7
+#define FRAME_CODEC_TIMING_SHIFT 5
+#define FRAME_CODEC_TIMING_MASK 0x03
+#define FRAME_CODEC_TIMING_ESCAPE 3
+#define FRAME_CODEC_EXTENDED 0x80
+#define FRAME_CODEC_EXT_KEYFRAME 0x01
+#define FRAME_CODEC_EXT_TEMPERATURE 0x02
+/** @} */
+
+/**
+ * @brief Per-sensor prediction state; identical on the encoding and decoding side.
+ */
+struct FrameCodecPredictor {
+  uint16_t distance;
+  uint16_t strength;
+  uint16_t temperature;
+  uint16_t frames_since_keyframe;
+  uint32_t timestamp;
+  int32_t interval_q4;     ///< Smoothed frame interval in 1/16 us; 0 until the first interval is seen.
+  bool valid;              ///< A keyframe has been seen for this sensor.
+};
+
+/**
+ * @brief Codec state for one stream. Encoder and decoder each keep their own copy.
+ */
+struct FrameCodecState {
+  FrameCodecPredictor sensors[MAX_LIDAR_SENSORS];
+};
+
+void frameCodecReset(FrameCodecState& state);
+size_t frameCodecEncode(FrameCodecState& state, const LidarFrame& frame, uint8_t* out);
+size_t frameCodecDecode(FrameCodecState& state, const uint8_t* in, size_t length, LidarFrame& frame, bool& decoded);
+
+#endif // FRAME_CODEC_H
@@ -11,12 +11,11 @@
  */
 
 #include "globals.h"
+#include "diag_governor.h"
 
 // ===== GLOBAL VARIABLE DEFINITIONS =====
-LidarFrame frame_buffer[FRAME_BUFFER_SIZE];
-volatile uint8_t buffer_head = 0;
-volatile uint8_t buffer_tail = 0;
-volatile uint8_t buffer_count = 0;
+FrameQueue frame_queues[LIDAR_SENSOR_COUNT];
+volatile uint16_t sensor_temperature[LIDAR_SENSOR_COUNT];
 
 CoreComm core_comm = { 
   false,  // lidar_initialized
@@ -49,7 +48,6 @@ Core1InitState core1_state = CORE1_STARTUP;
 uint32_t core1_state_timer = 0;
 SystemState current_state = STATE_INIT;
 LidarConfiguration currentConfig;
-static char debug_buffer[DEBUG_BUFFER_SIZE];
 
 /**
  * @brief Thread-safe helper functions.
@@ -100,18 +98,26 @@ void safeSetErrorFlag(uint32_t flag, bool set) {
 
 /**
  * @brief Prints a formatted string to the serial port in a thread-safe manner.
+ *
+ * @details The string is formatted into a stack buffer before the serial mutex is
+ * taken, so the mutex is only held for the write itself. Hot paths should use
+ * binlog() instead, which neither formats nor blocks. Like every safeSerialPrint
+ * function it drops the text while the GUI is active and it would eat into the
+ * transmit space reserved for GUI packets (see diagTextFits()).
+ *
  * @param format The format string.
  * @param ... The arguments for the format string.
  */
 void safeSerialPrintf(const char* format, ...) {
+  char buffer[DEBUG_BUFFER_SIZE];
   va_list args;
   va_start(args, format);
+  vsnprintf(buffer, DEBUG_BUFFER_SIZE, format, args);
+  va_end(args);
+  buffer[DEBUG_BUFFER_SIZE - 1] = '\0';
   mutex_enter_blocking(&serial_mutex);
-  vsnprintf(debug_buffer, DEBUG_BUFFER_SIZE, format, args);
-  debug_buffer[DEBUG_BUFFER_SIZE - 1] = '\0';
-  Serial.print(debug_buffer);
+  if (diagTextFits(strlen(buffer))) Serial.print(buffer);
   mutex_exit(&serial_mutex);
-  va_end(args);
 }
 
 /**
@@ -120,14 +126,35 @@ void safeSerialPrintf(const char* format, ...) {
  * @param ... The arguments for the format string.
  */
 void safeSerialPrintfln(const char* format, ...) {
+  char buffer[DEBUG_BUFFER_SIZE];
   va_list args;
   va_start(args, format);
+  vsnprintf(buffer, DEBUG_BUFFER_SIZE, format, args);
+  va_end(args);
+  buffer[DEBUG_BUFFER_SIZE - 1] = '\0';
   mutex_enter_blocking(&serial_mutex);
-  vsnprintf(debug_buffer, DEBUG_BUFFER_SIZE, format, args);
-  debug_buffer[DEBUG_BUFFER_SIZE - 1] = '\0';
-  Serial.println(debug_buffer);
+  if (diagTextFits(strlen(buffer) + 2)) Serial.println(buffer);
+  mutex_exit(&serial_mutex);
+}
+
+/**
+ * @brief Prints a C string followed by a newline to the serial port in a thread-safe manner.
+ * @param msg The string to print.
+ */
+void safeSerialPrintln(const char* msg) {
+  mutex_enter_blocking(&serial_mutex);
+  if (diagTextFits(strlen(msg) + 2)) Serial.println(msg);
+  mutex_exit(&serial_mutex);
+}
+
+/**
+ * @brief Prints a C string to the serial port in a thread-safe manner.
+ * @param msg The string to print.
+ */
+void safeSerialPrint(const char* msg) {
+  mutex_enter_blocking(&serial_mutex);
+  if (diagTextFits(strlen(msg))) Serial.print(msg);
   mutex_exit(&serial_mutex);
-  va_end(args);
 }
 
 /**
@@ -136,7 +163,7 @@ void safeSerialPrintfln(const char* format, ...) {
  */
 void safeSerialPrintln(const String& msg) {
   mutex_enter_blocking(&serial_mutex);
-  Serial.println(msg);
+  if (diagTextFits(msg.length() + 2)) Serial.println(msg);
   mutex_exit(&serial_mutex);
 }
 
@@ -146,7 +173,7 @@ void safeSerialPrintln(const String& msg) {
  */
 void safeSerialPrint(const String& msg) {
   mutex_enter_blocking(&serial_mutex);
-  Serial.print(msg);
+  if (diagTextFits(msg.length())) Serial.print(msg);
   mutex_exit(&serial_mutex);
 }
 
@@ -200,6 +227,16 @@ void safeIncrementFramesProcessed() {
   mutex_exit(&comm_mutex);
 }
 
+/**
+ * @brief Adds a batch of frames to the frames processed counter in a thread-safe manner.
+ * @param count The number of frames processed.
+ */
+void safeAddFramesProcessed(uint32_t count) {
+  mutex_enter_blocking(&comm_mutex);
+  core_comm.frames_processed += count;
+  mutex_exit(&comm_mutex);
+}
+
 /**
  * @brief Increments the dropped frames counter in a thread-safe manner.
  */
@@ -211,14 +248,15 @@ void safeIncrementDroppedFrames() {
 }
 
 /**
- * @brief Checks if debug output is enabled in a thread-safe manner.
+ * @brief Checks if debug output is enabled.
+ *
+ * @details A single relaxed atomic load - the flag is one byte, and callers only
+ * need to see a change eventually, not in order with other shared state.
+ *
  * @return True if debug output is enabled, false otherwise.
  */
 bool isDebugEnabled() {
-  mutex_enter_blocking(&comm_mutex);
-  bool debug_enabled = core_comm.enable_debug;
-  mutex_exit(&comm_mutex);
-  return debug_enabled;
+  return __atomic_load_n(&core_comm.enable_debug, __ATOMIC_RELAXED);
 }
 
 /**
@@ -242,8 +280,49 @@ void updateAdaptiveTimeout(uint32_t observed_frame_rate) {
  */
 
 /**
- * @brief Pushes a LiDAR frame to the circular buffer in a thread-safe manner.
- * @param frame The LiDAR frame to push.
+ * @brief Packs a LiDAR frame into its 8-byte queue representation.
+ * @param frame The frame to pack. Strength above 12 bits is saturated.
+ * @return The packed frame.
+ */
+PackedLidarFrame packLidarFrame(const LidarFrame& frame) {
+  uint32_t distance = frame.distance > PACKED_DISTANCE_MAX ? PACKED_DISTANCE_MAX : frame.distance;
+  uint32_t strength = frame.strength > PACKED_STRENGTH_MAX ? PACKED_STRENGTH_MAX : frame.strength;
+  PackedLidarFrame packed;
+  packed.fields = (distance << PACKED_DISTANCE_SHIFT) |
+                  (strength << PACKED_STRENGTH_SHIFT) |
+                  ((uint32_t)frame.sensor_id << PACKED_SENSOR_ID_SHIFT);
+  packed.timestamp = frame.timestamp;
+  return packed;
+}
+
+/**
+ * @brief Unpacks a queued frame, filling the temperature from the out-of-band value.
+ * @param packed The packed frame.
+ * @param frame Receives the unpacked frame.
+ */
+void unpackLidarFrame(const PackedLidarFrame& packed, LidarFrame& frame) {
+  frame.distance = (packed.fields >> PACKED_DISTANCE_SHIFT) & PACKED_DISTANCE_MAX;
+  frame.strength = (packed.fields >> PACKED_STRENGTH_SHIFT) & PACKED_STRENGTH_MAX;
+  frame.sensor_id = (packed.fields >> PACKED_SENSOR_ID_SHIFT) & ((1u << PACKED_SENSOR_ID_BITS) - 1);
+  frame.timestamp = packed.timestamp;
+  frame.temperature = sensor_temperature[frame.sensor_id];
+}
+
+/**
+ * @brief Returns the fill level of the fullest frame queue. Caller must hold buffer_mutex.
+ * @return The highest frame count across all sensor queues.
+ */
+static uint8_t maxQueueCountLocked() {
+  uint8_t max_count = 0;
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) {
+    if (frame_queues[i].count > max_count) max_count = frame_queues[i].count;
+  }
+  return max_count;
+}
+
+/**
+ * @brief Pushes a LiDAR frame to its sensor's circular buffer in a thread-safe manner.
+ * @param frame The LiDAR frame to push. `frame.sensor_id` selects the queue.
  * @return True if the frame was pushed successfully, false if the buffer was full.
  */
 bool atomicBufferPush(const LidarFrame& frame) {
@@ -252,17 +331,19 @@ bool atomicBufferPush(const LidarFrame& frame) {
   bool should_set_critical = false;
   bool should_clear_warnings = false;
   uint8_t current_count = 0;
+  FrameQueue& queue = frame_queues[frame.sensor_id];
+  PackedLidarFrame packed = packLidarFrame(frame);
 
   mutex_enter_blocking(&buffer_mutex);
-  if (buffer_count < FRAME_BUFFER_SIZE) {
-    frame_buffer[buffer_head] = frame;
-    buffer_head = (buffer_head + 1) % FRAME_BUFFER_SIZE;
-    buffer_count++;
+  if (queue.count < FRAME_BUFFER_SIZE) {
+    queue.frames[queue.head] = packed;
+    queue.head = (queue.head + 1) % FRAME_BUFFER_SIZE;
+    queue.count++;
     success = true;
-    current_count = buffer_count;
-    if (buffer_count >= BUFFER_WARNING_THRESHOLD) {
+    current_count = maxQueueCountLocked();
+    if (current_count >= BUFFER_WARNING_THRESHOLD) {
       should_set_warning = true;
-      if (buffer_count >= BUFFER_CRITICAL_THRESHOLD) {
+      if (current_count >= BUFFER_CRITICAL_THRESHOLD) {
         should_set_critical = true;
       }
     } else {
@@ -294,37 +375,109 @@ bool atomicBufferPush(const LidarFrame& frame) {
 }
 
 /**
- * @brief Pops a LiDAR frame from the circular buffer in a thread-safe manner.
+ * @brief Pops a LiDAR frame from a sensor's circular buffer in a thread-safe manner.
+ *
+ * @details Only the 8-byte packed form is copied while the buffer mutex is held; the
+ * frame is unpacked after the mutex is released.
+ *
+ * @param sensor_id The sensor whose queue is read.
  * @param frame A reference to a LidarFrame object to store the popped frame.
  * @return True if a frame was popped successfully, false if the buffer was empty.
  */
-bool atomicBufferPop(LidarFrame& frame) {
+bool atomicBufferPop(uint8_t sensor_id, LidarFrame& frame) {
   bool success = false;
+  PackedLidarFrame packed;
+  FrameQueue& queue = frame_queues[sensor_id];
   mutex_enter_blocking(&buffer_mutex);
-  if (buffer_count > 0) {
-    frame = frame_buffer[buffer_tail];
-    buffer_tail = (buffer_tail + 1) % FRAME_BUFFER_SIZE;
-    buffer_count--;
+  if (queue.count > 0) {
+    packed = queue.frames[queue.tail];
+    queue.tail = (queue.tail + 1) % FRAME_BUFFER_SIZE;
+    queue.count--;
     success = true;
-    if (buffer_count < BUFFER_WARNING_THRESHOLD) {
+    if (maxQueueCountLocked() < BUFFER_WARNING_THRESHOLD) {
       safeSetErrorFlag(ERROR_FLAG_BUFFER_WARNING, false);
       safeSetErrorFlag(ERROR_FLAG_BUFFER_CRITICAL, false);
     }
   }
   mutex_exit(&buffer_mutex);
   if (success) {
+    unpackLidarFrame(packed, frame);
     safeIncrementFramesProcessed();
   }
   return success;
 }
 
 /**
- * @brief Gets the number of frames currently in the buffer in a thread-safe manner.
+ * @brief Pops up to max_frames LiDAR frames from a sensor's circular buffer at once.
+ *
+ * @details The buffer mutex is taken once for the whole batch and only the packed
+ * frames are copied under it. Unpacking, clearing the buffer warning flags and
+ * updating the processed counter happen once after the mutex is released.
+ *
+ * @param sensor_id The sensor whose queue is read.
+ * @param frames Receives the popped frames, oldest first.
+ * @param max_frames The capacity of frames.
+ * @return The number of frames popped.
+ */
+uint8_t atomicBufferPopBatch(uint8_t sensor_id, LidarFrame* frames, uint8_t max_frames) {
+  PackedLidarFrame packed[FRAME_BUFFER_SIZE];
+  FrameQueue& queue = frame_queues[sensor_id];
+  uint8_t popped = 0;
+  bool below_warning = false;
+
+  if (max_frames > FRAME_BUFFER_SIZE) max_frames = FRAME_BUFFER_SIZE;
+
+  mutex_enter_blocking(&buffer_mutex);
+  while (popped < max_frames && queue.count > 0) {
+    packed[popped++] = queue.frames[queue.tail];
+    queue.tail = (queue.tail + 1) % FRAME_BUFFER_SIZE;
+    queue.count--;
+  }
+  if (popped > 0) below_warning = maxQueueCountLocked() < BUFFER_WARNING_THRESHOLD;
+  mutex_exit(&buffer_mutex);
+
+  if (popped == 0) return 0;
+
+  for (uint8_t i = 0; i < popped; i++) {
+    unpackLidarFrame(packed[i], frames[i]);
+  }
+  if (below_warning) {
+    safeSetErrorFlag(ERROR_FLAG_BUFFER_WARNING, false);
+    safeSetErrorFlag(ERROR_FLAG_BUFFER_CRITICAL, false);
+  }
+  safeAddFramesProcessed(popped);
+  return popped;
+}
+
+/**
+ * @brief Discards all frames in a sensor's queue.
+ * @param sensor_id The sensor whose queue is flushed.
+ */
+void flushFrameQueue(uint8_t sensor_id) {
+  mutex_enter_blocking(&buffer_mutex);
+  frame_queues[sensor_id].head = frame_queues[sensor_id].tail = frame_queues[sensor_id].count = 0;
+  mutex_exit(&buffer_mutex);
+}
+
+/**
+ * @brief Gets the number of frames currently in a sensor's buffer in a thread-safe manner.
+ * @param sensor_id The sensor whose queue is inspected.
  * @return The number of frames in the buffer.
  */
-uint8_t getBufferUtilization() {
+uint8_t getBufferUtilization(uint8_t sensor_id) {
+  mutex_enter_blocking(&buffer_mutex);
+  uint8_t count = frame_queues[sensor_id].count;
+  mutex_exit(&buffer_mutex);
+  return count;
+}
+
+/**
+ * @brief Gets the fill level of the fullest sensor queue in a thread-safe manner.
+ * @return The highest frame count across all sensor queues.
+ */
+uint8_t getMaxBufferUtilization() {
   mutex_enter_blocking(&buffer_mutex);
-  uint8_t count = buffer_count;
+  uint8_t count = maxQueueCountLocked();
   mutex_exit(&buffer_mutex);
   return count;
 }
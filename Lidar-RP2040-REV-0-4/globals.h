@@ -29,27 +29,44 @@
 #if USE_1000HZ_MODE
 /** @brief LiDAR sample rate - higher = more data but more CPU load */
 #define TARGET_FREQUENCY_HZ 1000
-/** @brief Circular buffer capacity - larger = more buffering but more RAM usage */
-#define FRAME_BUFFER_SIZE 32
+/** @brief Circular buffer capacity in packed 8-byte frames - larger = more buffering but more RAM usage */
+#define FRAME_BUFFER_SIZE 64
 /** @brief Buffer fill level to trigger warnings - lower = earlier warnings */
-#define BUFFER_WARNING_THRESHOLD 24
+#define BUFFER_WARNING_THRESHOLD 48
 /** @brief Buffer fill level for critical state - lower = more conservative */
-#define BUFFER_CRITICAL_THRESHOLD 28
+#define BUFFER_CRITICAL_THRESHOLD 56
 /** @brief Max time to wait for frame completion - shorter = faster timeout recovery */
 #define FRAME_TIMEOUT_US 3000
 #else
 /** @brief LiDAR sample rate - lower = less CPU load but reduced temporal resolution */
 #define TARGET_FREQUENCY_HZ 800
 /** @brief Smaller buffer for lower data rates - reduces RAM usage */
-#define FRAME_BUFFER_SIZE 24
+#define FRAME_BUFFER_SIZE 48
 /** @brief Proportionally adjusted warning threshold for smaller buffer */
-#define BUFFER_WARNING_THRESHOLD 18
+#define BUFFER_WARNING_THRESHOLD 36
 /** @brief Proportionally adjusted critical threshold for smaller buffer */
-#define BUFFER_CRITICAL_THRESHOLD 21
+#define BUFFER_CRITICAL_THRESHOLD 42
 /** @brief Shorter timeout for faster frame rate recovery */
 #define FRAME_TIMEOUT_US 2000
 #endif
 
+// Multi-sensor configuration
+/** @brief Number of TF LiDAR sensors serviced by Core 0 (1-4) - each sensor gets its own parser and frame queue */
+#define LIDAR_SENSOR_COUNT 1
+/** @brief Hard upper limit on sensors per board - Serial1, Serial2 and two PIO UARTs */
+#define MAX_LIDAR_SENSORS 4
+
+#if LIDAR_SENSOR_COUNT < 1 || LIDAR_SENSOR_COUNT > MAX_LIDAR_SENSORS
+#error "LIDAR_SENSOR_COUNT must be between 1 and MAX_LIDAR_SENSORS"
+#endif
+
+/** @brief Set to true to require sensors 0 and 1 (aimed at the same zone) to agree before triggering */
+#define ENABLE_DUAL_SENSOR_VOTING false
+
+#if ENABLE_DUAL_SENSOR_VOTING && LIDAR_SENSOR_COUNT < 2
+#error "ENABLE_DUAL_SENSOR_VOTING requires LIDAR_SENSOR_COUNT >= 2"
+#endif
+
 /** @brief UART speed for LiDAR communication - must match sensor setting or communication fails */
 #define LIDAR_BAUD_RATE 460800
 /** @brief USB serial speed for debugging - higher = faster output but may cause data loss */
@@ -66,8 +83,10 @@
 #define FRAME_SYNC_BYTE1 0x59
 /** @brief Second frame synchronization byte - must match LiDAR protocol specification */
 #define FRAME_SYNC_BYTE2 0x59
-/** @brief LittleFS storage path - change to use different filename for config storage */
+/** @brief LittleFS path of the configuration saved by older firmware - only read once, to migrate it to the config store */
 #define CONFIG_FILE_PATH "/lidar_config.dat"
+/** @brief LittleFS path of the runtime globals saved by older firmware - only read once, to migrate them to the config store */
+#define GLOBALS_FILE_PATH "/lidar_globals.dat"
 
 /** @brief Limit recovery attempts before giving up */
 #define MAX_RECOVERY_ATTEMPTS 3
@@ -89,7 +108,7 @@
 #define STATUS_CHECK_INTERVAL_MS 5000
 /** @brief Frequency of performance statistics - longer intervals provide better averaging */
 #define PERFORMANCE_REPORT_INTERVAL_MS 10000
-/** @brief Rate limiting for critical error messages - prevents serial spam during failures */
+/** @brief Minimum interval between frame queue overflow messages - prevents serial spam during failures */
 #define CRITICAL_ERROR_REPORT_INTERVAL_MS 2000
 
 /**
@@ -143,14 +162,137 @@
 #define NEOPIXEL_PIN 18
 /** @} */
 
+/**
+ * @brief Pin definitions for the additional LiDAR sensors (sensor 0 uses Serial1 on GP0/GP1).
+ * @{
+ */
+#define LIDAR2_TX_PIN 4   ///< Sensor 1 on Serial2 (UART1)
+#define LIDAR2_RX_PIN 5
+#define LIDAR3_TX_PIN 2   ///< Sensor 2 on a PIO UART
+#define LIDAR3_RX_PIN 3
+#define LIDAR4_TX_PIN 6   ///< Sensor 3 on a PIO UART
+#define LIDAR4_RX_PIN 7
+/** @} */
+
 // Debug buffer size for optimized output
 #define DEBUG_BUFFER_SIZE 256
 
+// Compile-time logging configuration (see log.h)
+/** @brief No log output */
+#define LOG_LEVEL_NONE 0
+/** @brief Errors and critical warnings only */
+#define LOG_LEVEL_ERROR 1
+/** @brief Errors plus status and performance reports */
+#define LOG_LEVEL_INFO 2
+/** @brief Everything, including output gated by the runtime debug switch */
+#define LOG_LEVEL_DEBUG 3
+/** @brief Default floor for all modules - LOG_LEVEL_INFO compiles out all debug output, LOG_LEVEL_ERROR also the status notices, LOG_LEVEL_NONE everything */
+#define LOG_LEVEL_FLOOR LOG_LEVEL_DEBUG
+/** @brief Per-module floors - lower one to silence a single module at compile time */
+#define LOG_FLOOR_CORE0 LOG_LEVEL_FLOOR
+#define LOG_FLOOR_LIDAR LOG_LEVEL_FLOOR
+#define LOG_FLOOR_CORE1 LOG_LEVEL_FLOOR
+#define LOG_FLOOR_INIT LOG_LEVEL_FLOOR
+#define LOG_FLOOR_STATUS LOG_LEVEL_FLOOR
+#define LOG_FLOOR_STORAGE LOG_LEVEL_FLOOR
+
+// Diagnostic output governor configuration (see diag_governor.h)
+/** @brief Parse error messages per second per core - lower = less USB traffic with a noisy cable */
+#define DIAG_PARSE_RATE_PER_S 5
+/** @brief Parse error messages allowed back to back */
+#define DIAG_PARSE_BURST 10
+/** @brief Average interval between frame timeout messages per sensor - a disconnected sensor times out on every poll */
+#define DIAG_TIMEOUT_INTERVAL_MS 5000
+/** @brief Buffer overflow messages allowed back to back; the sustained rate is one per CRITICAL_ERROR_REPORT_INTERVAL_MS */
+#define DIAG_OVERFLOW_BURST 1
+/** @brief Health and recovery notices per second */
+#define DIAG_HEALTH_RATE_PER_S 1
+#define DIAG_HEALTH_BURST 3
+/** @brief Trigger messages per second */
+#define DIAG_TRIGGER_RATE_PER_S 10
+#define DIAG_TRIGGER_BURST 10
+/** @brief Interval between suppressed-message reports */
+#define DIAG_REPORT_INTERVAL_MS 10000
+/** @brief The GUI counts as active for this long after its last packet */
+#define DIAG_GUI_ACTIVE_MS 1000
+/** @brief USB transmit bytes kept free for GUI packets while the GUI is active */
+#define DIAG_GUI_TX_RESERVE 128
+
+// Trace buffer configuration (see trace.h)
+/** @brief Set to false to compile out all trace points */
+#define ENABLE_TRACE true
+/** @brief Events per core ring (8 bytes each) - larger = longer history but more RAM usage */
+#define TRACE_RING_SIZE 512
+
+// GUI transport configuration (see gui.cpp)
+/** @brief GUI transmit staging buffer in bytes - larger = more packets coalesced per USB write but more RAM (must hold a 1 KiB v2 frame) */
+#define GUI_TX_STAGE_SIZE 1280
+/** @brief Max age of staged streamed packets before they are written - longer = fuller USB packets but more latency */
+#define GUI_TX_FLUSH_US 2000
+
+// Telemetry stream configuration (see telemetry.h)
+/** @brief Max age of a partly filled telemetry packet before it is sent - shorter = lower latency but more, smaller USB packets */
+#define TELEMETRY_FLUSH_MS 20
+
+// Frame recorder configuration (see recorder.h)
+/** @brief Set to false to compile out the flash frame recorder and its RAM pages */
+#define ENABLE_FRAME_RECORDER true
+/** @brief Flash for the frame log, after the config store in the FS region - larger = longer capture (about 2 min per 512 KiB at 1000 Hz); recording stops when it is full */
+#define RECORDER_FLASH_SIZE (512 * 1024)
+/** @brief Encoded 4 KiB pages buffered in RAM while flash writes catch up - more = rides out longer flash pauses but more RAM */
+#define RECORDER_RAM_PAGES 3
+
+// Trigger snapshot configuration (see snapshot.h)
+/** @brief Set to false to compile out trigger snapshots and their RAM slots */
+#define ENABLE_TRIGGER_SNAPSHOTS true
+/** @brief Processed samples kept from before each trigger - more = longer view of the approach but 16 bytes more RAM per slot each */
+#define SNAPSHOT_PRE_FRAMES 256
+/** @brief Processed samples captured after each trigger - more = longer view of the event but 16 bytes more RAM per slot each */
+#define SNAPSHOT_POST_FRAMES 128
+/** @brief Frozen snapshots kept in RAM, newest first - each slot costs about 6 KiB */
+#define SNAPSHOT_RAM_SLOTS 2
+/** @brief Snapshots also kept in flash across resets (0 = RAM only) - each costs two sector erases after the capture, each stalling both cores for about 45 ms */
+#define SNAPSHOT_FLASH_SLOTS 0
+
+// NeoPixel refresh configuration (see neopixel_integration.h)
+/** @brief LED refresh period of the Core 1 timer task - shorter = smoother animations but more interrupt load (10 = 100 Hz) */
+#define NEOPIXEL_REFRESH_INTERVAL_MS 20
+/** @brief Pixels on the NeoPixel output - 1 = single status pixel, more = bar graph strip (see strip_renderer.h) */
+#define NEOPIXEL_PIXEL_COUNT 1
+/** @brief Distance shown at the far end of the strip - shorter = finer resolution near the sensor */
+#define NEOPIXEL_STRIP_RANGE_CM MAX_DISTANCE_CM
+/** @brief Pixels in the velocity comet's tail - longer = more visible but covers more of the bar */
+#define NEOPIXEL_COMET_TAIL 4
+
 // Velocity calculation configuration
 #define VELOCITY_DEADBAND_THRESHOLD_CM_S 1.0f
 #define DISTANCE_DEADBAND_THRESHOLD_CM 1
 #define MPH_TO_CMS 44.704f  // Conversion factor from MPH to cm/s
 
+// Dual-sensor voting configuration
+/** @brief Max timestamp difference for two frames to be paired - wider = more pairs but looser alignment */
+#define FUSION_TIME_WINDOW_US 2000
+/** @brief Max distance difference for paired frames to count as agreeing - smaller = fewer false triggers */
+#define FUSION_DISTANCE_WINDOW_CM 30
+/** @brief A sensor with no frames for this long is degraded and voting falls back to the other sensor */
+#define FUSION_SENSOR_TIMEOUT_MS 250
+
+// Core 1 load scheduler configuration
+/** @brief Frames per sensor per call with an empty queue - the old fixed batch size */
+#define LOAD_MIN_BATCH 5
+/** @brief Upper bound on frames per sensor per call - higher = faster drain but longer Core 1 stalls */
+#define LOAD_MAX_BATCH (FRAME_BUFFER_SIZE / 2)
+/** @brief Queue depth must stay above a threshold this long before the load mode escalates */
+#define LOAD_SUSTAIN_MS 20
+/** @brief Queue depth at or below which the load mode steps back down */
+#define LOAD_RECOVER_THRESHOLD (FRAME_BUFFER_SIZE / 4)
+/** @brief Frames within this distance above a trigger threshold are never decimated */
+#define LOAD_DECIMATE_MARGIN_CM 50
+/** @brief The decimation margin is widened by the distance covered at the current velocity in this time */
+#define LOAD_DECIMATE_LOOKAHEAD_MS 200
+/** @brief While decimating, one in this many far frames still feeds the velocity history */
+#define LOAD_DECIMATE_KEEP_EVERY 4
+
 /**
  * @brief Defines the states for the Core 0 initialization state machine.
  */
@@ -209,7 +351,43 @@ struct LidarFrame {
   uint16_t strength;                    ///< The strength of the LiDAR signal.
   uint16_t temperature;                 ///< The internal temperature of the LiDAR sensor.
   uint32_t timestamp;                   ///< The timestamp of when the frame was received.
-  bool valid;                           ///< Flag indicating if the frame is valid.
+  uint8_t sensor_id;                    ///< Index of the sensor that produced the frame.
+};
+
+/**
+ * @brief Bit layout of PackedLidarFrame::fields.
+ * @{
+ */
+#define PACKED_DISTANCE_BITS 14
+#define PACKED_STRENGTH_BITS 12
+#define PACKED_SENSOR_ID_BITS 2
+#define PACKED_DISTANCE_SHIFT 0
+#define PACKED_STRENGTH_SHIFT (PACKED_DISTANCE_SHIFT + PACKED_DISTANCE_BITS)
+#define PACKED_SENSOR_ID_SHIFT (PACKED_STRENGTH_SHIFT + PACKED_STRENGTH_BITS)
+#define PACKED_DISTANCE_MAX ((1u << PACKED_DISTANCE_BITS) - 1)
+#define PACKED_STRENGTH_MAX ((1u << PACKED_STRENGTH_BITS) - 1)
+/** @} */
+
+/**
+ * @brief Compact 8-byte on-queue form of a LidarFrame.
+ *
+ * @details Distance, strength (saturated to 12 bits) and sensor ID share one word; the
+ * second word is the receive timestamp. Temperature changes slowly and is carried
+ * out of band in `sensor_temperature[]`, refreshed once per second by Core 0.
+ */
+struct PackedLidarFrame {
+  uint32_t fields;                      ///< Distance, strength and sensor ID (see PACKED_* bit layout).
+  uint32_t timestamp;                   ///< micros() when the frame was received.
+};
+
+/**
+ * @brief Circular frame queue owned by a single sensor (Core 0 producer, Core 1 consumer).
+ */
+struct FrameQueue {
+  PackedLidarFrame frames[FRAME_BUFFER_SIZE]; ///< Packed frame storage.
+  volatile uint8_t head;                ///< Index of the next slot to write.
+  volatile uint8_t tail;                ///< Index of the next slot to read.
+  volatile uint8_t count;               ///< Number of frames in the queue.
 };
 
 /**
@@ -266,10 +444,8 @@ struct PerformanceMetrics {
  * @brief Extern declarations for global variables.
  * @{
  */
-extern LidarFrame frame_buffer[FRAME_BUFFER_SIZE];     ///< Shared buffer for LiDAR frames.
-extern volatile uint8_t buffer_head;                   ///< Head index of the circular buffer.
-extern volatile uint8_t buffer_tail;                   ///< Tail index of the circular buffer.
-extern volatile uint8_t buffer_count;                  ///< Number of frames in the buffer.
+extern FrameQueue frame_queues[LIDAR_SENSOR_COUNT];    ///< One frame queue per LiDAR sensor.
+extern volatile uint16_t sensor_temperature[LIDAR_SENSOR_COUNT]; ///< Latest raw temperature of each sensor.
 extern CoreComm core_comm;                             ///< Shared data between cores.
 extern TimingInfo timing_info;                         ///< Timing information for performance monitoring.
 extern PerformanceMetrics perf_metrics;               ///< Performance metrics.
@@ -294,6 +470,8 @@ uint32_t safeMillisElapsed(uint32_t start, uint32_t current);
 void safeSetErrorFlag(uint32_t flag, bool set);
 void safeSerialPrintf(const char* format, ...);
 void safeSerialPrintfln(const char* format, ...);
+void safeSerialPrintln(const char* msg);
+void safeSerialPrint(const char* msg);
 void safeSerialPrintln(const String& msg);
 void safeSerialPrint(const String& msg);
 void safeSetCore1Ready(bool value);
@@ -301,12 +479,18 @@ bool safeGetCore1Ready();
 void safeSetLidarInitialized(bool value);
 void safeIncrementFramesReceived();
 void safeIncrementFramesProcessed();
+void safeAddFramesProcessed(uint32_t count);
 void safeIncrementDroppedFrames();
 bool isDebugEnabled();
 void updateAdaptiveTimeout(uint32_t observed_frame_rate);
+PackedLidarFrame packLidarFrame(const LidarFrame& frame);
+void unpackLidarFrame(const PackedLidarFrame& packed, LidarFrame& frame);
 bool atomicBufferPush(const LidarFrame& frame);
-bool atomicBufferPop(LidarFrame& frame);
-uint8_t getBufferUtilization();
+bool atomicBufferPop(uint8_t sensor_id, LidarFrame& frame);
+uint8_t atomicBufferPopBatch(uint8_t sensor_id, LidarFrame* frames, uint8_t max_frames);
+void flushFrameQueue(uint8_t sensor_id);
+uint8_t getBufferUtilization(uint8_t sensor_id);
+uint8_t getMaxBufferUtilization();
 /** @} */
 
 #endif // GLOBALS_H
\ No newline at end of file
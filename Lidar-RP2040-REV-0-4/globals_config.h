@@ -33,12 +33,16 @@ struct GlobalConfiguration {
   uint32_t debug_output_interval_ms;           ///< Debug output frequency
   uint32_t status_check_interval_ms;           ///< Status report frequency
   uint32_t performance_report_interval_ms;     ///< Performance statistics frequency
-  uint32_t critical_error_report_interval_ms;  ///< Critical error message rate limiting
+  uint32_t critical_error_report_interval_ms;  ///< Minimum interval between queue overflow messages
 
   // Signal processing
   uint32_t distance_deadband_threshold_cm;  ///< Distance noise filtering threshold
   float velocity_deadband_threshold_cm_s;   ///< Velocity noise filtering threshold
 
+  // Dual-sensor voting
+  uint32_t fusion_time_window_us;      ///< Max timestamp difference for paired frames
+  uint32_t fusion_distance_window_cm;  ///< Max distance difference for agreeing frames
+
   uint16_t checksum;  ///< Checksum for validation
 };
 
@@ -53,9 +57,6 @@ extern GlobalConfiguration runtimeGlobals;
 void loadDefaultGlobals();
 bool validateGlobalConfiguration(const GlobalConfiguration& config);
 uint16_t calculateGlobalsChecksum(const GlobalConfiguration& config);
-void loadGlobalConfiguration();
-bool saveGlobalConfiguration();
-void factoryResetGlobals();
 
 // Accessor macros for runtime globals (safe parameters only)
 #define RUNTIME_CONFIG_MODE_TIMEOUT_MS (runtimeGlobals.config_mode_timeout_ms)
@@ -72,5 +73,7 @@ void factoryResetGlobals();
 #define RUNTIME_CRITICAL_ERROR_REPORT_INTERVAL_MS (runtimeGlobals.critical_error_report_interval_ms)
 #define RUNTIME_DISTANCE_DEADBAND_THRESHOLD_CM (runtimeGlobals.distance_deadband_threshold_cm)
 #define RUNTIME_VELOCITY_DEADBAND_THRESHOLD_CM_S (runtimeGlobals.velocity_deadband_threshold_cm_s)
+#define RUNTIME_FUSION_TIME_WINDOW_US (runtimeGlobals.fusion_time_window_us)
+#define RUNTIME_FUSION_DISTANCE_WINDOW_CM (runtimeGlobals.fusion_distance_window_cm)
 
 #endif  // GLOBALS_CONFIG_H
\ No newline at end of file
@@ -12,17 +12,45 @@
  */
 
 #include "gui.h"
+#include "gui_tx.h"
 #include "globals.h"
 #include "storage.h"
+#include "config_store.h"
 #include "globals_config.h"  // NEW: Include globals configuration
 #include "neopixel_integration.h"
+#include "diag_governor.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "crc.h"
+#include "param_registry.h"
+#include "recorder.h"
+#include "snapshot.h"
+#include "binlog.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
 
 /** @brief The start byte for a GUI packet. */
 #define GUI_PACKET_START_BYTE 0x7E
 /** @brief The maximum size of the payload in a GUI packet. */
 #define GUI_MAX_PAYLOAD_SIZE 64
+/** @brief Delimiter before and after every protocol v2 frame. */
+#define GUI_V2_DELIMITER 0x00
+/** @brief The maximum size of the payload in a protocol v2 frame. */
+#define GUI_V2_MAX_PAYLOAD_SIZE 1024
+/** @brief Decoded v2 frame size around the payload: sequence ID, command and CRC16. */
+#define GUI_V2_OVERHEAD 4
+/** @brief The maximum size of a decoded v2 frame. */
+#define GUI_V2_MAX_FRAME_SIZE (GUI_V2_MAX_PAYLOAD_SIZE + GUI_V2_OVERHEAD)
+/** @brief The maximum size of a COBS-encoded v2 frame, without delimiters. */
+#define GUI_V2_MAX_ENCODED_SIZE (GUI_V2_MAX_FRAME_SIZE + GUI_V2_MAX_FRAME_SIZE / 254 + 1)
+/** @brief Requests a v2 host may keep outstanding; they are executed strictly in order, but save ACKs wait for the flash commit. */
+#define GUI_V2_WINDOW 8
+/** @brief Bytes taken from the USB receive buffer per readBytes() call. */
+#define GUI_RX_CHUNK_SIZE 64
 /** @brief The timeout in milliseconds for receiving a complete GUI packet. */
 #define GUI_PACKET_TIMEOUT_MS 100
+/** @brief Time the host gets to read the ACK of 'R' or 'F' before the restart, in milliseconds. */
+#define GUI_RESTART_GRACE_MS 100
 /** @brief The response code for a successful acknowledgment (ACK). */
 #define RSP_ACK 0x06
 /** @brief The response code for a negative acknowledgment (NAK). */
@@ -39,6 +67,41 @@
 #define NAK_ERR_EXECUTION_FAIL 0x04
 /** @brief Timeout error. */
 #define NAK_ERR_TIMEOUT 0x05
+/** @brief Command not available in the current system state. */
+#define NAK_ERR_WRONG_STATE 0x06
+
+/** @brief Bulk read response header: offset (2), total size (2), CRC-32 (4). */
+#define BULK_READ_HEADER_SIZE 8
+/** @brief Bulk write operation: start a transfer [op, size (2), CRC-32 (4)]. */
+#define BULK_OP_BEGIN 0
+/** @brief Bulk write operation: one chunk [op, offset (2), data...]. */
+#define BULK_OP_DATA 1
+/** @brief Bulk write operation: check and apply [op, save to flash (0/1)]. */
+#define BULK_OP_COMMIT 2
+/** @brief Parameter discovery response header: total, first index, count. */
+#define PARAM_DISCOVER_HEADER_SIZE 3
+/** @brief Parameter descriptor size without its name: id, type, flags, min, max, default, name length. */
+#define PARAM_DESCRIPTOR_FIXED_SIZE 16
+/** @brief One parameter in a get response or set request: id, value (4). */
+#define PARAM_ENTRY_SIZE 5
+/** @brief Recorder operation: counters and log geometry [op]. */
+#define RECORDER_OP_INFO 0
+/** @brief Recorder operation: read part of a sector [op, sector (2), offset (2)]. */
+#define RECORDER_OP_READ 1
+/** @brief Recorder operation: erase the whole log in the background [op]. */
+#define RECORDER_OP_ERASE 2
+/** @brief Recorder read response header: sector (2), offset (2). */
+#define RECORDER_READ_HEADER_SIZE 4
+/** @brief Snapshot operation: counters and record geometry [op]. */
+#define SNAPSHOT_OP_INFO 0
+/** @brief Snapshot operation: read part of a record [op, source (0 RAM, 1 flash), index, offset (2)]. */
+#define SNAPSHOT_OP_READ 1
+/** @brief Snapshot read response header: source, index, offset (2). */
+#define SNAPSHOT_READ_HEADER_SIZE 4
+/** @brief Snapshot operation: read part of a RAM record by number [op, sequence (4), offset (2)]. */
+#define SNAPSHOT_OP_READ_SEQUENCE 2
+/** @brief Snapshot read-by-number response header: sequence (4), offset (2). */
+#define SNAPSHOT_READ_SEQUENCE_HEADER_SIZE 6
 
 /**
  * @brief Defines the states for the GUI packet parser state machine.
@@ -48,19 +111,48 @@ enum GuiParserState {
   STATE_READ_CMD,           ///< Reading the command byte.
   STATE_READ_LEN,           ///< Reading the payload length byte.
   STATE_READ_PAYLOAD,       ///< Reading the payload data.
-  STATE_READ_CHECKSUM       ///< Reading the checksum byte.
+  STATE_READ_CHECKSUM,      ///< Reading the checksum byte.
+  STATE_READ_V2_FRAME,      ///< Collecting a COBS-encoded v2 frame up to its delimiter.
+  STATE_SKIP_V2_FRAME       ///< Discarding an oversized v2 frame up to its delimiter.
 };
 
 /**
  * @brief Represents a GUI packet.
  */
 struct GuiPacket {
-  uint8_t cmd;                           ///< The command byte.
-  uint8_t len;                           ///< The length of the payload.
-  uint8_t payload[GUI_MAX_PAYLOAD_SIZE]; ///< The payload data.
-  uint8_t checksum;                      ///< The checksum of the packet.
+  uint8_t cmd;                              ///< The command byte.
+  uint16_t len;                             ///< The length of the payload.
+  uint8_t payload[GUI_V2_MAX_PAYLOAD_SIZE]; ///< The payload data.
+  uint8_t checksum;                         ///< The checksum of the packet (v1 only).
 };
 
+/** @brief Framing and sequence ID for responses to the request being executed. */
+static GuiReplyTarget gui_reply_target = { GUI_PROTOCOL_V1, 0 };
+/** @brief Framed response being written. Responses are only sent from Core 1. */
+static uint8_t gui_tx_buffer[GUI_V2_MAX_ENCODED_SIZE + 2];
+
+static_assert(GUI_TX_STAGE_SIZE >= GUI_V2_MAX_ENCODED_SIZE + 2, "GUI_TX_STAGE_SIZE must hold the largest v2 frame");
+
+/** @brief Scratch payload for responses that are built in place. */
+static uint8_t gui_response_payload[GUI_V2_MAX_PAYLOAD_SIZE];
+
+/**
+ * @brief A save request whose ACK is sent once its configuration store commit completes.
+ */
+struct CommitWaiter {
+  GuiReplyTarget target;  ///< Framing and sequence ID of the request.
+  uint8_t cmd;            ///< Command to acknowledge.
+  uint32_t ticket;        ///< Config store ticket of the save.
+};
+
+/** @brief Saves waiting for their commit, oldest first; a v2 host cannot have more outstanding. */
+static CommitWaiter commit_waiters[GUI_V2_WINDOW];
+static uint8_t commit_waiter_count = 0;
+/** @brief True once 'R' or 'F' has asked for a restart. */
+static bool restart_pending = false;
+/** @brief millis() when the restart was asked for. */
+static uint32_t restart_requested_ms = 0;
+
 /**
  * @brief Calculates the checksum for a GUI packet.
  * @param data A pointer to the data to be checksummed.
@@ -76,13 +168,14 @@ uint8_t calculateGuiChecksum(const uint8_t* data, uint8_t length) {
 }
 
 /**
- * @brief Sends a response packet to the GUI.
+ * @brief Frames a protocol v1 packet for the GUI.
+ * @param buffer The output buffer, at least len + 4 bytes.
  * @param cmd The command byte of the response.
  * @param payload A pointer to the payload data.
- * @param len The length of the payload.
+ * @param len The length of the payload (at most GUI_MAX_PAYLOAD_SIZE).
+ * @return The size of the framed packet.
  */
-void sendResponsePacket(uint8_t cmd, const uint8_t* payload, uint8_t len) {
-  uint8_t buffer[GUI_MAX_PAYLOAD_SIZE + 4];
+static uint16_t buildResponsePacket(uint8_t* buffer, uint8_t cmd, const uint8_t* payload, uint8_t len) {
   buffer[0] = GUI_PACKET_START_BYTE;
   buffer[1] = cmd;
   buffer[2] = len;
@@ -91,7 +184,134 @@ void sendResponsePacket(uint8_t cmd, const uint8_t* payload, uint8_t len) {
   }
   uint8_t checksum = calculateGuiChecksum(&buffer[1], len + 2);
   buffer[len + 3] = checksum;
-  Serial.write(buffer, len + 4);
+  return len + 4;
+}
+
+/**
+ * @brief COBS-encodes a byte stream into a buffer one byte at a time.
+ */
+struct CobsEncoder {
+  uint8_t* out;       ///< Output buffer.
+  uint16_t code_pos;  ///< Position of the current block's code byte.
+  uint16_t pos;       ///< Next output position.
+
+  explicit CobsEncoder(uint8_t* buffer) : out(buffer), code_pos(0), pos(1) {}
+
+  void put(uint8_t byte) {
+    if (byte != 0) out[pos++] = byte;
+    if (byte == 0 || pos - code_pos == 0xFF) {
+      out[code_pos] = pos - code_pos;
+      code_pos = pos++;
+    }
+  }
+
+  void put(const uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) put(data[i]);
+  }
+
+  uint16_t finish() {
+    out[code_pos] = pos - code_pos;
+    return pos;
+  }
+};
+
+/**
+ * @brief Frames a protocol v2 packet for the GUI.
+ * @param buffer The output buffer, at least GUI_V2_MAX_ENCODED_SIZE + 2 bytes.
+ * @param sequence The sequence ID to echo.
+ * @param cmd The command byte of the response.
+ * @param payload A pointer to the payload data.
+ * @param len The length of the payload (at most GUI_V2_MAX_PAYLOAD_SIZE).
+ * @return The size of the framed packet, including both delimiters.
+ */
+static uint16_t buildResponsePacketV2(uint8_t* buffer, uint8_t sequence, uint8_t cmd, const uint8_t* payload, uint16_t len) {
+  uint8_t header[2] = { sequence, cmd };
+  uint16_t crc = crc16Update(crc16(header, 2), payload, len);
+  uint8_t trailer[2] = { (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8) };
+
+  buffer[0] = GUI_V2_DELIMITER;
+  CobsEncoder encoder(&buffer[1]);
+  encoder.put(header, 2);
+  if (payload) encoder.put(payload, len);
+  encoder.put(trailer, 2);
+  uint16_t size = 1 + encoder.finish();
+  buffer[size++] = GUI_V2_DELIMITER;
+  return size;
+}
+
+/**
+ * @brief Frames a packet for a reply target into gui_tx_buffer.
+ * @param target The framing and sequence ID to use.
+ * @param cmd The command byte.
+ * @param payload A pointer to the payload data.
+ * @param len The length of the payload.
+ * @return The size of the framed packet.
+ */
+static uint16_t framePacket(const GuiReplyTarget& target, uint8_t cmd, const uint8_t* payload, uint16_t len) {
+  if (target.protocol == GUI_PROTOCOL_V2) {
+    return buildResponsePacketV2(gui_tx_buffer, target.sequence, cmd, payload, min(len, (uint16_t)GUI_V2_MAX_PAYLOAD_SIZE));
+  }
+  return buildResponsePacket(gui_tx_buffer, cmd, payload, min(len, (uint16_t)GUI_MAX_PAYLOAD_SIZE));
+}
+
+/**
+ * @brief Gets the reply target of the request being executed.
+ * @return The framing and sequence ID of the current request (v1 outside a request).
+ */
+GuiReplyTarget guiCurrentReplyTarget() {
+  return gui_reply_target;
+}
+
+/**
+ * @brief Gets the largest response payload the current request's framing can carry.
+ * @return The maximum payload size in bytes.
+ */
+static uint16_t guiMaxResponsePayload() {
+  return (gui_reply_target.protocol == GUI_PROTOCOL_V2) ? GUI_V2_MAX_PAYLOAD_SIZE : GUI_MAX_PAYLOAD_SIZE;
+}
+
+/**
+ * @brief Sends a response packet to the GUI for an earlier request.
+ * @param target The framing and sequence ID of that request.
+ * @param cmd The command byte of the response.
+ * @param payload A pointer to the payload data.
+ * @param len The length of the payload.
+ */
+static void sendResponsePacketTo(const GuiReplyTarget& target, uint8_t cmd, const uint8_t* payload, uint16_t len) {
+  uint16_t size = framePacket(target, cmd, payload, len);
+  guiTxStage(gui_tx_buffer, size, true, true);
+}
+
+/**
+ * @brief Sends a response packet to the GUI in the framing of the current request.
+ *
+ * @details The packet is staged and written at the end of the current receive
+ * pass, together with the responses to any other requests in the same pass.
+ *
+ * @param cmd The command byte of the response.
+ * @param payload A pointer to the payload data.
+ * @param len The length of the payload.
+ */
+void sendResponsePacket(uint8_t cmd, const uint8_t* payload, uint16_t len) {
+  sendResponsePacketTo(gui_reply_target, cmd, payload, len);
+}
+
+/**
+ * @brief Sends a packet to the GUI only if it can be written without blocking.
+ *
+ * @details Used for streamed data. The packet is staged and coalesced with
+ * others. Gives up if the stage is full and cannot be flushed without waiting
+ * for the serial mutex or the USB transmit buffer.
+ *
+ * @param target The framing and sequence ID to use.
+ * @param cmd The command byte of the packet.
+ * @param payload A pointer to the payload data.
+ * @param len The length of the payload.
+ * @return True if the packet was accepted.
+ */
+bool trySendResponsePacket(const GuiReplyTarget& target, uint8_t cmd, const uint8_t* payload, uint16_t len) {
+  uint16_t size = framePacket(target, cmd, payload, len);
+  return guiTxStage(gui_tx_buffer, size, false, false);
 }
 
 /**
@@ -110,12 +330,427 @@ void sendNak(uint8_t error_code) {
   sendResponsePacket(RSP_NAK, &error_code, 1);
 }
 
+/**
+ * @brief Acknowledges a save request once its configuration store commit completes.
+ *
+ * @details The request's reply target is kept, so other requests are
+ * answered in the meantime; a v2 host matches the late ACK by its sequence ID.
+ *
+ * @param cmd The command to acknowledge.
+ * @param ticket The ticket returned by saveConfiguration(); 0 NAKs at once.
+ */
+static void ackOnCommit(uint8_t cmd, uint32_t ticket) {
+  if (ticket == 0 || commit_waiter_count == GUI_V2_WINDOW) {
+    sendNak(NAK_ERR_EXECUTION_FAIL);
+    return;
+  }
+  commit_waiters[commit_waiter_count++] = { gui_reply_target, cmd, ticket };
+}
+
+/**
+ * @brief Answers the save requests whose commits have completed, oldest first.
+ */
+static void serviceCommitWaiters() {
+  while (commit_waiter_count > 0) {
+    const CommitWaiter& waiter = commit_waiters[0];
+    ConfigCommitStatus status = configStoreCommitStatus(waiter.ticket);
+    if (status == CONFIG_COMMIT_PENDING) return;
+    if (status == CONFIG_COMMIT_DONE) {
+      sendResponsePacketTo(waiter.target, RSP_ACK, &waiter.cmd, 1);
+      triggerGuiSuccessGlow();
+    } else {
+      uint8_t error_code = NAK_ERR_EXECUTION_FAIL;
+      sendResponsePacketTo(waiter.target, RSP_NAK, &error_code, 1);
+    }
+    commit_waiter_count--;
+    memmove(&commit_waiters[0], &commit_waiters[1], commit_waiter_count * sizeof(CommitWaiter));
+  }
+}
+
+/**
+ * @brief Restarts the device once it is safe to.
+ *
+ * @details Waits until queued configuration store work has completed, the
+ * ACK has been written and GUI_RESTART_GRACE_MS have passed for the host to
+ * read it. The Core 1 loop keeps running meanwhile.
+ */
+static void serviceRestart() {
+  if (!restart_pending || configStoreBusy() || !guiTxEmpty()) return;
+  if (safeMillisElapsed(restart_requested_ms, millis()) < GUI_RESTART_GRACE_MS) return;
+  rp2040.restart();
+}
+
+/**
+ * @brief State of the bulk configuration transfers. Both run on Core 1 only.
+ */
+struct BulkTransfer {
+  ConfigImage image;      ///< Snapshot being read, or image being received.
+  uint32_t crc;           ///< CRC-32 of the snapshot, or the CRC announced by the host.
+  uint16_t received;      ///< Bytes received so far (write only).
+  bool open;              ///< True between BULK_OP_BEGIN and BULK_OP_COMMIT (write only).
+};
+
+static BulkTransfer bulk_read;
+static BulkTransfer bulk_write;
+
+/**
+ * @brief Sends one chunk of the configuration image ('B' command).
+ *
+ * @details Offset 0 takes a new snapshot, so all chunks of one read come from
+ * the same configuration even if it changes in between.
+ *
+ * @param offset The byte offset of the chunk.
+ */
+static void sendBulkReadChunk(uint16_t offset) {
+  if (offset == 0) {
+    buildConfigImage(bulk_read.image);
+    bulk_read.crc = crc32((const uint8_t*)&bulk_read.image, sizeof(ConfigImage));
+  }
+  if (offset > sizeof(ConfigImage)) {
+    sendNak(NAK_ERR_INVALID_PAYLOAD);
+    return;
+  }
+
+  uint8_t* payload = gui_response_payload;
+  uint16_t total = sizeof(ConfigImage);
+  uint16_t chunk = min((uint16_t)(total - offset), (uint16_t)(guiMaxResponsePayload() - BULK_READ_HEADER_SIZE));
+  memcpy(&payload[0], &offset, 2);
+  memcpy(&payload[2], &total, 2);
+  memcpy(&payload[4], &bulk_read.crc, 4);
+  memcpy(&payload[BULK_READ_HEADER_SIZE], (const uint8_t*)&bulk_read.image + offset, chunk);
+  sendResponsePacket('B', payload, BULK_READ_HEADER_SIZE + chunk);
+}
+
+/**
+ * @brief Handles one step of a bulk configuration write ('b' command).
+ *
+ * @details Chunks must arrive in order. Nothing is applied until the commit
+ * finds the whole image present and its CRC-32 matching; any error abandons
+ * the transfer.
+ *
+ * @param packet The GUI packet.
+ */
+static void handleBulkWrite(const GuiPacket& packet) {
+  uint8_t op = packet.len > 0 ? packet.payload[0] : 0xFF;
+
+  if (op == BULK_OP_BEGIN && packet.len == 7) {
+    uint16_t total;
+    memcpy(&total, &packet.payload[1], 2);
+    memcpy(&bulk_write.crc, &packet.payload[3], 4);
+    bulk_write.open = (total == sizeof(ConfigImage));
+    bulk_write.received = 0;
+    if (bulk_write.open) sendAck('b');
+    else sendNak(NAK_ERR_INVALID_PAYLOAD);
+    return;
+  }
+
+  if (op == BULK_OP_DATA && packet.len > 3 && bulk_write.open) {
+    uint16_t offset;
+    memcpy(&offset, &packet.payload[1], 2);
+    uint16_t chunk = packet.len - 3;
+    if (offset == bulk_write.received && offset + chunk <= sizeof(ConfigImage)) {
+      memcpy((uint8_t*)&bulk_write.image + offset, &packet.payload[3], chunk);
+      bulk_write.received += chunk;
+      sendAck('b');
+    } else {
+      bulk_write.open = false;
+      sendNak(NAK_ERR_INVALID_PAYLOAD);
+    }
+    return;
+  }
+
+  if (op == BULK_OP_COMMIT && packet.len == 2 && bulk_write.open) {
+    bulk_write.open = false;
+    if (bulk_write.received != sizeof(ConfigImage) ||
+        crc32((const uint8_t*)&bulk_write.image, sizeof(ConfigImage)) != bulk_write.crc) {
+      sendNak(NAK_ERR_BAD_CHECKSUM);
+    } else if (!applyConfigImage(bulk_write.image)) {
+      sendNak(NAK_ERR_EXECUTION_FAIL);
+    } else if (packet.payload[1]) {
+      ackOnCommit('b', saveConfiguration());
+    } else {
+      sendAck('b');
+      triggerGuiSuccessGlow();
+    }
+    return;
+  }
+
+  bulk_write.open = false;
+  sendNak(NAK_ERR_INVALID_PAYLOAD);
+}
+
+/**
+ * @brief Gets the size of the fixed 'L'/'l' parameter block.
+ * @return 4 bytes per parameter flagged PARAM_FLAG_LEGACY_BLOCK.
+ */
+static uint16_t legacyParamBlockSize() {
+  uint16_t size = 0;
+  for (uint8_t i = 0; i < paramCount(); i++) {
+    if (paramAt(i).flags & PARAM_FLAG_LEGACY_BLOCK) size += 4;
+  }
+  return size;
+}
+
+/**
+ * @brief Sends parameter descriptors for discovery ('Q' command).
+ *
+ * @details Response: [total, first index, count, descriptors...], each descriptor
+ * being [id, type, flags, min (4), max (4), default (4), name length, name].
+ * As many descriptors as fit in one response are sent; the host asks again
+ * from the next index until it has all of them.
+ *
+ * @param first The table index of the first descriptor to send.
+ */
+static void sendParamDescriptors(uint8_t first) {
+  if (first > paramCount()) {
+    sendNak(NAK_ERR_INVALID_PAYLOAD);
+    return;
+  }
+
+  uint8_t* payload = gui_response_payload;
+  uint16_t idx = PARAM_DISCOVER_HEADER_SIZE;
+  uint8_t count = 0;
+  for (uint8_t i = first; i < paramCount(); i++) {
+    const ParamDescriptor& param = paramAt(i);
+    uint8_t name_len = strlen(param.name);
+    if (idx + PARAM_DESCRIPTOR_FIXED_SIZE + name_len > guiMaxResponsePayload()) break;
+    payload[idx++] = param.id;
+    payload[idx++] = param.type;
+    payload[idx++] = param.flags;
+    memcpy(&payload[idx], &param.min, 4); idx += 4;
+    memcpy(&payload[idx], &param.max, 4); idx += 4;
+    memcpy(&payload[idx], &param.def, 4); idx += 4;
+    payload[idx++] = name_len;
+    memcpy(&payload[idx], param.name, name_len); idx += name_len;
+    count++;
+  }
+  payload[0] = paramCount();
+  payload[1] = first;
+  payload[2] = count;
+  sendResponsePacket('Q', payload, idx);
+}
+
+/**
+ * @brief Sends parameter values by ID ('K' command).
+ *
+ * @details Request: [id, id, ...], or empty for every parameter that fits in
+ * one response. Response: [id, value (4)] per parameter, in request order.
+ *
+ * @param packet The GUI packet.
+ */
+static void sendParamValues(const GuiPacket& packet) {
+  uint8_t* payload = gui_response_payload;
+  uint16_t idx = 0;
+  uint16_t requested = packet.len > 0 ? packet.len : paramCount();
+  if (requested * PARAM_ENTRY_SIZE > guiMaxResponsePayload()) requested = guiMaxResponsePayload() / PARAM_ENTRY_SIZE;
+  if (packet.len > requested) {
+    sendNak(NAK_ERR_INVALID_PAYLOAD);
+    return;
+  }
+
+  for (uint16_t i = 0; i < requested; i++) {
+    const ParamDescriptor* param = packet.len > 0 ? paramFind(packet.payload[i]) : &paramAt(i);
+    if (param == nullptr) {
+      sendNak(NAK_ERR_INVALID_PAYLOAD);
+      return;
+    }
+    ParamValue value = paramGet(runtimeGlobals, *param);
+    payload[idx++] = param->id;
+    memcpy(&payload[idx], &value, 4); idx += 4;
+  }
+  sendResponsePacket('K', payload, idx);
+}
+
+/**
+ * @brief Sets a batch of parameters by ID ('k' command).
+ *
+ * @details Request: [id, value (4)] per parameter. The batch is applied to a
+ * copy and only takes effect if every ID is known and every value is in
+ * range, so a rejected batch changes nothing.
+ *
+ * @param packet The GUI packet.
+ */
+static void setParamValues(const GuiPacket& packet) {
+  if (packet.len == 0 || packet.len % PARAM_ENTRY_SIZE != 0) {
+    sendNak(NAK_ERR_INVALID_PAYLOAD);
+    return;
+  }
+
+  GlobalConfiguration updated = runtimeGlobals;
+  for (uint16_t idx = 0; idx < packet.len; idx += PARAM_ENTRY_SIZE) {
+    const ParamDescriptor* param = paramFind(packet.payload[idx]);
+    ParamValue value;
+    memcpy(&value, &packet.payload[idx + 1], 4);
+    if (param == nullptr || !paramInRange(*param, value)) {
+      sendNak(NAK_ERR_INVALID_PAYLOAD);
+      return;
+    }
+    paramSet(updated, *param, value);
+  }
+
+  runtimeGlobals = updated;
+  sendAck('k');
+  triggerGuiSuccessGlow();
+}
+
+#if ENABLE_FRAME_RECORDER
+/**
+ * @brief Handles the frame recorder commands ('H').
+ *
+ * @details Info returns [sector count (2), newest sector (2, 0xFFFF = empty),
+ * sector size (2), busy, frames recorded (4), frames dropped (4), encoded
+ * bytes (4), sectors written (4), sectors erased (4), frames missed (4), log
+ * full]. Read returns
+ * [sector (2), offset (2), bytes...] straight from flash; the host orders the
+ * sectors by the sequence number in their headers. Erase clears the log and
+ * re-arms recording; like the other recorder commands it is config-mode only.
+ *
+ * @param packet The GUI packet.
+ */
+static void handleRecorderCommand(const GuiPacket& packet) {
+  uint8_t op = packet.len > 0 ? packet.payload[0] : 0xFF;
+
+  if (op == RECORDER_OP_INFO && packet.len == 1) {
+    const RecorderStats& stats = recorderGetStats();
+    uint16_t sectors = recorderSectorCount();
+    uint16_t newest = recorderNewestSector();
+    uint16_t sector_size = FLASH_SECTOR_SIZE;
+    uint8_t payload[32];
+    memcpy(&payload[0], &sectors, 2);
+    memcpy(&payload[2], &newest, 2);
+    memcpy(&payload[4], &sector_size, 2);
+    payload[6] = recorderBusy() ? 1 : 0;
+    memcpy(&payload[7], &stats.frames_recorded, 4);
+    memcpy(&payload[11], &stats.frames_dropped, 4);
+    memcpy(&payload[15], &stats.encoded_bytes, 4);
+    memcpy(&payload[19], &stats.sectors_written, 4);
+    memcpy(&payload[23], &stats.sectors_erased, 4);
+    memcpy(&payload[27], &stats.frames_missed, 4);
+    payload[31] = recorderLogFull() ? 1 : 0;
+    sendResponsePacket('H', payload, sizeof(payload));
+    return;
+  }
+
+  if (op == RECORDER_OP_READ && packet.len == 5) {
+    uint16_t sector, offset;
+    memcpy(&sector, &packet.payload[1], 2);
+    memcpy(&offset, &packet.payload[3], 2);
+    if (sector >= recorderSectorCount() || offset > FLASH_SECTOR_SIZE) {
+      sendNak(NAK_ERR_INVALID_PAYLOAD);
+      return;
+    }
+    uint8_t* payload = gui_response_payload;
+    uint16_t chunk = min((uint16_t)(FLASH_SECTOR_SIZE - offset), (uint16_t)(guiMaxResponsePayload() - RECORDER_READ_HEADER_SIZE));
+    memcpy(&payload[0], &sector, 2);
+    memcpy(&payload[2], &offset, 2);
+    memcpy(&payload[RECORDER_READ_HEADER_SIZE], recorderSectorData(sector) + offset, chunk);
+    sendResponsePacket('H', payload, RECORDER_READ_HEADER_SIZE + chunk);
+    return;
+  }
+
+  if (op == RECORDER_OP_ERASE && packet.len == 1) {
+    recorderEraseLog();
+    sendAck('H');
+    return;
+  }
+
+  sendNak(NAK_ERR_INVALID_PAYLOAD);
+}
+#endif
+
+#if ENABLE_TRIGGER_SNAPSHOTS
+/**
+ * @brief Handles the trigger snapshot commands ('N').
+ *
+ * @details Info returns [RAM snapshots, flash slots, capturing, record size (2),
+ * pre-trigger samples (2), post-trigger samples (2), captured (4), merged (4),
+ * persisted (4), persist aborted (4)]. Read returns [source, index, offset (2),
+ * bytes...] of a SnapshotRecord; RAM index 0 is the newest snapshot, and a
+ * missing snapshot is refused. A freeze while running moves the RAM indices,
+ * so after the first piece a RAM record is read by its number, which returns
+ * [sequence (4), offset (2), bytes...] and is refused once that snapshot has
+ * left RAM. All are read-only and allowed while running.
+ *
+ * @param packet The GUI packet.
+ */
+static void handleSnapshotCommand(const GuiPacket& packet) {
+  uint8_t op = packet.len > 0 ? packet.payload[0] : 0xFF;
+
+  if (op == SNAPSHOT_OP_INFO && packet.len == 1) {
+    const SnapshotStats& stats = snapshotGetStats();
+    uint16_t record_size = sizeof(SnapshotRecord);
+    uint16_t pre = SNAPSHOT_PRE_FRAMES;
+    uint16_t post = SNAPSHOT_POST_FRAMES;
+    uint8_t payload[25];
+    payload[0] = snapshotRamCount();
+    payload[1] = snapshotFlashSlots();
+    payload[2] = snapshotCapturing() ? 1 : 0;
+    memcpy(&payload[3], &record_size, 2);
+    memcpy(&payload[5], &pre, 2);
+    memcpy(&payload[7], &post, 2);
+    memcpy(&payload[9], &stats.captured, 4);
+    memcpy(&payload[13], &stats.merged, 4);
+    memcpy(&payload[17], &stats.persisted, 4);
+    memcpy(&payload[21], &stats.persist_aborted, 4);
+    sendResponsePacket('N', payload, sizeof(payload));
+    return;
+  }
+
+  if (op == SNAPSHOT_OP_READ && packet.len == 5) {
+    uint8_t source = packet.payload[1];
+    uint8_t index = packet.payload[2];
+    uint16_t offset;
+    memcpy(&offset, &packet.payload[3], 2);
+    const SnapshotRecord* record = source == 0 ? snapshotRam(index) : source == 1 ? snapshotFlash(index) : nullptr;
+    if (record == nullptr || offset > sizeof(SnapshotRecord)) {
+      sendNak(NAK_ERR_INVALID_PAYLOAD);
+      return;
+    }
+    uint8_t* payload = gui_response_payload;
+    uint16_t chunk = min((uint16_t)(sizeof(SnapshotRecord) - offset), (uint16_t)(guiMaxResponsePayload() - SNAPSHOT_READ_HEADER_SIZE));
+    payload[0] = source;
+    payload[1] = index;
+    memcpy(&payload[2], &offset, 2);
+    memcpy(&payload[SNAPSHOT_READ_HEADER_SIZE], (const uint8_t*)record + offset, chunk);
+    sendResponsePacket('N', payload, SNAPSHOT_READ_HEADER_SIZE + chunk);
+    return;
+  }
+
+  if (op == SNAPSHOT_OP_READ_SEQUENCE && packet.len == 7) {
+    uint32_t sequence;
+    uint16_t offset;
+    memcpy(&sequence, &packet.payload[1], 4);
+    memcpy(&offset, &packet.payload[5], 2);
+    const SnapshotRecord* record = snapshotRamBySequence(sequence);
+    if (record == nullptr || offset > sizeof(SnapshotRecord)) {
+      sendNak(NAK_ERR_INVALID_PAYLOAD);
+      return;
+    }
+    uint8_t* payload = gui_response_payload;
+    uint16_t chunk = min((uint16_t)(sizeof(SnapshotRecord) - offset), (uint16_t)(guiMaxResponsePayload() - SNAPSHOT_READ_SEQUENCE_HEADER_SIZE));
+    memcpy(&payload[0], &sequence, 4);
+    memcpy(&payload[4], &offset, 2);
+    memcpy(&payload[SNAPSHOT_READ_SEQUENCE_HEADER_SIZE], (const uint8_t*)record + offset, chunk);
+    sendResponsePacket('N', payload, SNAPSHOT_READ_SEQUENCE_HEADER_SIZE + chunk);
+    return;
+  }
+
+  sendNak(NAK_ERR_INVALID_PAYLOAD);
+}
+#endif
+
 /**
  * @brief Executes a GUI command.
  * @param packet The GUI packet containing the command and payload.
  */
 void executeGuiCommand(const GuiPacket& packet) {
-  safeSerialPrintfln("Core 1: Executing GUI command: 0x%02X", packet.cmd);
+  // While running, only status, protocol info, parameter reads, the telemetry stream, trace dumps and snapshot reads are available
+  if (current_state != STATE_CONFIG && strchr("SYPQKXN", packet.cmd) == nullptr) {
+    sendNak(NAK_ERR_WRONG_STATE);
+    return;
+  }
+  // Deferred through the binary log: most of these commands also run in the frame loop
+  if (LOG_DEBUG_ENABLED()) binlog(BLOG_GUI_COMMAND, packet.cmd);
   switch (packet.cmd) {
     case 'S': {
         uint8_t payload[9];
@@ -155,10 +790,8 @@ void executeGuiCommand(const GuiPacket& packet) {
         break;
     }
     case 'W': {
-        if (saveConfiguration()) {
-          sendAck('W');
-          triggerGuiSuccessGlow();
-        } else sendNak(NAK_ERR_EXECUTION_FAIL);
+        // ACKed when the configuration store commit completes
+        ackOnCommit('W', saveConfiguration());
         break;
     }
     case 'w': {
@@ -227,155 +860,348 @@ void executeGuiCommand(const GuiPacket& packet) {
     }
     // NEW: Global configuration commands
     case 'L': {
-        // Read globals response (safe parameters only)
-        uint8_t payload[56]; // Size for safe global parameters (13 ints * 4 + 1 float * 4)
-        uint8_t idx = 0;
-        
-        // Integers (4 bytes each, little-endian)
-        memcpy(&payload[idx], &runtimeGlobals.config_mode_timeout_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.min_strength_threshold, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.max_recovery_attempts, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.recovery_attempt_delay_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.startup_delay_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.lidar_init_step_delay_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.lidar_final_delay_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.command_response_delay_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.debug_output_interval_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.status_check_interval_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.performance_report_interval_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.critical_error_report_interval_ms, 4); idx += 4;
-        memcpy(&payload[idx], &runtimeGlobals.distance_deadband_threshold_cm, 4); idx += 4;
-        
-        // Float (4 bytes)
-        memcpy(&payload[idx], &runtimeGlobals.velocity_deadband_threshold_cm_s, 4); idx += 4;
-        
+        // Read globals response: the parameters flagged PARAM_FLAG_LEGACY_BLOCK, 4 bytes each, in table order
+        uint8_t* payload = gui_response_payload;
+        uint16_t idx = 0;
+        for (uint8_t i = 0; i < paramCount(); i++) {
+          const ParamDescriptor& param = paramAt(i);
+          if (!(param.flags & PARAM_FLAG_LEGACY_BLOCK)) continue;
+          ParamValue value = paramGet(runtimeGlobals, param);
+          memcpy(&payload[idx], &value, 4); idx += 4;
+        }
         sendResponsePacket('L', payload, idx);
         break;
     }
     case 'l': {
-        // Write globals command (safe parameters only)
-        if (packet.len >= 56) {
-          uint8_t idx = 0;
-          
-          // Integers (4 bytes each, little-endian)
-          memcpy(&runtimeGlobals.config_mode_timeout_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.min_strength_threshold, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.max_recovery_attempts, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.recovery_attempt_delay_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.startup_delay_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.lidar_init_step_delay_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.lidar_final_delay_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.command_response_delay_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.debug_output_interval_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.status_check_interval_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.performance_report_interval_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.critical_error_report_interval_ms, &packet.payload[idx], 4); idx += 4;
-          memcpy(&runtimeGlobals.distance_deadband_threshold_cm, &packet.payload[idx], 4); idx += 4;
-          
-          // Float (4 bytes)
-          memcpy(&runtimeGlobals.velocity_deadband_threshold_cm_s, &packet.payload[idx], 4); idx += 4;
-          
-          if (validateGlobalConfiguration(runtimeGlobals)) {
-            sendAck('l');
-            triggerGuiSuccessGlow();
-          } else {
-            sendNak(NAK_ERR_INVALID_PAYLOAD);
+        // Write globals command: same layout as 'L', validated as a whole before it is applied
+        GlobalConfiguration updated = runtimeGlobals;
+        uint16_t idx = 0;
+        for (uint8_t i = 0; i < paramCount(); i++) {
+          const ParamDescriptor& param = paramAt(i);
+          if (!(param.flags & PARAM_FLAG_LEGACY_BLOCK)) continue;
+          if (idx + 4 > packet.len) break;
+          ParamValue value;
+          memcpy(&value, &packet.payload[idx], 4); idx += 4;
+          paramSet(updated, param, value);
+        }
+        if (idx == legacyParamBlockSize() && validateGlobalConfiguration(updated)) {
+          runtimeGlobals = updated;
+          sendAck('l');
+          triggerGuiSuccessGlow();
+        } else {
+          sendNak(NAK_ERR_INVALID_PAYLOAD);
+        }
+        break;
+    }
+    case 'Q': {
+        // Parameter discovery: [first index] -> see sendParamDescriptors()
+        if (packet.len == 1) {
+          sendParamDescriptors(packet.payload[0]);
+        } else sendNak(NAK_ERR_INVALID_PAYLOAD);
+        break;
+    }
+    case 'K': {
+        sendParamValues(packet);
+        break;
+    }
+    case 'k': {
+        setParamValues(packet);
+        break;
+    }
+    case 'P': {
+        // Protocol info: [highest version, v2 max payload lo, hi, v2 window]
+        uint8_t payload[4] = { GUI_PROTOCOL_V2, GUI_V2_MAX_PAYLOAD_SIZE & 0xFF, GUI_V2_MAX_PAYLOAD_SIZE >> 8, GUI_V2_WINDOW };
+        sendResponsePacket('P', payload, sizeof(payload));
+        break;
+    }
+    case 'Y': {
+        // Telemetry subscribe: [decimation] - every Nth processed sample, 0 = unsubscribe
+        if (packet.len == 1) {
+          telemetrySubscribe(packet.payload[0]);
+          sendAck('Y');
+        } else sendNak(NAK_ERR_INVALID_PAYLOAD);
+        break;
+    }
+    case 'B': {
+        // Bulk read: [offset lo, offset hi] -> [offset (2), total (2), CRC-32 (4), image bytes...]
+        if (packet.len == 2) {
+          sendBulkReadChunk(packet.payload[0] | (packet.payload[1] << 8));
+        } else sendNak(NAK_ERR_INVALID_PAYLOAD);
+        break;
+    }
+    case 'b': {
+        handleBulkWrite(packet);
+        break;
+    }
+#if ENABLE_FRAME_RECORDER
+    case 'H': {
+        handleRecorderCommand(packet);
+        break;
+    }
+#endif
+#if ENABLE_TRIGGER_SNAPSHOTS
+    case 'N': {
+        handleSnapshotCommand(packet);
+        break;
+    }
+#endif
+    case 'X': {
+        // Trace dump: [core, index lo, index hi] -> [core, index lo, index hi, total lo, total hi, events...]
+        // Index 0 freezes recording; core 0xFF resumes it.
+        if (packet.len == 1 && packet.payload[0] == 0xFF) {
+          traceFreeze(false);
+          sendAck('X');
+        } else if (packet.len == 3 && packet.payload[0] < 2) {
+          uint8_t core = packet.payload[0];
+          uint16_t index = packet.payload[1] | (packet.payload[2] << 8);
+          if (index == 0) traceFreeze(true);
+
+          uint8_t* payload = gui_response_payload;
+          uint16_t total = traceEventCount(core);
+          uint16_t idx = 5;
+          TraceEvent event;
+          while (idx + sizeof(TraceEvent) <= guiMaxResponsePayload() && traceGetEvent(core, index, event)) {
+            memcpy(&payload[idx], &event, sizeof(TraceEvent)); idx += sizeof(TraceEvent);
+            index++;
           }
+          payload[0] = core;
+          payload[1] = packet.payload[1];
+          payload[2] = packet.payload[2];
+          payload[3] = total & 0xFF;
+          payload[4] = total >> 8;
+          sendResponsePacket('X', payload, idx);
         } else {
           sendNak(NAK_ERR_INVALID_PAYLOAD);
         }
         break;
     }
     case 'R': {
-        safeSerialPrintln("Core 1: System reset requested via GUI");
+        if (LOG_INFO_ENABLED()) safeSerialPrintln("Core 1: System reset requested via GUI");
         sendAck('R');
         triggerGuiSuccessGlow();
-        delay(100);
-        rp2040.restart();
+        restart_pending = true;
+        restart_requested_ms = millis();
         break;
     }
     case 'F': {
-        safeSerialPrintln("Core 1: Factory reset requested via GUI");
+        if (LOG_INFO_ENABLED()) safeSerialPrintln("Core 1: Factory reset requested via GUI");
         sendAck('F');
         triggerGuiSuccessGlow();
         factoryReset();
+        restart_pending = true;
+        restart_requested_ms = millis();
         break;
     }
     default:
-      safeSerialPrintfln("Core 1: Unknown GUI command: 0x%02X", packet.cmd);
+      if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 1: Unknown GUI command: 0x%02X", packet.cmd);
       sendNak(NAK_ERR_UNKNOWN_CMD);
       break;
   }
 }
 
 /**
- * @brief Processes incoming serial data from the GUI.
+ * @brief Decodes a COBS-encoded block in place.
+ * @param data The encoded bytes, without delimiters; overwritten with the decoded bytes.
+ * @param length The number of encoded bytes.
+ * @return The number of decoded bytes, or 0 if the encoding is invalid.
+ */
+static uint16_t cobsDecode(uint8_t* data, uint16_t length) {
+  uint16_t in = 0;
+  uint16_t out = 0;
+  while (in < length) {
+    uint8_t code = data[in++];
+    if (code == 0 || in + code - 1 > length) return 0;
+    for (uint8_t i = 1; i < code; i++) data[out++] = data[in++];
+    if (code != 0xFF && in < length) data[out++] = 0;
+  }
+  return out;
+}
+
+/**
+ * @brief Checks and executes one protocol v2 frame.
+ *
+ * @details A frame decodes to SEQ CMD PAYLOAD CRC16 (little-endian CRC over
+ * SEQ, CMD and PAYLOAD). Every response to it echoes SEQ, so a host can keep
+ * several requests in flight and match the responses; requests are executed
+ * in the order they arrive. Frames that do not decode are dropped, and frames
+ * with a bad CRC are answered with a NAK carrying the received SEQ.
  *
- * @details This function implements a state machine to parse GUI packets from the serial
- * port. It reads the incoming bytes and transitions through different states to
- * identify the start of a packet, read the command and payload, and verify the
- * checksum. Once a valid packet is received, it calls `executeGuiCommand` to
- * process the command.
+ * @param frame The encoded frame, without delimiters. Decoded in place.
+ * @param length The encoded length.
+ * @param packet The packet to fill for executeGuiCommand.
  */
-void processGuiCommands() {
-  static GuiParserState state = STATE_WAIT_FOR_START;
-  static GuiPacket current_packet;
-  static uint8_t payload_index = 0;
-  static uint32_t packet_start_time = 0;
-
-  if (state != STATE_WAIT_FOR_START && safeMillisElapsed(packet_start_time, millis()) > GUI_PACKET_TIMEOUT_MS) {
-    safeSerialPrintln("Core 1: GUI packet timeout");
-    state = STATE_WAIT_FOR_START;
-    sendNak(NAK_ERR_TIMEOUT);
-  }
-
-  while (Serial.available() > 0) {
-    uint8_t byte = Serial.read();
-    switch (state) {
-      case STATE_WAIT_FOR_START:
-        if (byte == GUI_PACKET_START_BYTE) {
-          state = STATE_READ_CMD;
-          packet_start_time = millis();
-        }
+static void executeV2Frame(uint8_t* frame, uint16_t length, GuiPacket& packet) {
+  uint16_t decoded = cobsDecode(frame, length);
+  if (decoded < GUI_V2_OVERHEAD || decoded > GUI_V2_MAX_FRAME_SIZE) {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 1: GUI v2 frame malformed");
+    return;
+  }
+
+  gui_reply_target = { GUI_PROTOCOL_V2, frame[0] };
+  uint16_t received_crc = frame[decoded - 2] | (frame[decoded - 1] << 8);
+  uint16_t calculated_crc = crc16(frame, decoded - 2);
+  if (received_crc == calculated_crc) {
+    packet.cmd = frame[1];
+    packet.len = decoded - GUI_V2_OVERHEAD;
+    memcpy(packet.payload, &frame[2], packet.len);
+    TRACE_BEGIN_EVENT(TRACE_GUI_COMMAND, packet.cmd);
+    executeGuiCommand(packet);
+    TRACE_END_EVENT(TRACE_GUI_COMMAND, packet.cmd);
+  } else {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 1: GUI v2 frame CRC failed. Got: 0x%04X, Expected: 0x%04X", received_crc, calculated_crc);
+    sendNak(NAK_ERR_BAD_CHECKSUM);
+  }
+  gui_reply_target = { GUI_PROTOCOL_V1, 0 };
+}
+
+/**
+ * @brief State of the GUI packet parser, kept across receive chunks.
+ */
+struct GuiParser {
+  GuiParserState state = STATE_WAIT_FOR_START;
+  GuiPacket packet;                              ///< v1 packet being received, or the decoded v2 request.
+  uint16_t payload_index = 0;                    ///< v1 payload bytes received.
+  uint32_t start_time = 0;                       ///< millis() when the current packet started.
+  uint8_t v2_frame[GUI_V2_MAX_ENCODED_SIZE];     ///< Encoded v2 frame being collected.
+  uint16_t v2_index = 0;                         ///< Encoded v2 bytes collected.
+};
+
+static GuiParser gui_parser;
+
+/**
+ * @brief Runs a span of received bytes through the packet parser.
+ *
+ * @details Text and noise between packets, v1 payloads and v2 frames are each
+ * consumed as runs with memchr()/memcpy() rather than byte by byte. Complete
+ * packets are executed in the order they arrive.
+ *
+ * @param data The received bytes.
+ * @param length The number of bytes.
+ */
+static void parseGuiBytes(const uint8_t* data, uint16_t length) {
+  GuiParser& p = gui_parser;
+  uint16_t i = 0;
+
+  while (i < length) {
+    switch (p.state) {
+      case STATE_WAIT_FOR_START: {
+        // Skip everything up to the next v1 start byte or v2 delimiter
+        while (i < length && data[i] != GUI_PACKET_START_BYTE && data[i] != GUI_V2_DELIMITER) i++;
+        if (i == length) break;
+        p.state = (data[i++] == GUI_PACKET_START_BYTE) ? STATE_READ_CMD : STATE_READ_V2_FRAME;
+        p.v2_index = 0;
+        p.start_time = millis();
+        diagNoteGuiTraffic();
         break;
+      }
       case STATE_READ_CMD:
-        current_packet.cmd = byte;
-        state = STATE_READ_LEN;
-        break;
-      case STATE_READ_LEN:
-        if (byte <= GUI_MAX_PAYLOAD_SIZE) {
-          current_packet.len = byte;
-          payload_index = 0;
-          if (current_packet.len == 0) state = STATE_READ_CHECKSUM;
-          else state = STATE_READ_PAYLOAD;
+        p.packet.cmd = data[i++];
+        p.state = STATE_READ_LEN;
+        break;
+      case STATE_READ_LEN: {
+        uint8_t len = data[i++];
+        if (len <= GUI_MAX_PAYLOAD_SIZE) {
+          p.packet.len = len;
+          p.payload_index = 0;
+          p.state = (len == 0) ? STATE_READ_CHECKSUM : STATE_READ_PAYLOAD;
         } else {
-          safeSerialPrintln("Core 1: GUI packet invalid length");
+          if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 1: GUI packet invalid length");
           sendNak(NAK_ERR_INVALID_PAYLOAD);
-          state = STATE_WAIT_FOR_START;
+          p.state = STATE_WAIT_FOR_START;
         }
         break;
-      case STATE_READ_PAYLOAD:
-        current_packet.payload[payload_index++] = byte;
-        if (payload_index >= current_packet.len) {
-          state = STATE_READ_CHECKSUM;
-        }
+      }
+      case STATE_READ_PAYLOAD: {
+        uint16_t run = min((uint16_t)(p.packet.len - p.payload_index), (uint16_t)(length - i));
+        memcpy(&p.packet.payload[p.payload_index], &data[i], run);
+        p.payload_index += run;
+        i += run;
+        if (p.payload_index >= p.packet.len) p.state = STATE_READ_CHECKSUM;
         break;
-      case STATE_READ_CHECKSUM:
-        current_packet.checksum = byte;
-        uint8_t buffer_to_check[GUI_MAX_PAYLOAD_SIZE + 2];
-        buffer_to_check[0] = current_packet.cmd;
-        buffer_to_check[1] = current_packet.len;
-        memcpy(&buffer_to_check[2], current_packet.payload, current_packet.len);
-        uint8_t calculated_checksum = calculateGuiChecksum(buffer_to_check, current_packet.len + 2);
-        if (calculated_checksum == current_packet.checksum) {
-          executeGuiCommand(current_packet);
+      }
+      case STATE_READ_CHECKSUM: {
+        p.packet.checksum = data[i++];
+        uint8_t header[2] = { p.packet.cmd, (uint8_t)p.packet.len };
+        uint8_t calculated_checksum = calculateGuiChecksum(header, 2) + calculateGuiChecksum(p.packet.payload, p.packet.len);
+        if (calculated_checksum == p.packet.checksum) {
+          TRACE_BEGIN_EVENT(TRACE_GUI_COMMAND, p.packet.cmd);
+          executeGuiCommand(p.packet);
+          TRACE_END_EVENT(TRACE_GUI_COMMAND, p.packet.cmd);
         } else {
-          safeSerialPrintfln("Core 1: GUI packet checksum failed. Got: %d, Expected: %d",
-            current_packet.checksum, calculated_checksum);
+          if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 1: GUI packet checksum failed. Got: %d, Expected: %d",
+            p.packet.checksum, calculated_checksum);
           sendNak(NAK_ERR_BAD_CHECKSUM);
         }
-        state = STATE_WAIT_FOR_START;
+        p.state = STATE_WAIT_FOR_START;
+        break;
+      }
+      case STATE_READ_V2_FRAME: {
+        const uint8_t* end = (const uint8_t*)memchr(&data[i], GUI_V2_DELIMITER, length - i);
+        uint16_t run = end ? (uint16_t)(end - &data[i]) : (uint16_t)(length - i);
+        if (p.v2_index + run > sizeof(p.v2_frame)) {
+          p.state = STATE_SKIP_V2_FRAME;
+          break;
+        }
+        memcpy(&p.v2_frame[p.v2_index], &data[i], run);
+        p.v2_index += run;
+        i += run;
+        if (end) {
+          i++;
+          // An empty frame is a leading delimiter directly after a closing one
+          if (p.v2_index > 0) {
+            executeV2Frame(p.v2_frame, p.v2_index, p.packet);
+            p.state = STATE_WAIT_FOR_START;
+          }
+        }
+        break;
+      }
+      case STATE_SKIP_V2_FRAME: {
+        const uint8_t* end = (const uint8_t*)memchr(&data[i], GUI_V2_DELIMITER, length - i);
+        if (end) {
+          if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 1: GUI v2 frame too long");
+          p.state = STATE_WAIT_FOR_START;
+          i = end - data + 1;
+        } else {
+          i = length;
+        }
         break;
+      }
     }
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Processes incoming serial data from the GUI.
+ *
+ * @details This function drains the USB receive buffer in GUI_RX_CHUNK_SIZE
+ * readBytes() calls and runs each chunk through the packet parser. A packet
+ * that starts with GUI_PACKET_START_BYTE is a v1 packet; a GUI_V2_DELIMITER
+ * byte starts a protocol v2 frame, which is collected up to the next
+ * delimiter. Once a valid packet is received, `executeGuiCommand` processes
+ * the command. Save requests are answered once their configuration store
+ * commit completes. The responses of the whole pass are then written together,
+ * and streamed packets are written once they are due. A requested restart
+ * happens once its ACK is out and the store is idle.
+ */
+void processGuiCommands() {
+  GuiParser& p = gui_parser;
+  if (p.state != STATE_WAIT_FOR_START && safeMillisElapsed(p.start_time, millis()) > GUI_PACKET_TIMEOUT_MS) {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 1: GUI packet timeout");
+    // A v2 request without its closing delimiter has no trustworthy sequence ID to answer
+    bool v1_packet = (p.state != STATE_READ_V2_FRAME && p.state != STATE_SKIP_V2_FRAME);
+    p.state = STATE_WAIT_FOR_START;
+    if (v1_packet) sendNak(NAK_ERR_TIMEOUT);
+  }
+
+  uint8_t chunk[GUI_RX_CHUNK_SIZE];
+  int available;
+  while ((available = Serial.available()) > 0) {
+    size_t received = Serial.readBytes(chunk, min(available, (int)sizeof(chunk)));
+    if (received == 0) break;
+    parseGuiBytes(chunk, received);
+  }
+
+  serviceCommitWaiters();
+  guiTxService();
+  serviceRestart();
+}
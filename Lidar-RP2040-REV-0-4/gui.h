@@ -18,8 +18,41 @@
  *
  * @details This function reads and parses commands from the serial port that are sent by the
  * GUI. It handles various commands for configuring the device, retrieving data,
- * and controlling its operation.
+ * and controlling its operation. Both protocol framings are accepted on the
+ * same port, and every response uses the framing of its request.
  */
 void processGuiCommands();
 
+/**
+ * @brief Defines the GUI protocol framings.
+ */
+enum GuiProtocol : uint8_t {
+  GUI_PROTOCOL_V1 = 1,  ///< 0x7E CMD LEN PAYLOAD CHK, additive checksum, up to 64 bytes.
+  GUI_PROTOCOL_V2 = 2   ///< COBS frame of SEQ CMD PAYLOAD CRC16, up to 1 KiB.
+};
+
+/**
+ * @brief Where a response or streamed packet is sent: the framing and, for v2, the sequence ID to echo.
+ */
+struct GuiReplyTarget {
+  GuiProtocol protocol;  ///< Framing of the request.
+  uint8_t sequence;      ///< Sequence ID of the request (v2 only).
+};
+
+/**
+ * @brief Gets the reply target of the request being executed.
+ * @return The framing and sequence ID of the current request (v1 outside a request).
+ */
+GuiReplyTarget guiCurrentReplyTarget();
+
+/**
+ * @brief Sends a packet to the GUI only if it can be written without blocking.
+ * @param target The framing and sequence ID to use.
+ * @param cmd The command byte of the packet.
+ * @param payload A pointer to the payload data.
+ * @param len The length of the payload.
+ * @return True if the packet was written.
+ */
+bool trySendResponsePacket(const GuiReplyTarget& target, uint8_t cmd, const uint8_t* payload, uint16_t len);
+
 #endif // GUI_H
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * @file gui_tx.cpp
+ * @brief This file contains the implementation of the GUI transmit stage.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ */
+
+#include "gui_tx.h"
+#include "diag_governor.h"
+
+/**
+ * @brief Whole packets waiting to be written to USB. Only used from Core 1.
+ */
+struct GuiTxStage {
+  uint8_t data[GUI_TX_STAGE_SIZE];
+  uint16_t packet_end[GUI_TX_STAGE_PACKETS];  ///< Offset just past each staged packet.
+  uint16_t length;          ///< Bytes staged.
+  uint8_t packets;          ///< Packets staged.
+  uint32_t oldest_us;       ///< micros() when the first staged byte was added.
+  bool response_pending;    ///< True if a command response is staged.
+};
+
+static GuiTxStage gui_tx_stage;
+
+/**
+ * @brief Writes staged packets to USB.
+ * @param blocking If false, gives up when another writer holds the serial mutex,
+ *                 and writes only the leading whole packets that fit in the USB
+ *                 transmit buffer.
+ * @return True if the stage is now empty.
+ */
+static bool flushGuiTx(bool blocking) {
+  if (gui_tx_stage.length == 0) return true;
+
+  // Hold the serial mutex so text output cannot interleave with the packets
+  if (blocking) mutex_enter_blocking(&serial_mutex);
+  else if (!mutex_try_enter(&serial_mutex, nullptr)) return false;
+
+  uint8_t count = gui_tx_stage.packets;
+  if (!blocking) {
+    int space = Serial.availableForWrite();
+    count = 0;
+    while (count < gui_tx_stage.packets && gui_tx_stage.packet_end[count] <= space) count++;
+  }
+  if (count > 0) {
+    uint16_t written = gui_tx_stage.packet_end[count - 1];
+    Serial.write(gui_tx_stage.data, written);
+    gui_tx_stage.length -= written;
+    gui_tx_stage.packets -= count;
+    memmove(gui_tx_stage.data, &gui_tx_stage.data[written], gui_tx_stage.length);
+    for (uint8_t i = 0; i < gui_tx_stage.packets; i++) {
+      gui_tx_stage.packet_end[i] = gui_tx_stage.packet_end[i + count] - written;
+    }
+  }
+  mutex_exit(&serial_mutex);
+
+  if (gui_tx_stage.length > 0) return false;
+  gui_tx_stage.response_pending = false;
+  return true;
+}
+
+/**
+ * @brief Appends a framed packet to the stage.
+ * @param packet The framed packet.
+ * @param size The size of the framed packet, at most GUI_TX_STAGE_SIZE.
+ * @param blocking If false, gives up instead of waiting when the stage has no room.
+ * @param response True for a command response: the stage is written in full at
+ *                 the end of the receive pass.
+ * @return True if the packet was staged.
+ */
+bool guiTxStage(const uint8_t* packet, uint16_t size, bool blocking, bool response) {
+  if (gui_tx_stage.length + size > GUI_TX_STAGE_SIZE || gui_tx_stage.packets == GUI_TX_STAGE_PACKETS) {
+    flushGuiTx(blocking);
+    if (gui_tx_stage.length + size > GUI_TX_STAGE_SIZE || gui_tx_stage.packets == GUI_TX_STAGE_PACKETS) return false;
+  }
+
+  if (gui_tx_stage.length == 0) gui_tx_stage.oldest_us = micros();
+  memcpy(&gui_tx_stage.data[gui_tx_stage.length], packet, size);
+  gui_tx_stage.length += size;
+  gui_tx_stage.packet_end[gui_tx_stage.packets++] = gui_tx_stage.length;
+  if (response) gui_tx_stage.response_pending = true;
+  diagNoteGuiTraffic();
+  return true;
+}
+
+/**
+ * @brief Writes staged packets that are due: all of them if a command response
+ * is waiting, otherwise as many as fit once the oldest is GUI_TX_FLUSH_US old.
+ *
+ * @details Packets left behind keep their age, so they are written on the
+ * following calls as the USB transmit buffer drains.
+ */
+void guiTxService() {
+  if (gui_tx_stage.response_pending) {
+    flushGuiTx(true);
+  } else if (gui_tx_stage.length > 0 && micros() - gui_tx_stage.oldest_us >= GUI_TX_FLUSH_US) {
+    flushGuiTx(false);
+  }
+}
+
+/**
+ * @brief Checks whether every staged packet has been written.
+ * @return True if the stage is empty.
+ */
+bool guiTxEmpty() {
+  return gui_tx_stage.length == 0;
+}
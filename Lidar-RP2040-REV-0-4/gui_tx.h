@@ -0,0 +1,32 @@
+/**
+ * @file gui_tx.h
+ * @brief This file contains the declarations for the GUI transmit stage.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Each Serial.write() goes out as its own run of USB packets, so writing
+ * responses and telemetry one by one leaves most USB packets part-empty. Framed
+ * GUI packets are staged and written together: command responses at the end of
+ * each receive pass, streamed packets once the stage fills or its oldest byte is
+ * GUI_TX_FLUSH_US old. The stage only ever holds whole packets, so text output
+ * between two writes can never split one.
+ *
+ * The USB transmit buffer is smaller than the stage, so a flush that must not
+ * block writes only the leading whole packets that fit in it and keeps the
+ * rest staged. The stage uses no hardware beyond Serial, so host tools build
+ * this file unchanged (tools/gui_tx).
+ */
+#ifndef GUI_TX_H
+#define GUI_TX_H
+
+#include "globals.h"
+
+/** @brief Most packets staged at once - the stage remembers where each one ends. */
+#define GUI_TX_STAGE_PACKETS 32
+
+bool guiTxStage(const uint8_t* packet, uint16_t size, bool blocking, bool response);
+void guiTxService();
+bool guiTxEmpty();
+
+#endif // GUI_TX_H
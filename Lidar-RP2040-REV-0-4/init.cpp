@@ -14,6 +14,9 @@
 #include "globals.h"
 #include "status.h"
 #include "neopixel_integration.h"
+#include "lidar_sensor.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_INIT
+#include "log.h"
 
 /**
  * @brief Initializes the GPIO pins for Core 1.
@@ -23,7 +26,7 @@
  * status LED, and NeoPixel.
  */
 void initializePinsCore1() {
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Configuring GPIO pins...");
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Configuring GPIO pins...");
   pinMode(S1_PIN, INPUT_PULLUP);
   pinMode(S2_PIN, INPUT_PULLUP);
   pinMode(S4_PIN, INPUT_PULLUP);
@@ -38,18 +41,18 @@ void initializePinsCore1() {
 
   // Initialize NeoPixel system
   if (initNeoPixel(NEOPIXEL_PIN)) {
-    if (isDebugEnabled()) {
+    if (LOG_DEBUG_ENABLED()) {
       safeSerialPrintfln("Core 1: NeoPixel initialized successfully on pin %d", NEOPIXEL_PIN);
     }
     // Start initialization display (blue breathing)
-    updateNeoPixelStatus(NEO_INITIALIZING);
+    setNeoPixelTarget(NEO_INITIALIZING);
   } else {
-    if (isDebugEnabled()) {
+    if (LOG_DEBUG_ENABLED()) {
       safeSerialPrintfln("Core 1: WARNING - NeoPixel initialization failed on pin %d", NEOPIXEL_PIN);
     }
   }
 
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintln("Core 1: GPIO and NeoPixel configuration complete");
     safeSerialPrintfln("Core 1: Pin assignments - S1:%d, S2:%d, S4:%d, LED:%d, TRIG:%d, NEOPIXEL:%d",
       S1_PIN, S2_PIN, S4_PIN, STATUS_LED_PIN, TRIG_PULSE_LOW_PIN, NEOPIXEL_PIN);
@@ -76,7 +79,7 @@ void main_setup() {
     delay(100);
   }
 
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintln("=====================================");
     safeSerialPrintln("RP2040 LiDAR Controller v6.3 Starting");
     safeSerialPrintln("Arduino-Pico Native Dual-Core Version");
@@ -85,10 +88,11 @@ void main_setup() {
     safeSerialPrintfln("Core 0: Initializing at %lu ms", millis());
   }
 
+  initLidarSensorPins();
   timing_info.adaptive_timeout_us = FRAME_TIMEOUT_US;
   core0_state_timer = millis();
   core0_state = CORE0_STARTUP;
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintln("Core 0: Mutex initialization complete");
     safeSerialPrintln("Core 0: Starting serial initialization sequence...");
   }
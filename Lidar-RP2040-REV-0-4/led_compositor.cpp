@@ -0,0 +1,88 @@
+/**
+ * @file led_compositor.cpp
+ * @brief This file contains the implementation of the LedCompositor class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the per-channel integer blend of the LED layers.
+ */
+
+#include "led_compositor.h"
+
+/**
+ * @brief Blends one 8-bit channel of a layer onto the channel below it.
+ * @param below The channel value below the layer.
+ * @param value The layer's channel value.
+ * @param alpha The weight of the layer (255 = full).
+ * @param blend One of LedBlendMode.
+ * @return The blended channel value.
+ */
+static inline uint8_t blendChannel(uint8_t below, uint8_t value, uint8_t alpha, uint8_t blend) {
+  if (blend == LED_BLEND_ADD) {
+    uint32_t sum = below + ((uint32_t)value * alpha + 127) / 255;
+    return (sum > 255) ? 255 : (uint8_t)sum;
+  }
+  return (uint8_t)(((uint32_t)value * alpha + (uint32_t)below * (255 - alpha) + 127) / 255);
+}
+
+/**
+ * @brief Blends layers first..LED_LAYER_COUNT-1 onto a color.
+ * @param layers The layers.
+ * @param first The lowest layer to blend.
+ * @param below The color below the first layer.
+ * @return The output color in 0x00RRGGBB format.
+ */
+static uint32_t blendLayers(const LedLayer* layers, uint8_t first, uint32_t below) {
+  uint8_t r = (below >> 16) & 0xFF, g = (below >> 8) & 0xFF, b = below & 0xFF;
+  for (uint8_t i = first; i < LED_LAYER_COUNT; i++) {
+    const LedLayer& layer = layers[i];
+    if (!layer.active) continue;
+    r = blendChannel(r, (layer.color >> 16) & 0xFF, layer.alpha, layer.blend);
+    g = blendChannel(g, (layer.color >> 8) & 0xFF, layer.alpha, layer.blend);
+    b = blendChannel(b, layer.color & 0xFF, layer.alpha, layer.blend);
+  }
+  return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+/**
+ * @brief Blends the active layers from the lowest to the highest priority.
+ *
+ * @details An opaque LED_BLEND_OVER layer hides everything below it, so only
+ * the layers above the highest such layer are blended.
+ *
+ * @return The output color in 0x00RRGGBB format.
+ */
+uint32_t LedCompositor::compose() const {
+  uint8_t first = 0;
+  for (int8_t i = LED_LAYER_COUNT - 1; i >= 0; i--) {
+    if (layers[i].active && layers[i].blend == LED_BLEND_OVER && layers[i].alpha == 255) {
+      first = i;
+      break;
+    }
+  }
+  return blendLayers(layers, first, 0);
+}
+
+/**
+ * @brief Blends the active layers above the base layer onto a given color.
+ *
+ * @details Used for strips, where the base is a different color per pixel.
+ *
+ * @param below The color to use in place of the base layer.
+ * @return The output color in 0x00RRGGBB format.
+ */
+uint32_t LedCompositor::composeOver(uint32_t below) const {
+  return blendLayers(layers, LED_LAYER_BASE + 1, below);
+}
+
+/**
+ * @brief Checks whether any layer above the base layer is active.
+ * @return True if composeOver() can change a color.
+ */
+bool LedCompositor::hasOverlay() const {
+  for (uint8_t i = LED_LAYER_BASE + 1; i < LED_LAYER_COUNT; i++) {
+    if (layers[i].active) return true;
+  }
+  return false;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file led_compositor.h
+ * @brief This file contains the declaration of the LedCompositor class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The NeoPixel output is built from independent layers, one per source
+ * (mode display, GUI glow, error flash, trigger flash). Each source only
+ * updates its own layer; the compositor blends the active layers in priority
+ * order once per refresh tick.
+ */
+#ifndef LED_COMPOSITOR_H
+#define LED_COMPOSITOR_H
+
+#include "globals.h"
+
+/**
+ * @brief Defines the LED layers, in order of increasing priority.
+ */
+enum LedLayerId {
+  LED_LAYER_BASE,       ///< Mode display (distance gradient or status pattern).
+  LED_LAYER_GUI_GLOW,   ///< Green glow acknowledging a GUI command.
+  LED_LAYER_ERROR,      ///< Red error flash.
+  LED_LAYER_TRIGGER,    ///< White trigger flash.
+  LED_LAYER_COUNT
+};
+
+/**
+ * @brief Defines how a layer is combined with the layers below it.
+ */
+enum LedBlendMode {
+  LED_BLEND_OVER,   ///< Replaces the color below, weighted by alpha.
+  LED_BLEND_ADD     ///< Adds to the color below, weighted by alpha, saturating at 255.
+};
+
+/**
+ * @brief A single LED layer.
+ */
+struct LedLayer {
+  uint32_t color;       ///< Color in 0x00RRGGBB format.
+  uint8_t alpha;        ///< Weight of the layer (255 = full).
+  uint8_t blend;        ///< One of LedBlendMode.
+  bool active;          ///< Inactive layers are skipped.
+};
+
+/**
+ * @class LedCompositor
+ * @brief Blends the LED layers into one output color.
+ */
+class LedCompositor {
+private:
+  LedLayer layers[LED_LAYER_COUNT] = {};
+
+public:
+  /**
+   * @brief Activates a layer with a new color.
+   * @param id The layer.
+   * @param color The color in 0x00RRGGBB format.
+   * @param alpha The weight of the layer (255 = full).
+   * @param blend How the layer is combined with the layers below it.
+   */
+  void setLayer(LedLayerId id, uint32_t color, uint8_t alpha = 255, LedBlendMode blend = LED_BLEND_OVER) {
+    layers[id] = { color, alpha, (uint8_t)blend, true };
+  }
+
+  /**
+   * @brief Deactivates a layer.
+   * @param id The layer.
+   */
+  void clearLayer(LedLayerId id) { layers[id].active = false; }
+
+  /**
+   * @brief Blends the active layers from the lowest to the highest priority.
+   * @return The output color in 0x00RRGGBB format.
+   */
+  uint32_t compose() const;
+
+  /**
+   * @brief Blends the active layers above the base layer onto a given color.
+   * @param below The color to use in place of the base layer.
+   * @return The output color in 0x00RRGGBB format.
+   */
+  uint32_t composeOver(uint32_t below) const;
+
+  /**
+   * @brief Checks whether any layer above the base layer is active.
+   * @return True if composeOver() can change a color.
+   */
+  bool hasOverlay() const;
+};
+
+#endif // LED_COMPOSITOR_H
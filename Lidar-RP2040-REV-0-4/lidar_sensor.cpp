@@ -0,0 +1,278 @@
+/**
+ * @file lidar_sensor.cpp
+ * @brief This file contains the implementation of the LidarSensor class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the per-sensor TF frame parser and the sensor table. Sensor 0 is
+ * always on Serial1, sensor 1 on Serial2, and sensors 2 and 3 on PIO-based UARTs.
+ */
+
+#include "lidar_sensor.h"
+#include "globals_config.h"
+#include "core0_handling.h"
+#include "binlog.h"
+#include "diag_governor.h"
+#include "trace.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_LIDAR
+#include "log.h"
+
+// ===== SENSOR TABLE =====
+#if LIDAR_SENSOR_COUNT >= 3
+static SerialPIO lidar_pio_serial2(LIDAR3_TX_PIN, LIDAR3_RX_PIN, 64);
+#endif
+#if LIDAR_SENSOR_COUNT >= 4
+static SerialPIO lidar_pio_serial3(LIDAR4_TX_PIN, LIDAR4_RX_PIN, 64);
+#endif
+
+static LidarSensor lidar_sensor0(0, &Serial1);
+#if LIDAR_SENSOR_COUNT >= 2
+static LidarSensor lidar_sensor1(1, &Serial2);
+#endif
+#if LIDAR_SENSOR_COUNT >= 3
+static LidarSensor lidar_sensor2(2, &lidar_pio_serial2);
+#endif
+#if LIDAR_SENSOR_COUNT >= 4
+static LidarSensor lidar_sensor3(3, &lidar_pio_serial3);
+#endif
+
+LidarSensor* const lidar_sensors[LIDAR_SENSOR_COUNT] = {
+  &lidar_sensor0,
+#if LIDAR_SENSOR_COUNT >= 2
+  &lidar_sensor1,
+#endif
+#if LIDAR_SENSOR_COUNT >= 3
+  &lidar_sensor2,
+#endif
+#if LIDAR_SENSOR_COUNT >= 4
+  &lidar_sensor3,
+#endif
+};
+
+/**
+ * @brief Discards all pending receive data and resets the parser.
+ */
+void LidarSensor::flushInput() {
+  while (port->available()) port->read();
+  sync_state = 0;
+  frame_index = 0;
+}
+
+/**
+ * @brief Reads and parses pending bytes from the sensor's serial port.
+ *
+ * @details Synchronizes on the 0x59 0x59 header, collects the 9-byte frame, and hands
+ * complete frames to handleFrame(). Partial frames are abandoned after the adaptive
+ * frame timeout. The time spent in each call is accumulated for the per-sensor
+ * load statistics.
+ *
+ * @param current_time The current millis() value.
+ */
+void LidarSensor::poll(uint32_t current_time) {
+  uint32_t poll_start = micros();
+
+  // Look for frame sync
+  if (sync_state == 0 && port->available() >= 2) {
+    uint8_t first_byte = port->read();
+    if (first_byte == FRAME_SYNC_BYTE1 && port->peek() == FRAME_SYNC_BYTE2) {
+      frame_data[0] = FRAME_SYNC_BYTE1;
+      frame_data[1] = port->read();
+      frame_index = 2;
+      frame_start_time = micros();
+      sync_state = 1;
+      consecutive_sync_failures = 0; // Reset failure counter
+    } else {
+      consecutive_sync_failures++;
+
+      // Log sync issues periodically
+      if (LOG_DEBUG_ENABLED() && consecutive_sync_failures % 100 == 0 && diagAllow(DIAG_PARSE)) {
+        binlog(BLOG_SYNC_FAILURE, id, consecutive_sync_failures, FRAME_SYNC_BYTE1, first_byte);
+      }
+
+      // If too many sync failures, perform health check
+      if (consecutive_sync_failures > 1000) {
+        if (LOG_ERROR_ENABLED() && diagAllow(DIAG_HEALTH)) binlog(BLOG_SYNC_FAILURE_LIMIT, id);
+        checkLidarSensorHealth();
+        consecutive_sync_failures = 0;
+      }
+    }
+  }
+
+  // Read frame data
+  while (sync_state == 1 && frame_index < 9 && port->available()) {
+    frame_data[frame_index++] = port->read();
+    if (frame_index >= 9) {
+      sync_state = 0;
+      TRACE_BEGIN_EVENT(TRACE_FRAME_PARSE, id);
+      handleFrame(current_time);
+      TRACE_END_EVENT(TRACE_FRAME_PARSE, id);
+    }
+  }
+
+  // Handle frame timeout
+  if (sync_state > 0 && safeMicrosElapsed(frame_start_time, micros()) > timing_info.adaptive_timeout_us) {
+    sync_state = 0;
+    if (LOG_DEBUG_ENABLED() && diagAllow(DIAG_TIMEOUT)) {
+      binlog(BLOG_FRAME_TIMEOUT, id, timing_info.adaptive_timeout_us, frame_index);
+    }
+  }
+
+  uint32_t poll_time = safeMicrosElapsed(poll_start, micros());
+  poll_time_us_total += poll_time;
+  if (poll_time > poll_time_us_max) poll_time_us_max = poll_time;
+}
+
+/**
+ * @brief Validates a complete 9-byte frame and pushes it to the sensor's queue.
+ * @param current_time The current millis() value.
+ */
+void LidarSensor::handleFrame(uint32_t current_time) {
+  // Calculate and verify checksum
+  uint8_t checksum = 0;
+  for (int i = 0; i < 8; i++) {
+    checksum += frame_data[i];
+  }
+
+  if (checksum != frame_data[8]) {
+    invalid_frames++;
+    consecutive_good_frames = 0;
+    safeSetErrorFlag(ERROR_FLAG_FRAME_CORRUPTION, true);
+
+    if (LOG_DEBUG_ENABLED() && diagAllow(DIAG_PARSE)) {
+      binlog(BLOG_CHECKSUM_MISMATCH, id, checksum, frame_data[8]);
+
+      // Show the problematic frame data
+      binlog(BLOG_BAD_FRAME_DATA,
+             ((uint32_t)frame_data[0] << 24) | ((uint32_t)frame_data[1] << 16) | ((uint32_t)frame_data[2] << 8) | frame_data[3],
+             ((uint32_t)frame_data[4] << 24) | ((uint32_t)frame_data[5] << 16) | ((uint32_t)frame_data[6] << 8) | frame_data[7],
+             frame_data[8]);
+    }
+    return;
+  }
+
+  // Checksum valid - clear error flags
+  safeSetErrorFlag(ERROR_FLAG_FRAME_CORRUPTION, false);
+  consecutive_good_frames++;
+
+  // Clear communication timeout after several good frames
+  safeSetErrorFlag(ERROR_FLAG_COMM_TIMEOUT, false);
+  if (consecutive_good_frames >= 5) {
+    mutex_enter_blocking(&comm_mutex);
+    core_comm.recovery_attempts = 0;
+    mutex_exit(&comm_mutex);
+    consecutive_good_frames = 0;
+  }
+
+  // Parse frame data
+  LidarFrame new_frame;
+  new_frame.distance = frame_data[2] | (frame_data[3] << 8);
+  new_frame.strength = frame_data[4] | (frame_data[5] << 8);
+  new_frame.temperature = frame_data[6] | (frame_data[7] << 8);
+  new_frame.sensor_id = id;
+
+  // Validate frame data ranges - USE RUNTIME GLOBAL for strength threshold
+  if (new_frame.distance < MIN_DISTANCE_CM || new_frame.distance > MAX_DISTANCE_CM ||
+      new_frame.strength < RUNTIME_MIN_STRENGTH_THRESHOLD) {
+    invalid_frames++;
+    consecutive_good_frames = 0;
+    safeSetErrorFlag(ERROR_FLAG_FRAME_CORRUPTION, true);
+
+    if (LOG_DEBUG_ENABLED() && diagAllow(DIAG_PARSE)) {
+      binlog(BLOG_VALIDATION_FAILED, id, new_frame.distance, MIN_DISTANCE_CM, MAX_DISTANCE_CM,
+             new_frame.strength, RUNTIME_MIN_STRENGTH_THRESHOLD);
+    }
+    return;
+  }
+
+  new_frame.timestamp = micros();
+  valid_frames++;
+
+  // Temperature travels out of band, refreshed once per second
+  if (safeMillisElapsed(last_temperature_update, current_time) >= 1000) {
+    sensor_temperature[id] = new_frame.temperature;
+    last_temperature_update = current_time;
+  }
+
+  // Try to add frame to buffer
+  if (!atomicBufferPush(new_frame)) {
+    // REV 2: Suppress buffer overflow messages during config mode
+    bool config_active = false;
+    mutex_enter_blocking(&comm_mutex);
+    config_active = core_comm.config_mode_active;
+    mutex_exit(&comm_mutex);
+
+    if (LOG_ERROR_ENABLED() && !config_active && diagAllow(DIAG_OVERFLOW)) {
+      binlog(BLOG_BUFFER_OVERFLOW, id, getBufferUtilization(id), FRAME_BUFFER_SIZE);
+    }
+  } else {
+    // Update communication timestamp on successful frame processing
+    mutex_enter_blocking(&comm_mutex);
+    core_comm.last_frame_time = current_time;
+    mutex_exit(&comm_mutex);
+  }
+}
+
+/**
+ * @brief Closes the current statistics window. Called once per second.
+ */
+void LidarSensor::rollStatistics() {
+  stats.valid_per_second = valid_frames;
+  stats.invalid_per_second = invalid_frames;
+  stats.frames_per_second = valid_frames + invalid_frames;
+  stats.poll_time_us_max = poll_time_us_max;
+  stats.poll_time_us_total = poll_time_us_total;
+  valid_frames = invalid_frames = 0;
+  poll_time_us_max = poll_time_us_total = 0;
+}
+
+/**
+ * @brief Assigns pins to the secondary hardware UART. Must be called before lidarBeginAll().
+ */
+void initLidarSensorPins() {
+#if LIDAR_SENSOR_COUNT >= 2
+  Serial2.setTX(LIDAR2_TX_PIN);
+  Serial2.setRX(LIDAR2_RX_PIN);
+#endif
+}
+
+/**
+ * @brief Opens every sensor port at the given baud rate.
+ * @param baud The baud rate.
+ */
+void lidarBeginAll(uint32_t baud) {
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) lidar_sensors[i]->begin(baud);
+}
+
+/**
+ * @brief Closes every sensor port.
+ */
+void lidarEndAll() {
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) lidar_sensors[i]->end();
+}
+
+/**
+ * @brief Sends the same command to every sensor.
+ * @param data The command bytes.
+ * @param len The number of bytes.
+ */
+void lidarWriteAll(const uint8_t* data, size_t len) {
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) lidar_sensors[i]->write(data, len);
+}
+
+/**
+ * @brief Discards pending receive data on every sensor port.
+ */
+void lidarFlushAll() {
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) lidar_sensors[i]->flushInput();
+}
+
+/**
+ * @brief Gets the total number of bytes waiting across all sensor ports.
+ * @return The number of bytes available.
+ */
+int lidarAvailableAll() {
+  int total = 0;
+  for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) total += lidar_sensors[i]->available();
+  return total;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file lidar_sensor.h
+ * @brief This file contains the declaration of the LidarSensor class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details A LidarSensor binds one TF-series LiDAR to a serial port (Serial1, Serial2 or a
+ * PIO UART) and owns the frame parser for that port. Each sensor pushes validated
+ * frames, tagged with its sensor ID, into its own frame queue for Core 1.
+ */
+#ifndef LIDAR_SENSOR_H
+#define LIDAR_SENSOR_H
+
+#include "globals.h"
+
+/**
+ * @brief Per-sensor acquisition statistics, refreshed once per second by Core 0.
+ */
+struct LidarSensorStats {
+  uint32_t frames_per_second;    ///< Frames (valid + invalid) seen in the last one-second window.
+  uint32_t valid_per_second;     ///< Valid frames seen in the last one-second window.
+  uint32_t invalid_per_second;   ///< Invalid frames seen in the last one-second window.
+  uint32_t poll_time_us_max;     ///< Longest single poll() in the last window.
+  uint32_t poll_time_us_total;   ///< Total time spent in poll() in the last window.
+};
+
+/**
+ * @class LidarSensor
+ * @brief Frame parser and port handling for a single LiDAR sensor.
+ *
+ * @details All state of the 9-byte TF frame parser lives in the instance, so any number of
+ * sensors can be serviced round-robin from the Core 0 loop without sharing state.
+ */
+class LidarSensor {
+private:
+  uint8_t id;                         ///< Sensor index, also used as the frame queue index.
+  HardwareSerial* port;               ///< Serial port the sensor is wired to.
+  uint8_t sync_state = 0;             ///< 0 = searching for sync bytes, 1 = reading frame body.
+  uint8_t frame_data[9];              ///< Raw bytes of the frame being assembled.
+  uint8_t frame_index = 0;            ///< Number of bytes in frame_data.
+  uint32_t frame_start_time = 0;      ///< micros() when the current frame sync was found.
+  uint32_t consecutive_sync_failures = 0;
+  uint32_t consecutive_good_frames = 0;
+  uint32_t valid_frames = 0;          ///< Valid frames in the current statistics window.
+  uint32_t invalid_frames = 0;        ///< Invalid frames in the current statistics window.
+  uint32_t poll_time_us_max = 0;      ///< Longest poll() in the current statistics window.
+  uint32_t poll_time_us_total = 0;    ///< Accumulated poll() time in the current window.
+  uint32_t last_temperature_update = 0;
+  LidarSensorStats stats = {};        ///< Statistics of the last completed window.
+
+  void handleFrame(uint32_t current_time);
+
+public:
+  /**
+   * @brief Construct a new LidarSensor.
+   * @param sensor_id The sensor index (0 to LIDAR_SENSOR_COUNT - 1).
+   * @param serial_port The serial port the sensor is connected to.
+   */
+  LidarSensor(uint8_t sensor_id, HardwareSerial* serial_port) : id(sensor_id), port(serial_port) {}
+
+  /**
+   * @brief Opens the serial port at the given baud rate.
+   * @param baud The baud rate.
+   */
+  void begin(uint32_t baud) { port->begin(baud); }
+
+  /**
+   * @brief Closes the serial port.
+   */
+  void end() { port->end(); }
+
+  /**
+   * @brief Sends a command to the sensor.
+   * @param data The command bytes.
+   * @param len The number of bytes.
+   */
+  void write(const uint8_t* data, size_t len) { port->write(data, len); }
+
+  /**
+   * @brief Discards all pending receive data and resets the parser.
+   */
+  void flushInput();
+
+  /**
+   * @brief Gets the number of bytes waiting in the receive buffer.
+   * @return The number of bytes available.
+   */
+  int available() { return port->available(); }
+
+  /**
+   * @brief Reads and parses pending bytes, pushing complete valid frames to the sensor's queue.
+   * @param current_time The current millis() value.
+   */
+  void poll(uint32_t current_time);
+
+  /**
+   * @brief Closes the current statistics window. Called once per second.
+   */
+  void rollStatistics();
+
+  /**
+   * @brief Gets the sensor index.
+   * @return The sensor index.
+   */
+  uint8_t getId() const { return id; }
+
+  /**
+   * @brief Gets the statistics of the last completed window.
+   * @return The sensor statistics.
+   */
+  const LidarSensorStats& getStats() const { return stats; }
+};
+
+/**
+ * @brief The table of configured sensors, indexed by sensor ID.
+ */
+extern LidarSensor* const lidar_sensors[LIDAR_SENSOR_COUNT];
+
+/**
+ * @brief Helper functions that operate on every configured sensor.
+ * @{
+ */
+void initLidarSensorPins();
+void lidarBeginAll(uint32_t baud);
+void lidarEndAll();
+void lidarWriteAll(const uint8_t* data, size_t len);
+void lidarFlushAll();
+int lidarAvailableAll();
+/** @} */
+
+#endif // LIDAR_SENSOR_H
@@ -0,0 +1,115 @@
+/**
+ * @file load_scheduler.cpp
+ * @brief This file contains the implementation of the LoadScheduler class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the adaptive batch size, the load mode hysteresis and the
+ * decimation rule used by the Core 1 frame pipeline.
+ */
+
+#include "load_scheduler.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
+
+/**
+ * @brief Switches to a new load mode and reports the transition.
+ * @param new_mode The new load mode.
+ */
+void LoadScheduler::setMode(LoadMode new_mode) {
+  static const char* const mode_names[] = { "NORMAL", "SHED", "DECIMATE" };
+  if (LOG_DEBUG_ENABLED()) {
+    safeSerialPrintfln("Core 1: Load mode %s -> %s", mode_names[mode], mode_names[new_mode]);
+  }
+  mode = new_mode;
+  stats.mode_changes++;
+  under_pressure = relieved = false;
+}
+
+/**
+ * @brief Updates the load mode from the current queue depth and returns the batch size.
+ *
+ * @details The batch grows by one frame for every four queued frames, up to
+ * LOAD_MAX_BATCH. The mode escalates one step when the queue stays above the
+ * next step's threshold (warning for SHED, critical for DECIMATE) for
+ * LOAD_SUSTAIN_MS, and steps back down after the queue stays at or below
+ * LOAD_RECOVER_THRESHOLD for the same time.
+ *
+ * @param queue_depth The fill level of the fullest frame queue.
+ * @return The maximum number of frames to process per sensor in this cycle.
+ */
+uint8_t LoadScheduler::update(uint8_t queue_depth) {
+  uint32_t now_us = micros();
+  uint32_t now_ms = millis();
+
+  if (last_update_us != 0) {
+    stats.mode_time_us[mode] += safeMicrosElapsed(last_update_us, now_us);
+  }
+  last_update_us = now_us;
+
+  uint8_t escalate_threshold = (mode == LOAD_NORMAL) ? BUFFER_WARNING_THRESHOLD : BUFFER_CRITICAL_THRESHOLD;
+
+  if (mode < LOAD_DECIMATE && queue_depth >= escalate_threshold) {
+    if (!under_pressure) {
+      under_pressure = true;
+      pressure_since_ms = now_ms;
+    } else if (safeMillisElapsed(pressure_since_ms, now_ms) >= LOAD_SUSTAIN_MS) {
+      setMode((LoadMode)(mode + 1));
+    }
+  } else {
+    under_pressure = false;
+  }
+
+  if (mode > LOAD_NORMAL && queue_depth <= LOAD_RECOVER_THRESHOLD) {
+    if (!relieved) {
+      relieved = true;
+      relief_since_ms = now_ms;
+    } else if (safeMillisElapsed(relief_since_ms, now_ms) >= LOAD_SUSTAIN_MS) {
+      setMode((LoadMode)(mode - 1));
+    }
+  } else {
+    relieved = false;
+  }
+
+  uint32_t batch = LOAD_MIN_BATCH + queue_depth / 4;
+  if (batch > LOAD_MAX_BATCH) batch = LOAD_MAX_BATCH;
+  if (batch > stats.max_batch) stats.max_batch = batch;
+  return (uint8_t)batch;
+}
+
+/**
+ * @brief Decides whether a frame may be skipped.
+ *
+ * @details Only applies in LOAD_DECIMATE. A frame is a candidate only while the
+ * sensor's trigger is idle, in which case skipping it leaves the debouncer and
+ * latch exactly as they are. Frames within LOAD_DECIMATE_MARGIN_CM of the
+ * threshold, widened by the distance covered at the current velocity within
+ * LOAD_DECIMATE_LOOKAHEAD_MS, are always kept. One in LOAD_DECIMATE_KEEP_EVERY
+ * candidates is still kept so the velocity history stays current.
+ *
+ * @param distance The frame's distance in centimeters.
+ * @param threshold The active distance threshold in centimeters.
+ * @param velocity The sensor's latest velocity in cm/s.
+ * @param trigger_idle True if the sensor's raw trigger and latch are both inactive.
+ * @return True if the frame should be skipped.
+ */
+bool LoadScheduler::shouldDecimate(uint16_t distance, uint16_t threshold, float velocity, bool trigger_idle) {
+  if (mode != LOAD_DECIMATE || !trigger_idle) return false;
+
+  float speed = (velocity < 0.0f) ? -velocity : velocity;
+  uint32_t margin = LOAD_DECIMATE_MARGIN_CM + (uint32_t)(speed * LOAD_DECIMATE_LOOKAHEAD_MS / 1000.0f);
+  if ((uint32_t)distance <= (uint32_t)threshold + margin) return false;
+
+  if (++decimate_counter % LOAD_DECIMATE_KEEP_EVERY == 0) return false;
+
+  stats.decimated_frames++;
+  return true;
+}
+
+/**
+ * @brief Starts a new report window.
+ */
+void LoadScheduler::resetStats() {
+  stats = {};
+}
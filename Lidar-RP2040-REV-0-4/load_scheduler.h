@@ -0,0 +1,97 @@
+/**
+ * @file load_scheduler.h
+ * @brief This file contains the declaration of the LoadScheduler class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The load scheduler sizes the Core 1 frame batches from the queue depth and,
+ * under sustained overload, degrades Core 1 work in two steps: first the NeoPixel
+ * and telemetry updates are shed, then frames that cannot affect the trigger are
+ * decimated. Frames near a threshold crossing are always processed.
+ */
+#ifndef LOAD_SCHEDULER_H
+#define LOAD_SCHEDULER_H
+
+#include "globals.h"
+
+/**
+ * @brief Defines the Core 1 load modes, in order of increasing degradation.
+ */
+enum LoadMode {
+  LOAD_NORMAL,      ///< All work is done.
+  LOAD_SHED,        ///< NeoPixel and telemetry updates are skipped.
+  LOAD_DECIMATE,    ///< Additionally, frames far from every trigger threshold are decimated.
+  LOAD_MODE_COUNT
+};
+
+/**
+ * @brief Load statistics for the current report window.
+ */
+struct LoadStats {
+  uint32_t mode_time_us[LOAD_MODE_COUNT]; ///< Time spent in each mode.
+  uint32_t mode_changes;                  ///< Number of mode transitions.
+  uint32_t decimated_frames;              ///< Frames skipped by decimation.
+  uint32_t max_batch;                     ///< Largest batch size handed out.
+};
+
+/**
+ * @class LoadScheduler
+ * @brief Chooses the batch size and load mode for each Core 1 processing cycle.
+ */
+class LoadScheduler {
+private:
+  LoadMode mode = LOAD_NORMAL;
+  uint32_t last_update_us = 0;
+  uint32_t pressure_since_ms = 0;   ///< millis() when the queue first exceeded the current mode's threshold.
+  uint32_t relief_since_ms = 0;     ///< millis() when the queue first fell to the recover threshold.
+  bool under_pressure = false;
+  bool relieved = false;
+  uint32_t decimate_counter = 0;
+  LoadStats stats = {};
+
+  void setMode(LoadMode new_mode);
+
+public:
+  /**
+   * @brief Updates the load mode from the current queue depth and returns the batch size.
+   * @param queue_depth The fill level of the fullest frame queue.
+   * @return The maximum number of frames to process per sensor in this cycle.
+   */
+  uint8_t update(uint8_t queue_depth);
+
+  /**
+   * @brief Gets the current load mode.
+   * @return The load mode.
+   */
+  LoadMode getMode() const { return mode; }
+
+  /**
+   * @brief Checks whether NeoPixel and telemetry updates should be skipped.
+   * @return True in LOAD_SHED and LOAD_DECIMATE.
+   */
+  bool shedDisplay() const { return mode >= LOAD_SHED; }
+
+  /**
+   * @brief Decides whether a frame may be skipped.
+   * @param distance The frame's distance in centimeters.
+   * @param threshold The active distance threshold in centimeters.
+   * @param velocity The sensor's latest velocity in cm/s.
+   * @param trigger_idle True if the sensor's raw trigger and latch are both inactive.
+   * @return True if the frame should be skipped.
+   */
+  bool shouldDecimate(uint16_t distance, uint16_t threshold, float velocity, bool trigger_idle);
+
+  /**
+   * @brief Gets the statistics of the current report window.
+   * @return The load statistics.
+   */
+  const LoadStats& getStats() const { return stats; }
+
+  /**
+   * @brief Starts a new report window.
+   */
+  void resetStats();
+};
+
+#endif // LOAD_SCHEDULER_H
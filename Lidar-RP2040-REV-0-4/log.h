@@ -0,0 +1,45 @@
+/**
+ * @file log.h
+ * @brief This file contains the compile-time log level macros.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Each source file defines LOG_MODULE_FLOOR (one of the LOG_FLOOR_* values in
+ * globals.h) before including this header. Log guards compare a level against that
+ * floor at compile time, so a statement above the floor is a constant-false branch
+ * that the compiler removes together with its format string. Error and info
+ * statements at or below the floor cost nothing; debug statements cost one
+ * relaxed atomic load of the runtime debug switch.
+ */
+#ifndef LOG_H
+#define LOG_H
+
+#include "globals.h"
+
+#ifndef LOG_MODULE_FLOOR
+#define LOG_MODULE_FLOOR LOG_LEVEL_FLOOR
+#endif
+
+/**
+ * @brief Checks whether a level is compiled in for the current module.
+ * @param level One of the LOG_LEVEL_* values.
+ */
+#define LOG_COMPILED(level) ((level) <= LOG_MODULE_FLOOR)
+
+/**
+ * @brief Guard for errors and critical warnings - compiled out only at LOG_LEVEL_NONE.
+ */
+#define LOG_ERROR_ENABLED() LOG_COMPILED(LOG_LEVEL_ERROR)
+
+/**
+ * @brief Guard for status notices - compiled out below LOG_LEVEL_INFO.
+ */
+#define LOG_INFO_ENABLED() LOG_COMPILED(LOG_LEVEL_INFO)
+
+/**
+ * @brief Guard for debug output - compiled out below LOG_LEVEL_DEBUG, otherwise follows the runtime debug switch.
+ */
+#define LOG_DEBUG_ENABLED() (LOG_COMPILED(LOG_LEVEL_DEBUG) && isDebugEnabled())
+
+#endif // LOG_H
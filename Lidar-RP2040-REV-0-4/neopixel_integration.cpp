@@ -11,52 +11,75 @@
 
 #include "neopixel_integration.h"
 #include "trigger.h"
+#include "trace.h"
+#include "led_compositor.h"
+#include "strip_renderer.h"
+#include "color_lut.h"
+#include <atomic>
 
 // Global instance
 NeoPixelController neopixel;
-static uint32_t gui_glow_start = 0;
-static bool gui_glow_active = false;
+static LedCompositor led_compositor;
+#if NEOPIXEL_PIXEL_COUNT > 1
+static StripRenderer strip_renderer;
+#endif
+static volatile uint32_t gui_glow_start = 0;
+static volatile bool gui_glow_active = false;
+
+// Display target double buffer: Core 1 writes the inactive slot, then flips the index
+static NeoPixelTarget display_targets[2] = { { NEO_INITIALIZING, 255, 0, 0.0f }, { NEO_INITIALIZING, 255, 0, 0.0f } };
+static std::atomic<uint8_t> display_target_index{0};
+
+// A frame must be on the wire and latched before the next tick: 30 us per RGB pixel plus 300 us
+static_assert(NEOPIXEL_PIXEL_COUNT >= 1 && NEOPIXEL_PIXEL_COUNT <= 255, "NEOPIXEL_PIXEL_COUNT must be 1-255");
+static_assert(NEOPIXEL_PIXEL_COUNT * 30 + 300 < NEOPIXEL_REFRESH_INTERVAL_MS * 1000,
+              "NeoPixel strip too long for NEOPIXEL_REFRESH_INTERVAL_MS");
+
+static alarm_pool_t* refresh_pool = nullptr;
+static repeating_timer_t refresh_timer;
+static bool refresh_started = false;
 
 void triggerGuiSuccessGlow() {
+  gui_glow_active = false;
   gui_glow_start = millis();
   gui_glow_active = true;
 }
 
-uint32_t getConfigColorWithGlow(uint32_t base_time) {
+/**
+ * @brief Updates the GUI glow layer.
+ *
+ * @details The glow is added in green on top of whatever is below it: it
+ * brightens over 500 ms, holds for 200 ms, and fades over 500 ms.
+ *
+ * @param now The current time in milliseconds.
+ */
+static void updateGuiGlowLayer(uint32_t now) {
   if (!gui_glow_active) {
-    // Normal purple flashing
-    bool on = (base_time % 1000) < 500;
-    return on ? 0x00800080 : 0x00000000;  // Purple or off
+    led_compositor.clearLayer(LED_LAYER_GUI_GLOW);
+    return;
   }
 
-  uint32_t glow_elapsed = millis() - gui_glow_start;
+  uint32_t glow_elapsed = now - gui_glow_start;
 
   if (glow_elapsed > 1200) {  // 1.2 second total glow
     gui_glow_active = false;
-    bool on = (base_time % 1000) < 500;
-    return on ? 0x00800080 : 0x00000000;  // Return to purple
+    led_compositor.clearLayer(LED_LAYER_GUI_GLOW);
+    return;
   }
 
-  // Calculate green glow intensity
-  float green_intensity = 0.0f;
+  uint8_t green_intensity;
   if (glow_elapsed < 500) {
     // Phase 1: Brighten (0 to 500ms)
-    green_intensity = glow_elapsed / 500.0f;  // 0.0 to 1.0
+    green_intensity = glow_elapsed * 255 / 500;
   } else if (glow_elapsed < 700) {
     // Phase 2: Peak (500 to 700ms)
-    green_intensity = 1.0f;
+    green_intensity = 255;
   } else {
     // Phase 3: Fade (700 to 1200ms)
-    green_intensity = 1.0f - ((glow_elapsed - 700) / 500.0f);  // 1.0 to 0.0
+    green_intensity = (1200 - glow_elapsed) * 255 / 500;
   }
 
-  // Blend green glow with purple base
-  bool purple_on = (base_time % 1000) < 500;
-  uint8_t base_r = purple_on ? 128 : 0;
-  uint8_t base_b = purple_on ? 128 : 0;
-  uint8_t green = (uint8_t)(255 * green_intensity);
-
-  return ((uint32_t)base_r << 16) | ((uint32_t)green << 8) | base_b;
+  led_compositor.setLayer(LED_LAYER_GUI_GLOW, 0x0000FF00, green_intensity, LED_BLEND_ADD);
 }
 
 /**
@@ -64,7 +87,8 @@ uint32_t getConfigColorWithGlow(uint32_t base_time) {
  */
 NeoPixelController::NeoPixelController()
   : strip(nullptr), initialized(false), trigger_flash_requested(false),
-    smoothed_distance(0), smoothed_strength(0), smoothing_initialized(false) {
+    shown_pixels{}, shown_valid(false), show_stats{},
+    smoothed_distance_q8(0), smoothed_strength_q8(0), smoothing_initialized(false) {
 }
 
 /**
@@ -81,9 +105,10 @@ NeoPixelController::~NeoPixelController() {
  * @brief Initializes the NeoPixel.
  * @param pin The pin the NeoPixel is connected to.
  * @param num_pixels The number of pixels in the strip.
+ * @param alarm_pool The pool that times the latch of each frame, or nullptr for the default pool.
  * @return True if initialization was successful, false otherwise.
  */
-bool NeoPixelController::init(uint8_t pin, uint8_t num_pixels) {
+bool NeoPixelController::init(uint8_t pin, uint8_t num_pixels, alarm_pool_t* alarm_pool) {
   if (strip) {
     delete strip;
   }
@@ -96,18 +121,40 @@ bool NeoPixelController::init(uint8_t pin, uint8_t num_pixels) {
   }
 
   // Initialize the library
+  strip->setAlarmPool(alarm_pool);
   strip->begin();
   strip->show();              // Initialize all pixels to 'off'
   strip->setBrightness(200);  // Set to ~78% brightness
 
   initialized = true;
+  shown_valid = false;
   clear();
 
   return true;
 }
 
+/**
+ * @brief Sends the shown_pixels buffer to the LEDs.
+ */
+void NeoPixelController::output() {
+  for (uint16_t i = 0; i < NEOPIXEL_PIXEL_COUNT; i++) {
+    uint32_t color = shown_pixels[i];
+    strip->setPixelColor(i, strip->Color((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF));
+  }
+  TRACE_BEGIN_EVENT(TRACE_LED_SHOW, 0);
+  strip->showAsync();
+  TRACE_END_EVENT(TRACE_LED_SHOW, 0);
+  shown_valid = true;
+  show_stats.shows++;
+}
+
 /**
  * @brief Sets the color of the NeoPixel.
+ *
+ * @details Every pixel of a strip is set to the color. The frame is handed to
+ * DMA, so this returns without waiting for the wire time or the latch of the
+ * previous frame. Nothing is sent if the LEDs already show the color.
+ *
  * @param r The red component of the color.
  * @param g The green component of the color.
  * @param b The blue component of the color.
@@ -115,27 +162,124 @@ bool NeoPixelController::init(uint8_t pin, uint8_t num_pixels) {
 void NeoPixelController::setColor(uint8_t r, uint8_t g, uint8_t b) {
   if (!isReady()) return;
 
-  strip->setPixelColor(0, strip->Color(r, g, b));
-  strip->show();
+  uint32_t color = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  bool changed = !shown_valid;
+  for (uint16_t i = 0; i < NEOPIXEL_PIXEL_COUNT; i++) {
+    if (shown_pixels[i] != color) {
+      shown_pixels[i] = color;
+      changed = true;
+    }
+  }
+  if (changed) {
+    output();
+  } else {
+    show_stats.redundant++;
+  }
+}
+
+/**
+ * @brief Sets every pixel from a framebuffer.
+ *
+ * @details Nothing is sent if the LEDs already show the framebuffer.
+ *
+ * @param pixels NEOPIXEL_PIXEL_COUNT colors in 0x00RRGGBB format.
+ */
+void NeoPixelController::setPixels(const uint32_t* pixels) {
+  if (!isReady()) return;
+
+  if (shown_valid && memcmp(shown_pixels, pixels, sizeof(shown_pixels)) == 0) {
+    show_stats.redundant++;
+    return;
+  }
+  memcpy(shown_pixels, pixels, sizeof(shown_pixels));
+  output();
 }
 
 /**
  * @brief Clears the NeoPixel.
  */
 void NeoPixelController::clear() {
-  if (!isReady()) return;
+  setColor(0, 0, 0);
+}
 
-  strip->clear();
-  strip->show();
+/**
+ * @brief Adds one refresh tick's cost to the output statistics.
+ * @param cycles The CPU cycles spent rendering and sending.
+ */
+void NeoPixelController::recordRender(uint32_t cycles) {
+  show_stats.renders++;
+  show_stats.render_cycles_total += cycles;
+  if (cycles > show_stats.render_cycles_max) show_stats.render_cycles_max = cycles;
+}
+
+static void renderNeoPixel(uint32_t now);
+
+/**
+ * @brief Repeating timer callback for the LED refresh task.
+ * @param timer The repeating timer.
+ * @return True to keep the timer running.
+ */
+static bool neoPixelRefreshCallback(repeating_timer_t* timer) {
+  (void)timer;
+  uint32_t start_cycles = rp2040.getCycleCount();
+  renderNeoPixel(millis());
+  neopixel.recordRender(rp2040.getCycleCount() - start_cycles);
+  return true;
 }
 
 /**
- * @brief Initializes the NeoPixel system.
+ * @brief Initializes the NeoPixel system and starts the LED refresh task.
+ *
+ * @details The refresh timer and the latch alarm of each frame run in an
+ * alarm pool created here, so their interrupts fire on Core 1 and never take
+ * time from the LiDAR acquisition on Core 0. A negative interval makes the
+ * period start-to-start, so the animation rate stays at
+ * NEOPIXEL_REFRESH_INTERVAL_MS regardless of load.
+ *
  * @param pin The pin the NeoPixel is connected to.
  * @return True if initialization was successful, false otherwise.
  */
 bool initNeoPixel(uint8_t pin) {
-  return neopixel.init(pin, 1);  // Single pixel
+  if (refresh_pool == nullptr) {
+    // One alarm for the refresh timer, one for the latch of the frame on the wire
+    refresh_pool = alarm_pool_create_with_unused_hardware_alarm(2);
+    if (refresh_pool == nullptr) {
+      return false;
+    }
+  }
+
+  if (!neopixel.init(pin, NEOPIXEL_PIXEL_COUNT, refresh_pool)) {
+    return false;
+  }
+
+  if (!refresh_started) {
+    refresh_started = alarm_pool_add_repeating_timer_ms(refresh_pool, -(int32_t)NEOPIXEL_REFRESH_INTERVAL_MS,
+                                                        neoPixelRefreshCallback, nullptr, &refresh_timer);
+  }
+  return refresh_started;
+}
+
+/**
+ * @brief Publishes what the NeoPixel should display.
+ *
+ * @details Writes the inactive slot of the target double buffer and then makes
+ * it current. The refresh task interrupts Core 1 between instructions but never
+ * while it is reading, so it always sees a complete target. This is the only
+ * LED work left on the frame path.
+ *
+ * @param mode The NeoPixel mode to set.
+ * @param distance The current distance measurement.
+ * @param velocity The current velocity measurement.
+ * @param strength The current signal strength.
+ */
+void setNeoPixelTarget(NeoPixelMode mode, uint16_t distance, float velocity, uint8_t strength) {
+  uint8_t next = display_target_index.load(std::memory_order_relaxed) ^ 1;
+  NeoPixelTarget& target = display_targets[next];
+  target.mode = mode;
+  target.strength = strength;
+  target.distance = distance;
+  target.velocity = velocity;
+  display_target_index.store(next, std::memory_order_release);
 }
 
 /**
@@ -146,29 +290,52 @@ void triggerNeoPixelFlash() {
 }
 
 /**
- * @brief Updates the NeoPixel status based on the current mode.
- * @param mode The NeoPixel mode to set.
- * @param distance The current distance measurement.
- * @param velocity The current velocity measurement.
- * @param strength The current signal strength.
+ * @brief Renders one LED frame. Called from the refresh timer on Core 1.
+ *
+ * @details Each source updates its own layer: the published target sets the
+ * base layer, and the GUI glow, error flash and trigger flash layers follow
+ * their own timing. The compositor then blends the layers and the LED is only
+ * written if the result differs from what it shows. Runs in interrupt context,
+ * so shared state is read without taking any mutex.
+ *
+ * @param now The current time in milliseconds.
  */
-void updateNeoPixelStatus(NeoPixelMode mode, uint16_t distance, float velocity, uint8_t strength) {
+static void renderNeoPixel(uint32_t now) {
   if (!neopixel.isReady()) return;
 
-  static uint32_t last_update = 0;
   static uint32_t error_flash_start = 0;
   static bool error_flash_active = false;
-  uint32_t now = millis();
 
-  // Rate limit updates to 50Hz for performance
-  if (now - last_update < 20) return;
-  last_update = now;
+  NeoPixelTarget target = display_targets[display_target_index.load(std::memory_order_acquire)];
+  NeoPixelMode mode = (NeoPixelMode)target.mode;
+
+  // Base layer: the requested mode
+  switch (mode) {
+    case NEO_DISTANCE:
+#if NEOPIXEL_PIXEL_COUNT == 1
+      led_compositor.setLayer(LED_LAYER_BASE, calculateDistanceColor(target.distance, target.velocity, target.strength));
+#endif
+      break;
+
+    case NEO_TRIGGER_FLASH:
+      break;  // Keep the current base
+
+    case NEO_INITIALIZING:
+    case NEO_CONFIG:
+    case NEO_ERROR:
+      led_compositor.setLayer(LED_LAYER_BASE, getStatusColor(mode, now));
+      break;
+
+    case NEO_OFF:
+    default:
+      led_compositor.setLayer(LED_LAYER_BASE, 0);
+      break;
+  }
+
+  updateGuiGlowLayer(now);
 
-  // Check for error conditions (second highest priority)
-  uint32_t error_flags = 0;
-  mutex_enter_blocking(&comm_mutex);
-  error_flags = core_comm.error_flags;
-  mutex_exit(&comm_mutex);
+  // Error layer: flashes for 3 seconds after an error flag appears
+  uint32_t error_flags = __atomic_load_n(&core_comm.error_flags, __ATOMIC_RELAXED);
 
   if (error_flags != 0 && !error_flash_active) {
     error_flash_start = now;
@@ -177,61 +344,49 @@ void updateNeoPixelStatus(NeoPixelMode mode, uint16_t distance, float velocity,
     error_flash_active = false;
   }
 
-  // Handle trigger flash with absolute priority
-  bool trigger_currently_active = (digitalRead(TRIG_PULSE_LOW_PIN) == LOW);
-
-  if (trigger_currently_active && neopixel.isTriggerFlashRequested()) {
-    uint32_t color = getTriggerFlashColor(now, true);
-    uint8_t r = (color >> 16) & 0xFF;
-    uint8_t g = (color >> 8) & 0xFF;
-    uint8_t b = color & 0xFF;
-    neopixel.setColor(r, g, b);
-    return;
-  } else if (!trigger_currently_active) {
-    neopixel.clearTriggerFlashRequest();
-  }
-
-  // Handle error flash (second priority)
   if (error_flash_active && (now - error_flash_start) < 3000) {
-    uint32_t color = getStatusColor(NEO_ERROR, now);
-    uint8_t r = (color >> 16) & 0xFF;
-    uint8_t g = (color >> 8) & 0xFF;
-    uint8_t b = color & 0xFF;
-    neopixel.setColor(r, g, b);
-    return;
-  } else if (error_flash_active && (now - error_flash_start) >= 3000) {
+    led_compositor.setLayer(LED_LAYER_ERROR, getStatusColor(NEO_ERROR, now));
+  } else {
     error_flash_active = false;
+    led_compositor.clearLayer(LED_LAYER_ERROR);
   }
 
-  // Handle normal modes
-  uint32_t color;
-  switch (mode) {
-    case NEO_OFF:
-      neopixel.clear();
-      return;
-
-    case NEO_DISTANCE:
-      color = calculateDistanceColor(distance, velocity, strength);
-      break;
-
-    case NEO_TRIGGER_FLASH:
-      return;
+  // Trigger layer: flashes while the trigger output is active
+  bool trigger_currently_active = (digitalRead(TRIG_PULSE_LOW_PIN) == LOW);
 
-    case NEO_INITIALIZING:
-    case NEO_CONFIG:
-    case NEO_ERROR:
-      color = getStatusColor(mode, now);
-      break;
+  if (trigger_currently_active && neopixel.isTriggerFlashRequested()) {
+    led_compositor.setLayer(LED_LAYER_TRIGGER, getTriggerFlashColor(now, true));
+  } else {
+    if (!trigger_currently_active) {
+      neopixel.clearTriggerFlashRequest();
+    }
+    led_compositor.clearLayer(LED_LAYER_TRIGGER);
+  }
 
-    default:
-      neopixel.clear();
-      return;
+#if NEOPIXEL_PIXEL_COUNT > 1
+  // Strip: the distance display is drawn per pixel, overlays cover the whole strip
+  if (mode == NEO_DISTANCE) {
+    strip_renderer.render(target.distance, target.velocity, target.strength,
+                          __atomic_load_n(&core_comm.switch_code, __ATOMIC_RELAXED), now);
+  } else {
+    strip_renderer.fill(led_compositor.compose());
   }
+  strip_renderer.applyOverlays(led_compositor);
+  neopixel.setPixels(strip_renderer.getPixels());
+#else
+  uint32_t color = led_compositor.compose();
+  neopixel.setColor((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+#endif
+}
 
-  uint8_t r = (color >> 16) & 0xFF;
-  uint8_t g = (color >> 8) & 0xFF;
-  uint8_t b = color & 0xFF;
-  neopixel.setColor(r, g, b);
+/**
+ * @brief Computes one smoothing step, rounded to nearest so the average settles on its input.
+ * @param delta The difference between the new sample and the smoothed value.
+ * @return The change to apply to the smoothed value.
+ */
+static inline int32_t smoothingStep(int32_t delta) {
+  int32_t scaled = delta * NEOPIXEL_SMOOTHING_ALPHA_PERCENT;
+  return (scaled >= 0) ? (scaled + 50) / 100 : (scaled - 50) / 100;
 }
 
 /**
@@ -242,71 +397,19 @@ void updateNeoPixelStatus(NeoPixelMode mode, uint16_t distance, float velocity,
  * @return The calculated color in 32-bit format.
  */
 uint32_t calculateDistanceColor(uint16_t distance_cm, float velocity_cm_s, uint8_t signal_strength) {
-  // Apply smoothing to reduce noise and flickering
+  // Apply smoothing to reduce noise and flickering (8.8 fixed point)
+  int32_t distance_q8 = (int32_t)distance_cm << 8;
+  int32_t strength_q8 = (int32_t)signal_strength << 8;
   if (!neopixel.smoothing_initialized) {
-    neopixel.smoothed_distance = distance_cm;
-    neopixel.smoothed_strength = signal_strength;
+    neopixel.smoothed_distance_q8 = distance_q8;
+    neopixel.smoothed_strength_q8 = strength_q8;
     neopixel.smoothing_initialized = true;
   } else {
-    neopixel.smoothed_distance = NEOPIXEL_SMOOTHING_ALPHA * distance_cm + (1.0f - NEOPIXEL_SMOOTHING_ALPHA) * neopixel.smoothed_distance;
-    neopixel.smoothed_strength = NEOPIXEL_SMOOTHING_ALPHA * signal_strength + (1.0f - NEOPIXEL_SMOOTHING_ALPHA) * neopixel.smoothed_strength;
+    neopixel.smoothed_distance_q8 += smoothingStep(distance_q8 - neopixel.smoothed_distance_q8);
+    neopixel.smoothed_strength_q8 += smoothingStep(strength_q8 - neopixel.smoothed_strength_q8);
   }
 
-  // Use smoothed values
-  float distance = neopixel.smoothed_distance;
-  float strength = neopixel.smoothed_strength;
-
-  // Clamp distance to valid range
-  if (distance < MIN_DISTANCE_CM) distance = MIN_DISTANCE_CM;
-  if (distance > MAX_DISTANCE_CM) distance = MAX_DISTANCE_CM;
-
-  // REV 2: Calculate position in range (0.0 = close/hot, 1.0 = far/cool)
-  float position = (distance - MIN_DISTANCE_CM) / (MAX_DISTANCE_CM - MIN_DISTANCE_CM);
-
-  // REV 2: Distance-based heat map colors (red → yellow → blue)
-  uint8_t r, g, b;
-
-  if (position <= 0.5f) {
-    // First half: Red (0.0) to Yellow (0.5)
-    float local_pos = position * 2.0f;  // 0.0 to 1.0
-    r = 255;
-    g = (uint8_t)(255 * local_pos);  // Increase green to make yellow
-    b = 0;
-  } else {
-    // Second half: Yellow (0.5) to Blue (1.0)
-    float local_pos = (position - 0.5f) * 2.0f;  // 0.0 to 1.0
-    r = (uint8_t)(255 * (1.0f - local_pos));     // Decrease red
-    g = (uint8_t)(255 * (1.0f - local_pos));     // Decrease green
-    b = (uint8_t)(255 * local_pos);              // Increase blue
-  }
-
-  // REV 2: Apply velocity-based saturation modulation
-  float saturation_factor = 1.0f;  // Default saturation
-  float abs_velocity = abs(velocity_cm_s);
-
-  if (abs_velocity > 5.0f) {  // Only apply if there's significant movement
-    if (velocity_cm_s < -5.0f) {
-      // Approaching - make more vivid (increase saturation)
-      saturation_factor = 1.2f;  // +20% saturation
-    } else if (velocity_cm_s > 5.0f) {
-      // Receding - make more muted (decrease saturation)
-      saturation_factor = 0.7f;  // -30% saturation
-    }
-  }
-
-  // Apply saturation factor (limit to prevent overflow)
-  r = (uint8_t)(constrain(r * saturation_factor, 0, 255));
-  g = (uint8_t)(constrain(g * saturation_factor, 0, 255));
-  b = (uint8_t)(constrain(b * saturation_factor, 0, 255));
-
-  // Apply brightness based on signal strength (30-100%)
-  float brightness = 0.3f + 0.7f * (strength / 255.0f);
-  r = (uint8_t)(r * brightness);
-  g = (uint8_t)(g * brightness);
-  b = (uint8_t)(b * brightness);
-
-  // Return as 32-bit color (0x00RRGGBB format)
-  return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  return distanceColor(neopixel.smoothed_distance_q8, velocity_cm_s, (uint32_t)neopixel.smoothed_strength_q8);
 }
 
 /**
@@ -342,32 +445,18 @@ uint32_t getStatusColor(NeoPixelMode mode, uint32_t time_ms) {
   switch (mode) {
     case NEO_INITIALIZING:
       {
-        // Slow, deep breathing blue animation (3 second cycle)
+        // Slow, deep breathing blue animation (3 second cycle): a parabola from
+        // 2% at the start and end of the cycle to 100% in the middle
         uint32_t cycle_time = time_ms % 3000;  // 0 to 2999 (slow cycle)
-        float phase = cycle_time / 3000.0f;    // 0.0 to 1.0
-
-        // Smooth breathing curve using parabolic function
-        float breath_curve;
-        if (phase < 0.5f) {
-          // Inhale: smooth acceleration to peak
-          float t = phase * 2.0f;  // 0.0 to 1.0
-          breath_curve = t * t;    // Parabolic curve (smooth start)
-        } else {
-          // Exhale: smooth deceleration from peak
-          float t = (1.0f - phase) * 2.0f;  // 1.0 to 0.0
-          breath_curve = t * t;             // Parabolic curve (smooth end)
-        }
-
-        // Very dramatic brightness range for deep breathing effect
-        float brightness = 0.02f + 0.98f * breath_curve;  // 0.02 to 1.0 (very dramatic)
-
-        uint8_t blue = (uint8_t)(255 * brightness);
-        return (uint32_t)blue;  // 0x000000BB
+        uint32_t from_dim = (cycle_time < 1500) ? cycle_time : 3000 - cycle_time;  // 0 to 1500
+        return breathingLevel(from_dim * 65536 / 1500);  // 0x000000BB
       }
 
     case NEO_CONFIG:
       {
-        return getConfigColorWithGlow(time_ms);
+        // Purple flashing (1Hz); the GUI glow is a separate layer
+        bool on = (time_ms % 1000) < 500;
+        return on ? 0x00800080 : 0x00000000;  // Purple or off
       }
 
     case NEO_ERROR:
@@ -17,6 +17,7 @@
 
 #include "globals.h"
 #include <Adafruit_NeoPixel.h>
+#include <pico/time.h>
 
 /**
  * @brief Defines the different modes for the NeoPixel display.
@@ -34,8 +35,19 @@ enum NeoPixelMode {
 const uint32_t NEOPIXEL_FLASH_ON_MS = 100;
 /** @brief The duration in milliseconds for the NeoPixel flash 'off' state. */
 const uint32_t NEOPIXEL_FLASH_OFF_MS = 100;
-/** @brief The smoothing factor for the distance and strength values. */
-const float NEOPIXEL_SMOOTHING_ALPHA = 0.3f;
+/** @brief The smoothing factor for the distance and strength values, in percent. */
+const int32_t NEOPIXEL_SMOOTHING_ALPHA_PERCENT = 30;
+
+/**
+ * @brief NeoPixel output statistics for the current report window.
+ */
+struct NeoPixelShowStats {
+    uint32_t shows;            ///< Frames sent to the LED.
+    uint32_t redundant;        ///< Updates skipped because the color was unchanged.
+    uint32_t renders;          ///< Refresh ticks rendered.
+    uint32_t render_cycles_total; ///< CPU cycles spent rendering and sending.
+    uint32_t render_cycles_max;   ///< Most expensive refresh tick.
+};
 
 /**
  * @class NeoPixelController
@@ -51,11 +63,20 @@ private:
     Adafruit_NeoPixel* strip; ///< Pointer to the Adafruit_NeoPixel instance.
     bool initialized;         ///< Flag indicating if the NeoPixel is initialized.
     
-    bool trigger_flash_requested; ///< Flag indicating if a trigger flash has been requested.
+    volatile bool trigger_flash_requested; ///< Flag indicating if a trigger flash has been requested.
+
+    uint32_t shown_pixels[NEOPIXEL_PIXEL_COUNT]; ///< Last colors sent to the LEDs (0x00RRGGBB).
+    bool shown_valid;             ///< False until the first frame has been sent.
+    NeoPixelShowStats show_stats; ///< Output statistics.
+
+    /**
+     * @brief Sends the shown_pixels buffer to the LEDs.
+     */
+    void output();
     
 public:
-    float smoothed_distance;     ///< The smoothed distance value.
-    float smoothed_strength;     ///< The smoothed strength value.
+    int32_t smoothed_distance_q8; ///< The smoothed distance value in 1/256 cm.
+    int32_t smoothed_strength_q8; ///< The smoothed strength value in 1/256 units.
     bool smoothing_initialized;  ///< Flag indicating if the smoothing has been initialized.
     
     /**
@@ -72,9 +93,10 @@ public:
      * @brief Initializes the NeoPixel.
      * @param pin The pin the NeoPixel is connected to.
      * @param num_pixels The number of pixels in the strip.
+     * @param alarm_pool The pool that times the latch of each frame, or nullptr for the default pool.
      * @return True if initialization was successful, false otherwise.
      */
-    bool init(uint8_t pin, uint8_t num_pixels = 1);
+    bool init(uint8_t pin, uint8_t num_pixels = 1, alarm_pool_t* alarm_pool = nullptr);
 
     /**
      * @brief Sets the color of the NeoPixel.
@@ -84,11 +106,34 @@ public:
      */
     void setColor(uint8_t r, uint8_t g, uint8_t b);
 
+    /**
+     * @brief Sets every pixel from a framebuffer.
+     * @param pixels NEOPIXEL_PIXEL_COUNT colors in 0x00RRGGBB format.
+     */
+    void setPixels(const uint32_t* pixels);
+
     /**
      * @brief Clears the NeoPixel.
      */
     void clear();
 
+    /**
+     * @brief Adds one refresh tick's cost to the output statistics.
+     * @param cycles The CPU cycles spent rendering and sending.
+     */
+    void recordRender(uint32_t cycles);
+
+    /**
+     * @brief Gets the output statistics of the current report window.
+     * @return The output statistics.
+     */
+    const NeoPixelShowStats& getShowStats() const { return show_stats; }
+
+    /**
+     * @brief Starts a new report window.
+     */
+    void resetShowStats() { show_stats = {}; }
+
     /**
      * @brief Checks if the NeoPixel is ready.
      * @return True if the NeoPixel is ready, false otherwise.
@@ -112,6 +157,16 @@ public:
     void clearTriggerFlashRequest() { trigger_flash_requested = false; }
 };
 
+/**
+ * @brief The display target published by Core 1 for the LED refresh task.
+ */
+struct NeoPixelTarget {
+    uint8_t mode;       ///< The NeoPixelMode to display.
+    uint8_t strength;   ///< The signal strength as brightness (0-255).
+    uint16_t distance;  ///< The distance in centimeters.
+    float velocity;     ///< The velocity in cm/s.
+};
+
 /**
  * @brief The global instance of the NeoPixelController.
  */
@@ -123,20 +178,20 @@ extern NeoPixelController neopixel;
  */
 
 /**
- * @brief Initializes the NeoPixel system.
+ * @brief Initializes the NeoPixel system and starts the LED refresh task.
  * @param pin The pin the NeoPixel is connected to.
  * @return True if initialization was successful, false otherwise.
  */
 bool initNeoPixel(uint8_t pin);
 
 /**
- * @brief Updates the NeoPixel status based on the current mode.
+ * @brief Publishes what the NeoPixel should display. Lock-free; the refresh task renders it.
  * @param mode The NeoPixel mode to set.
  * @param distance The current distance measurement.
  * @param velocity The current velocity measurement.
  * @param strength The current signal strength.
  */
-void updateNeoPixelStatus(NeoPixelMode mode, uint16_t distance = 0, float velocity = 0, uint8_t strength = 255);
+void setNeoPixelTarget(NeoPixelMode mode, uint16_t distance = 0, float velocity = 0, uint8_t strength = 255);
 
 /**
  * @brief Triggers a flash of the NeoPixel.
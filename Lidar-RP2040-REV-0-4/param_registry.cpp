@@ -0,0 +1,150 @@
+/**
+ * @file param_registry.cpp
+ * @brief This file contains the runtime parameter table and its accessors.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The table is built at compile time and checked by static_assert:
+ * IDs are unique and non-zero, every field lies inside GlobalConfiguration and
+ * every default is within its own range.
+ */
+
+#include "param_registry.h"
+#include <stddef.h>
+
+/** @brief Table entry for a uint32_t field of GlobalConfiguration. */
+#define PARAM_U32(id, field, min, max, def, flags) \
+  { id, PARAM_TYPE_U32, flags, offsetof(GlobalConfiguration, field), \
+    ParamValue((uint32_t)(min)), ParamValue((uint32_t)(max)), ParamValue((uint32_t)(def)), #field }
+/** @brief Table entry for a float field of GlobalConfiguration. */
+#define PARAM_F32(id, field, min, max, def, flags) \
+  { id, PARAM_TYPE_F32, flags, offsetof(GlobalConfiguration, field), \
+    ParamValue((float)(min)), ParamValue((float)(max)), ParamValue((float)(def)), #field }
+
+#define LEGACY PARAM_FLAG_LEGACY_BLOCK
+#define RESTART PARAM_FLAG_RESTART
+
+/**
+ * @brief All runtime parameters. Entries flagged LEGACY form the 'L'/'l' block in this order.
+ */
+static constexpr ParamDescriptor param_table[] = {
+  // System settings
+  PARAM_U32( 1, config_mode_timeout_ms,            1000, 60000, CONFIG_MODE_TIMEOUT_MS,            LEGACY | RESTART),
+  PARAM_U32( 2, min_strength_threshold,              50,  1000, MIN_STRENGTH_THRESHOLD,            LEGACY),
+  // Recovery & error handling
+  PARAM_U32( 3, max_recovery_attempts,                1,    10, MAX_RECOVERY_ATTEMPTS,             LEGACY),
+  PARAM_U32( 4, recovery_attempt_delay_ms,         1000, 30000, RECOVERY_ATTEMPT_DELAY_MS,         LEGACY),
+  // Timing & performance
+  PARAM_U32( 5, startup_delay_ms,                   100,  5000, STARTUP_DELAY_MS,                  LEGACY | RESTART),
+  PARAM_U32( 6, lidar_init_step_delay_ms,           100,  2000, LIDAR_INIT_STEP_DELAY_MS,          LEGACY | RESTART),
+  PARAM_U32( 7, lidar_final_delay_ms,                50,  1000, LIDAR_FINAL_DELAY_MS,              LEGACY | RESTART),
+  PARAM_U32( 8, command_response_delay_ms,           10,   500, COMMAND_RESPONSE_DELAY_MS,         LEGACY),
+  // Debug & monitoring
+  PARAM_U32( 9, debug_output_interval_ms,            50,  5000, DEBUG_OUTPUT_INTERVAL_MS,          LEGACY),
+  PARAM_U32(10, status_check_interval_ms,          1000, 30000, STATUS_CHECK_INTERVAL_MS,          LEGACY),
+  PARAM_U32(11, performance_report_interval_ms,    5000, 60000, PERFORMANCE_REPORT_INTERVAL_MS,    LEGACY),
+  PARAM_U32(12, critical_error_report_interval_ms,  500, 10000, CRITICAL_ERROR_REPORT_INTERVAL_MS, LEGACY),
+  // Signal processing
+  PARAM_U32(13, distance_deadband_threshold_cm,       1,    10, DISTANCE_DEADBAND_THRESHOLD_CM,    LEGACY),
+  PARAM_F32(14, velocity_deadband_threshold_cm_s,  0.1f,  5.0f, VELOCITY_DEADBAND_THRESHOLD_CM_S,  LEGACY),
+  // Dual-sensor voting
+  PARAM_U32(15, fusion_time_window_us,              100, 20000, FUSION_TIME_WINDOW_US,             0),
+  PARAM_U32(16, fusion_distance_window_cm,            1,   500, FUSION_DISTANCE_WINDOW_CM,         0),
+};
+
+#undef LEGACY
+#undef RESTART
+
+/** @brief Number of entries in param_table. */
+static constexpr uint8_t PARAM_TABLE_SIZE = sizeof(param_table) / sizeof(param_table[0]);
+
+/**
+ * @brief Compile-time check of one entry's range and default.
+ */
+static constexpr bool paramEntryValid(const ParamDescriptor& p) {
+  return p.id != 0 &&
+         p.offset + 4u <= offsetof(GlobalConfiguration, checksum) &&
+         (p.type == PARAM_TYPE_U32
+            ? (p.min.u32 <= p.def.u32 && p.def.u32 <= p.max.u32)
+            : (p.min.f32 <= p.def.f32 && p.def.f32 <= p.max.f32));
+}
+
+/**
+ * @brief Compile-time check of the whole table.
+ */
+static constexpr bool paramTableValid() {
+  for (uint8_t i = 0; i < PARAM_TABLE_SIZE; i++) {
+    if (!paramEntryValid(param_table[i])) return false;
+    for (uint8_t j = i + 1; j < PARAM_TABLE_SIZE; j++) {
+      if (param_table[i].id == param_table[j].id || param_table[i].offset == param_table[j].offset) return false;
+    }
+  }
+  return true;
+}
+
+static_assert(paramTableValid(), "Parameter table has a duplicate ID or field, or a default outside its range");
+
+/**
+ * @brief Gets the number of runtime parameters.
+ * @return The number of entries in the parameter table.
+ */
+uint8_t paramCount() {
+  return PARAM_TABLE_SIZE;
+}
+
+/**
+ * @brief Gets a parameter by table position.
+ * @param index The table index; must be less than paramCount().
+ * @return The parameter descriptor.
+ */
+const ParamDescriptor& paramAt(uint8_t index) {
+  return param_table[index];
+}
+
+/**
+ * @brief Looks up a parameter by ID.
+ * @param id The parameter ID.
+ * @return The parameter descriptor, or nullptr if the ID is unknown.
+ */
+const ParamDescriptor* paramFind(uint8_t id) {
+  for (uint8_t i = 0; i < PARAM_TABLE_SIZE; i++) {
+    if (param_table[i].id == id) return &param_table[i];
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Reads a parameter from a configuration.
+ * @param config The configuration to read.
+ * @param param The parameter to read.
+ * @return The parameter value.
+ */
+ParamValue paramGet(const GlobalConfiguration& config, const ParamDescriptor& param) {
+  ParamValue value;
+  memcpy(&value, (const uint8_t*)&config + param.offset, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief Writes a parameter into a configuration without validating it.
+ * @param config The configuration to modify.
+ * @param param The parameter to write.
+ * @param value The new value.
+ */
+void paramSet(GlobalConfiguration& config, const ParamDescriptor& param, ParamValue value) {
+  memcpy((uint8_t*)&config + param.offset, &value, sizeof(value));
+}
+
+/**
+ * @brief Checks a value against a parameter's range.
+ * @param param The parameter.
+ * @param value The value to check.
+ * @return True if the value is within [min, max]; false for NaN floats.
+ */
+bool paramInRange(const ParamDescriptor& param, ParamValue value) {
+  if (param.type == PARAM_TYPE_F32) {
+    return value.f32 >= param.min.f32 && value.f32 <= param.max.f32;
+  }
+  return value.u32 >= param.min.u32 && value.u32 <= param.max.u32;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file param_registry.h
+ * @brief This file contains the declarations for the runtime parameter registry.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Every runtime-configurable global is described by one entry in a
+ * compile-time table: a stable ID, its type, where it lives in
+ * GlobalConfiguration, its valid range, its default and flags. Defaults,
+ * validation and the GUI parameter commands ('Q' discover, 'K' get, 'k' set)
+ * are all driven by the table, so a new tunable is added in one place and the
+ * host picks it up without a GUI release. IDs are part of the GUI protocol and
+ * must never be reused or renumbered.
+ */
+#ifndef PARAM_REGISTRY_H
+#define PARAM_REGISTRY_H
+
+#include "globals_config.h"
+
+/** @brief Parameter belongs to the fixed 'L'/'l' block, in table order. */
+#define PARAM_FLAG_LEGACY_BLOCK 0x01
+/** @brief Parameter is only read at start-up; a new value takes effect after a reset. */
+#define PARAM_FLAG_RESTART 0x02
+
+/**
+ * @brief Storage type of a parameter. Both types are 4 bytes on the wire (little-endian).
+ */
+enum ParamType : uint8_t {
+  PARAM_TYPE_U32 = 0,
+  PARAM_TYPE_F32 = 1
+};
+
+/**
+ * @brief A parameter value; the member in use is given by the parameter's ParamType.
+ */
+union ParamValue {
+  uint32_t u32;
+  float f32;
+
+  constexpr ParamValue() : u32(0) {}
+  constexpr ParamValue(uint32_t value) : u32(value) {}
+  constexpr ParamValue(float value) : f32(value) {}
+};
+
+/**
+ * @brief Describes one runtime parameter.
+ */
+struct ParamDescriptor {
+  uint8_t id;         ///< Stable parameter ID used by the GUI protocol.
+  ParamType type;     ///< Storage type.
+  uint8_t flags;      ///< PARAM_FLAG_* bits.
+  uint16_t offset;    ///< Offset of the field in GlobalConfiguration.
+  ParamValue min;     ///< Smallest valid value.
+  ParamValue max;     ///< Largest valid value.
+  ParamValue def;     ///< Default value.
+  const char* name;   ///< Field name, as shown by the host.
+};
+
+uint8_t paramCount();
+const ParamDescriptor& paramAt(uint8_t index);
+const ParamDescriptor* paramFind(uint8_t id);
+ParamValue paramGet(const GlobalConfiguration& config, const ParamDescriptor& param);
+void paramSet(GlobalConfiguration& config, const ParamDescriptor& param, ParamValue value);
+bool paramInRange(const ParamDescriptor& param, ParamValue value);
+
+#endif // PARAM_REGISTRY_H
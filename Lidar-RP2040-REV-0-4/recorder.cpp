@@ -0,0 +1,313 @@
+/**
+ * @file recorder.cpp
+ * @brief This file contains the implementation of the flash frame recorder.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Everything here runs on Core 1, so the RAM pages need no locking.
+ * recorderRecord() only encodes into RAM; all flash work happens in
+ * recorderService(). A sector is written header page last, so a sector cut
+ * short by a reset or power loss has no valid header and is ignored.
+ *
+ * The RP2040 cannot execute from flash while a sector is being erased, so an
+ * erase pauses both cores for tens of ms, long enough for the UART FIFOs to
+ * overflow. Recording therefore never erases: it only programs sectors that
+ * are already blank and stops once it reaches one that is not, leaving the log
+ * full until it is erased with 'H'. That erase runs only outside normal
+ * operation, and its completion arms the next capture. Page programs take well
+ * under a millisecond. The RAM pages cover Core 1 falling behind while flash
+ * is busy; frames are only dropped here if all of them are waiting. Frames
+ * lost before they reach Core 1 are estimated from the gaps in each sensor's
+ * timestamps and counted as missed.
+ */
+
+#include "recorder.h"
+
+#if ENABLE_FRAME_RECORDER
+
+#include "crc.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
+
+/** @brief Sector index meaning "none". */
+#define RECORDER_NO_SECTOR 0xFFFF
+
+/**
+ * @brief A RAM page, laid out exactly as the flash sector it will be written to.
+ */
+struct RecorderPage {
+  RecorderSectorHeader header;
+  uint8_t data[FLASH_SECTOR_SIZE - sizeof(RecorderSectorHeader)];
+};
+
+static_assert(sizeof(RecorderPage) == FLASH_SECTOR_SIZE, "Recorder page must be exactly one flash sector");
+
+static RecorderPage recorder_pages[RECORDER_RAM_PAGES] __attribute__((aligned(4)));
+static FrameCodecState recorder_codec;         ///< Encoder state; reset at the start of every page.
+static uint8_t recorder_flush_page = 0;        ///< Oldest full page waiting for flash.
+static uint8_t recorder_full_pages = 0;        ///< Full pages waiting for flash.
+static uint16_t recorder_sector_count = 0;     ///< Sectors in the log; 0 = recorder disabled.
+static uint16_t recorder_write_sector = 0;     ///< Sector the next page goes to.
+static uint16_t recorder_newest_sector = RECORDER_NO_SECTOR;
+static uint32_t recorder_next_sequence = 1;
+static uint8_t recorder_program_step = 0;      ///< 0 = sector not started, else the next 256-byte page to program.
+static bool recorder_erase_requested = false;
+static bool recorder_log_full = false;         ///< The next sector is not blank; recording waits for an erase.
+static uint16_t recorder_erase_cursor = RECORDER_NO_SECTOR;  ///< Next sector of a log erase.
+static RecorderStats recorder_stats;
+static uint32_t recorder_last_timestamp[MAX_LIDAR_SENSORS];  ///< Previous frame per sensor; 0 = none yet.
+static uint32_t recorder_interval_us[MAX_LIDAR_SENSORS];     ///< Running average frame interval per sensor.
+
+/**
+ * @brief Gets a sector's offset in the flash region.
+ */
+static uint32_t sectorOffset(uint16_t sector) {
+  return FLASH_REGION_RECORDER_OFFSET + (uint32_t)sector * FLASH_SECTOR_SIZE;
+}
+
+/**
+ * @brief Gets a sector's header through the XIP window.
+ */
+static const RecorderSectorHeader* sectorHeader(uint16_t sector) {
+  return (const RecorderSectorHeader*)flashRegionData(sectorOffset(sector));
+}
+
+/**
+ * @brief Scans the log for the newest sector so recording continues after it.
+ *
+ * @details Call once before normal operation starts. The log takes
+ * RECORDER_FLASH_SIZE, or whatever the flash layout leaves after the config
+ * store if that is less.
+ */
+void recorderInit() {
+  uint32_t region = flashRegionSize();
+  uint32_t available = region > FLASH_REGION_RECORDER_OFFSET ? region - FLASH_REGION_RECORDER_OFFSET : 0;
+  recorder_sector_count = min((uint32_t)RECORDER_FLASH_SIZE, available) / FLASH_SECTOR_SIZE;
+  if (recorder_sector_count < 2) {
+    recorder_sector_count = 0;
+    if (LOG_INFO_ENABLED()) safeSerialPrintln("Core 1: Frame recorder disabled - flash layout has no room for the log");
+    return;
+  }
+
+  for (uint16_t sector = 0; sector < recorder_sector_count; sector++) {
+    const RecorderSectorHeader* header = sectorHeader(sector);
+    if (header->magic != RECORDER_SECTOR_MAGIC) continue;
+    if (recorder_newest_sector == RECORDER_NO_SECTOR ||
+        (int32_t)(header->sequence - sectorHeader(recorder_newest_sector)->sequence) > 0) {
+      recorder_newest_sector = sector;
+    }
+  }
+  if (recorder_newest_sector != RECORDER_NO_SECTOR) {
+    recorder_write_sector = (recorder_newest_sector + 1) % recorder_sector_count;
+    recorder_next_sequence = sectorHeader(recorder_newest_sector)->sequence + 1;
+  }
+  recorder_log_full = !flashRegionBlank(sectorOffset(recorder_write_sector), FLASH_SECTOR_SIZE);
+  if (LOG_DEBUG_ENABLED()) {
+    safeSerialPrintfln("Core 1: Frame recorder - %u sectors, continuing at sector %u (sequence %lu)%s",
+                       recorder_sector_count, recorder_write_sector, recorder_next_sequence,
+                       recorder_log_full ? ", log full" : "");
+  }
+}
+
+/**
+ * @brief Counts the frames a sensor lost before they reached Core 1.
+ *
+ * @details A gap of more than 1.5 frame intervals since the sensor's previous
+ * frame counts as the frames that would have filled it. The interval is a
+ * running average of the gaps that were not counted, so it follows the
+ * configured frame rate without being pulled up by the gaps themselves.
+ */
+static void countMissedFrames(const LidarFrame& frame) {
+  if (frame.sensor_id >= MAX_LIDAR_SENSORS) return;
+  uint32_t& last = recorder_last_timestamp[frame.sensor_id];
+  uint32_t& interval = recorder_interval_us[frame.sensor_id];
+  uint32_t gap = frame.timestamp - last;
+  if (last != 0 && gap != 0) {
+    if (interval == 0) {
+      interval = gap;
+    } else if (gap > interval + interval / 2) {
+      recorder_stats.frames_missed += (gap + interval / 2) / interval - 1;
+    } else {
+      interval = (uint32_t)((int32_t)interval + ((int32_t)gap - (int32_t)interval) / 8);
+    }
+  }
+  last = frame.timestamp ? frame.timestamp : 1;
+}
+
+/**
+ * @brief Encodes one frame into the current RAM page.
+ *
+ * @details Takes a few hundred cycles and never touches flash. When the page
+ * cannot hold another worst-case frame it is queued for recorderService().
+ *
+ * @param frame The frame as popped from its sensor queue.
+ */
+void recorderRecord(const LidarFrame& frame) {
+  if (recorder_sector_count == 0) return;
+  countMissedFrames(frame);
+  if (recorder_log_full || recorder_erase_requested || recorder_erase_cursor != RECORDER_NO_SECTOR) return;
+  if (recorder_full_pages == RECORDER_RAM_PAGES) {
+    recorder_stats.frames_dropped++;
+    return;
+  }
+
+  RecorderPage& page = recorder_pages[(recorder_flush_page + recorder_full_pages) % RECORDER_RAM_PAGES];
+  if (page.header.frame_count == 0) {
+    memset(&page, 0xFF, sizeof(page));
+    memset(&page.header, 0, sizeof(page.header));
+    frameCodecReset(recorder_codec);
+  }
+
+  size_t bytes = frameCodecEncode(recorder_codec, frame, page.data + page.header.data_bytes);
+  page.header.data_bytes += bytes;
+  page.header.frame_count++;
+  recorder_stats.frames_recorded++;
+  recorder_stats.encoded_bytes += bytes;
+
+  if ((uint32_t)page.header.data_bytes + FRAME_CODEC_MAX_FRAME_BYTES > sizeof(page.data)) {
+    page.header.magic = RECORDER_SECTOR_MAGIC;
+    page.header.format = RECORDER_FORMAT_VERSION;
+    page.header.crc = crc32(page.data, page.header.data_bytes);
+    recorder_full_pages++;
+  }
+}
+
+/**
+ * @brief Performs one step of a log erase, skipping sectors that are already blank.
+ */
+static void eraseStep() {
+  uint32_t offset = sectorOffset(recorder_erase_cursor);
+  if (!flashRegionBlank(offset, FLASH_SECTOR_SIZE)) {
+    flashRegionErase(offset, FLASH_SECTOR_SIZE);
+    recorder_stats.sectors_erased++;
+  }
+  if (++recorder_erase_cursor == recorder_sector_count) {
+    recorder_erase_cursor = RECORDER_NO_SECTOR;
+    recorder_write_sector = 0;
+    recorder_newest_sector = RECORDER_NO_SECTOR;
+    recorder_log_full = false;
+    if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Frame recorder log erased, recording armed");
+  }
+}
+
+/**
+ * @brief Does the next piece of background flash work. Called from the Core 1 loop.
+ *
+ * @details Each call performs at most one flash operation: one sector of a
+ * log erase, or one 256-byte page program. Pages beyond the encoded data are
+ * left erased. A log erase waits while the system is running, and recording
+ * stops at the first sector that is not blank instead of erasing it.
+ */
+void recorderService() {
+  if (recorder_program_step == 0 && current_state != STATE_RUNNING) {
+    if (recorder_erase_requested) {
+      recorder_erase_requested = false;
+      recorder_erase_cursor = 0;
+    }
+    if (recorder_erase_cursor != RECORDER_NO_SECTOR) {
+      eraseStep();
+      return;
+    }
+  }
+  if (recorder_full_pages == 0) return;
+
+  RecorderPage& page = recorder_pages[recorder_flush_page];
+  uint32_t offset = sectorOffset(recorder_write_sector);
+  uint8_t pages_used = (sizeof(RecorderSectorHeader) + page.header.data_bytes + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+
+  if (recorder_program_step == 0) {
+    if (!flashRegionBlank(offset, FLASH_SECTOR_SIZE)) {
+      // Out of erased space: discard the waiting pages rather than stall the cores
+      recorder_log_full = true;
+      for (uint8_t i = 0; i < RECORDER_RAM_PAGES; i++) recorder_pages[i].header.frame_count = 0;
+      recorder_full_pages = 0;
+      if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Frame recorder log full - erase it with 'H' to record again");
+      return;
+    }
+    page.header.sequence = recorder_next_sequence;
+    recorder_program_step = 1;
+    return;
+  }
+
+  if (recorder_program_step < pages_used) {
+    uint32_t page_offset = (uint32_t)recorder_program_step * FLASH_PAGE_SIZE;
+    flashRegionProgram(offset + page_offset, (const uint8_t*)&page + page_offset, FLASH_PAGE_SIZE);
+    recorder_program_step++;
+    return;
+  }
+
+  // Header page last: only a completely written sector becomes part of the log
+  flashRegionProgram(offset, (const uint8_t*)&page, FLASH_PAGE_SIZE);
+  recorder_program_step = 0;
+  recorder_newest_sector = recorder_write_sector;
+  recorder_write_sector = (recorder_write_sector + 1) % recorder_sector_count;
+  recorder_next_sequence++;
+  recorder_stats.sectors_written++;
+
+  page.header.frame_count = 0;
+  recorder_flush_page = (recorder_flush_page + 1) % RECORDER_RAM_PAGES;
+  recorder_full_pages--;
+}
+
+/**
+ * @brief Starts erasing the whole log in the background.
+ *
+ * @details The erase runs one sector per recorderService() call once the
+ * sector being written is complete, and only while the system is not running.
+ * Recording pauses until it finishes and then starts again at sector 0.
+ */
+void recorderEraseLog() {
+  recorder_erase_requested = recorder_sector_count > 0;
+}
+
+/**
+ * @brief Checks whether recording has stopped for lack of erased flash.
+ * @return True until the log is erased.
+ */
+bool recorderLogFull() {
+  return recorder_log_full;
+}
+
+/**
+ * @brief Gets the number of sectors in the log.
+ * @return The sector count; 0 if the recorder has no flash.
+ */
+uint16_t recorderSectorCount() {
+  return recorder_sector_count;
+}
+
+/**
+ * @brief Gets the most recently written sector.
+ * @return The sector index, or 0xFFFF if the log is empty.
+ */
+uint16_t recorderNewestSector() {
+  return recorder_newest_sector;
+}
+
+/**
+ * @brief Checks for pending background flash work.
+ * @return True while a log erase is running or pages are waiting for flash.
+ */
+bool recorderBusy() {
+  return recorder_erase_requested || recorder_erase_cursor != RECORDER_NO_SECTOR || recorder_full_pages > 0;
+}
+
+/**
+ * @brief Gets a sector's contents through the XIP window.
+ * @param sector The sector index; must be less than recorderSectorCount().
+ * @return The FLASH_SECTOR_SIZE bytes of the sector, starting with its header.
+ */
+const uint8_t* recorderSectorData(uint16_t sector) {
+  return flashRegionData(sectorOffset(sector));
+}
+
+/**
+ * @brief Gets the recorder counters.
+ * @return The counters since boot.
+ */
+const RecorderStats& recorderGetStats() {
+  return recorder_stats;
+}
+
+#endif // ENABLE_FRAME_RECORDER
@@ -0,0 +1,81 @@
+/**
+ * @file recorder.h
+ * @brief This file contains the declarations for the flash frame recorder.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details In normal operation every frame popped by Core 1 is encoded with
+ * the frame codec (frame_codec.h) into a 4 KiB page in RAM. Full pages are
+ * written to the recorder log in the flash filesystem region (see
+ * flash_region.h) by recorderService(), one 256-byte page program per call.
+ * The log is a circular sequence of sectors: each new sector goes after the
+ * newest one. Every sector decodes on its own, so the log survives resets and
+ * can be downloaded with the 'H' GUI command (tools/recorder_dump.py).
+ *
+ * Recording only fills erased sectors. When it comes round to a written one
+ * the log is full and recording stops, keeping the multi-millisecond sector
+ * erases out of normal operation; an 'H' erase in config mode clears the log
+ * and arms the next capture. Each capture therefore costs at most one erase
+ * per sector, so the flash's rated 100k erase cycles allow about 100k full
+ * captures rather than being used up by continuous wrapping.
+ */
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "globals.h"
+#include "flash_region.h"
+#include "frame_codec.h"
+
+/** @brief Marks a written recorder sector ("LREC"). */
+#define RECORDER_SECTOR_MAGIC 0x4345524CUL
+/** @brief Frame encoding used in the sector; bumped when the encoding changes. */
+#define RECORDER_FORMAT_VERSION 2
+
+/**
+ * @brief Header at the start of every recorder sector (20 bytes, little-endian).
+ *
+ * @details The encoded frames follow the header. The codec state is reset at
+ * the start of every sector, so each sector opens with a keyframe per sensor
+ * and decodes on its own.
+ */
+struct RecorderSectorHeader {
+  uint32_t magic;        ///< RECORDER_SECTOR_MAGIC.
+  uint32_t sequence;     ///< Increments by one per written sector; orders the log.
+  uint32_t crc;          ///< CRC-32 of the encoded frames.
+  uint16_t data_bytes;   ///< Bytes of encoded frames after the header.
+  uint16_t frame_count;  ///< Frames in the sector.
+  uint8_t format;        ///< RECORDER_FORMAT_VERSION.
+  uint8_t reserved[3];   ///< Zero.
+};
+
+/**
+ * @brief Recorder counters since boot.
+ */
+struct RecorderStats {
+  uint32_t frames_recorded;   ///< Frames encoded into RAM pages.
+  uint32_t frames_dropped;    ///< Frames lost because every RAM page was waiting for flash.
+  uint32_t encoded_bytes;     ///< Encoded frame bytes, excluding sector headers.
+  uint32_t sectors_written;   ///< Sectors programmed.
+  uint32_t sectors_erased;    ///< Sector erases performed (blank sectors are skipped).
+  uint32_t frames_missed;     ///< Frames estimated lost before Core 1, from gaps in the sensor timestamps.
+};
+
+#if ENABLE_FRAME_RECORDER
+void recorderInit();
+void recorderRecord(const LidarFrame& frame);
+void recorderService();
+void recorderEraseLog();
+bool recorderLogFull();
+uint16_t recorderSectorCount();
+uint16_t recorderNewestSector();
+bool recorderBusy();
+const uint8_t* recorderSectorData(uint16_t sector);
+const RecorderStats& recorderGetStats();
+#else
+inline void recorderInit() {}
+inline void recorderRecord(const LidarFrame&) {}
+inline void recorderService() {}
+#endif
+
+#endif // RECORDER_H
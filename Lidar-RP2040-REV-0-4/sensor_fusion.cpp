@@ -0,0 +1,158 @@
+/**
+ * @file sensor_fusion.cpp
+ * @brief This file contains the implementation of the DualSensorFusion class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements timestamp alignment, distance voting and the single-sensor
+ * fallback for two sensors covering the same zone.
+ */
+
+#include "sensor_fusion.h"
+#include "globals_config.h"
+#include "binlog.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
+
+/**
+ * @brief Hands a frame and its per-sensor velocity to the fusion stage.
+ * @param slot 0 for sensor A, 1 for sensor B.
+ * @param frame The frame.
+ * @param velocity The velocity estimated from that sensor's history.
+ */
+void DualSensorFusion::offer(uint8_t slot, const LidarFrame& frame, float velocity) {
+  pending[slot] = frame;
+  pending_velocity[slot] = velocity;
+  has_pending[slot] = true;
+  last_arrival_ms[slot] = millis();
+}
+
+/**
+ * @brief Re-evaluates sensor health and switches between dual and single-sensor mode.
+ *
+ * @details A sensor is degraded when no frame of it has been offered or seen
+ * queued for FUSION_SENSOR_TIMEOUT_MS. Degradation of either sensor switches to single-sensor
+ * mode on the other; voting resumes as soon as both deliver frames again.
+ *
+ * @param now_ms The current millis() value.
+ */
+void DualSensorFusion::updateMode(uint32_t now_ms) {
+  bool healthy_a = safeMillisElapsed(last_arrival_ms[0], now_ms) <= FUSION_SENSOR_TIMEOUT_MS;
+  bool healthy_b = safeMillisElapsed(last_arrival_ms[1], now_ms) <= FUSION_SENSOR_TIMEOUT_MS;
+
+  FusionMode new_mode;
+  if (healthy_a && healthy_b) new_mode = FUSION_DUAL;
+  else if (healthy_a) new_mode = FUSION_SINGLE_A;
+  else if (healthy_b) new_mode = FUSION_SINGLE_B;
+  else new_mode = FUSION_NO_SENSOR;
+
+  if (new_mode != mode) {
+    // Runs in the frame path: deferred through the binary log
+    if (LOG_DEBUG_ENABLED()) binlog(BLOG_FUSION_MODE, (uint8_t)mode, (uint8_t)new_mode);
+    mode = new_mode;
+    stats.mode_changes++;
+  }
+}
+
+/**
+ * @brief Emits one sensor's pending frame as a single-sensor sample.
+ * @param slot The sensor slot to emit.
+ * @param out Receives the sample.
+ */
+void DualSensorFusion::emitSingle(uint8_t slot, FusedSample& out) {
+  out.timestamp = pending[slot].timestamp;
+  out.distance = pending[slot].distance;
+  out.strength = pending[slot].strength;
+  out.velocity = pending_velocity[slot];
+  out.agreed = false;
+  out.sources = 1 << slot;
+  has_pending[slot] = false;
+  stats.single_samples++;
+}
+
+/**
+ * @brief Tries to produce the next fused sample.
+ *
+ * @details In dual mode a sample is produced only when both sensors have a pending
+ * frame whose timestamps differ by at most the configured time window. The older
+ * frame of a pair that is too far apart is discarded as unmatched. A frame
+ * whose partner has not arrived within twice the window (the slack covers the
+ * partner's trip through Core 0's queue) is emitted alone, so one sensor going
+ * quiet does not hold the other back until the mode changes. The fused
+ * distance and velocity are the means of the two sensors; `agreed` is set when the
+ * distances differ by at most the configured distance window. In single-sensor
+ * mode the healthy sensor's frames pass through unchanged.
+ *
+ * @param now_ms The current millis() value, used for sensor health.
+ * @param out Receives the sample.
+ * @return True if a sample was produced.
+ */
+bool DualSensorFusion::fuse(uint32_t now_ms, FusedSample& out) {
+  uint32_t start_cycles = rp2040.getCycleCount();
+  bool produced = false;
+
+  updateMode(now_ms);
+
+  switch (mode) {
+    case FUSION_DUAL:
+      if (has_pending[0] && has_pending[1]) {
+        int32_t dt = (int32_t)(pending[0].timestamp - pending[1].timestamp);
+        uint32_t abs_dt = (dt < 0) ? (uint32_t)(-dt) : (uint32_t)dt;
+        if (abs_dt > RUNTIME_FUSION_TIME_WINDOW_US) {
+          // The older frame has no partner within the window
+          has_pending[(dt < 0) ? 0 : 1] = false;
+          stats.unmatched++;
+          break;
+        }
+
+        int32_t dd = (int32_t)pending[0].distance - (int32_t)pending[1].distance;
+        out.timestamp = (dt < 0) ? pending[1].timestamp : pending[0].timestamp;
+        out.distance = (uint16_t)(((uint32_t)pending[0].distance + pending[1].distance) / 2);
+        out.strength = min(pending[0].strength, pending[1].strength);
+        out.velocity = (pending_velocity[0] + pending_velocity[1]) * 0.5f;
+        out.agreed = (uint32_t)abs(dd) <= RUNTIME_FUSION_DISTANCE_WINDOW_CM;
+        out.sources = 0x03;
+        has_pending[0] = has_pending[1] = false;
+
+        stats.pairs++;
+        if (out.agreed) stats.agreements++;
+        else stats.disagreements++;
+        produced = true;
+      } else if (has_pending[0] != has_pending[1]) {
+        uint8_t slot = has_pending[0] ? 0 : 1;
+        if (micros() - pending[slot].timestamp > 2 * RUNTIME_FUSION_TIME_WINDOW_US) {
+          emitSingle(slot, out);
+          produced = true;
+        }
+      }
+      break;
+
+    case FUSION_SINGLE_A:
+      has_pending[1] = false;
+      if (has_pending[0]) {
+        emitSingle(0, out);
+        produced = true;
+      }
+      break;
+
+    case FUSION_SINGLE_B:
+      has_pending[0] = false;
+      if (has_pending[1]) {
+        emitSingle(1, out);
+        produced = true;
+      }
+      break;
+
+    case FUSION_NO_SENSOR:
+      has_pending[0] = has_pending[1] = false;
+      break;
+  }
+
+  if (produced) {
+    uint32_t cycles = rp2040.getCycleCount() - start_cycles;
+    stats.cycles_total += cycles;
+    if (cycles > stats.cycles_max) stats.cycles_max = cycles;
+  }
+  return produced;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file sensor_fusion.h
+ * @brief This file contains the declaration of the DualSensorFusion class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details The fusion stage pairs frames from two sensors aimed at the same zone by
+ * timestamp and produces one fused distance/velocity sample per pair, together
+ * with whether the two sensors agreed. When one sensor stops delivering frames
+ * the stage falls back to passing the healthy sensor's frames through alone.
+ * Sensor health follows frame arrivals, so a sensor whose frame is waiting for
+ * a partner is not mistaken for a dead one.
+ */
+#ifndef SENSOR_FUSION_H
+#define SENSOR_FUSION_H
+
+#include "globals.h"
+
+/**
+ * @brief Defines the operating modes of the fusion stage.
+ */
+enum FusionMode {
+  FUSION_DUAL,        ///< Both sensors healthy - samples require a matched pair.
+  FUSION_SINGLE_A,    ///< Sensor B degraded - sensor A frames pass through alone.
+  FUSION_SINGLE_B,    ///< Sensor A degraded - sensor B frames pass through alone.
+  FUSION_NO_SENSOR    ///< Both sensors degraded - no samples are produced.
+};
+
+/**
+ * @brief One output sample of the fusion stage.
+ */
+struct FusedSample {
+  uint32_t timestamp;   ///< Timestamp of the newer frame of the pair, in microseconds.
+  uint16_t distance;    ///< Fused distance in centimeters.
+  uint16_t strength;    ///< Weaker of the two signal strengths.
+  float velocity;       ///< Fused velocity in cm/s.
+  bool agreed;          ///< True if both sensors saw the target within the distance window.
+  uint8_t sources;      ///< Bitmask of the sensors that contributed (bit 0 = A, bit 1 = B).
+};
+
+/**
+ * @brief Agreement and cost statistics of the fusion stage.
+ */
+struct FusionStats {
+  uint32_t pairs;             ///< Frame pairs matched within the time window.
+  uint32_t agreements;        ///< Pairs whose distances agreed within the distance window.
+  uint32_t disagreements;     ///< Pairs whose distances did not agree.
+  uint32_t unmatched;         ///< Frames dropped because no partner arrived within the time window.
+  uint32_t single_samples;    ///< Samples produced in single-sensor fallback.
+  uint32_t mode_changes;      ///< Number of fusion mode transitions.
+  uint32_t cycles_total;      ///< CPU cycles spent in fuse() across all produced samples.
+  uint32_t cycles_max;        ///< Longest single fuse() call in CPU cycles.
+};
+
+/**
+ * @class DualSensorFusion
+ * @brief Time-aligns and votes on frames from two sensors.
+ *
+ * @details The caller feeds each sensor's frames (with that sensor's own velocity
+ * estimate) through offer() whenever needsFrame() reports a free slot, then calls
+ * fuse() to obtain samples. While a slot is full the caller reports that the
+ * sensor still has frames queued through noteQueued(). Frames are consumed
+ * strictly in timestamp order.
+ */
+class DualSensorFusion {
+private:
+  LidarFrame pending[2];          ///< Next unconsumed frame of each sensor.
+  float pending_velocity[2];      ///< Velocity estimate belonging to each pending frame.
+  bool has_pending[2] = { false, false };
+  uint32_t last_arrival_ms[2] = { 0, 0 };  ///< When each sensor last had a frame offered or queued.
+  FusionMode mode = FUSION_DUAL;
+  FusionStats stats = {};
+
+  void updateMode(uint32_t now_ms);
+  void emitSingle(uint8_t slot, FusedSample& out);
+
+public:
+  /**
+   * @brief Checks whether the fusion stage can accept another frame from a sensor.
+   * @param slot 0 for sensor A, 1 for sensor B.
+   * @return True if the slot is empty.
+   */
+  bool needsFrame(uint8_t slot) const { return !has_pending[slot]; }
+
+  /**
+   * @brief Hands a frame and its per-sensor velocity to the fusion stage.
+   * @param slot 0 for sensor A, 1 for sensor B.
+   * @param frame The frame.
+   * @param velocity The velocity estimated from that sensor's history.
+   */
+  void offer(uint8_t slot, const LidarFrame& frame, float velocity);
+
+  /**
+   * @brief Records that a sensor has frames waiting in its queue behind its pending frame.
+   * @param slot 0 for sensor A, 1 for sensor B.
+   * @param now_ms The current millis() value.
+   */
+  void noteQueued(uint8_t slot, uint32_t now_ms) { last_arrival_ms[slot] = now_ms; }
+
+  /**
+   * @brief Tries to produce the next fused sample.
+   * @param now_ms The current millis() value, used for sensor health.
+   * @param out Receives the sample.
+   * @return True if a sample was produced.
+   */
+  bool fuse(uint32_t now_ms, FusedSample& out);
+
+  /**
+   * @brief Gets the current fusion mode.
+   * @return The fusion mode.
+   */
+  FusionMode getMode() const { return mode; }
+
+  /**
+   * @brief Gets the accumulated statistics.
+   * @return The fusion statistics.
+   */
+  const FusionStats& getStats() const { return stats; }
+};
+
+#endif // SENSOR_FUSION_H
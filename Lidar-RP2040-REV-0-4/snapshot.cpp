@@ -0,0 +1,343 @@
+/**
+ * @file snapshot.cpp
+ * @brief This file contains the implementation of trigger snapshot capture.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Everything here runs on Core 1. There are SNAPSHOT_RAM_SLOTS + 1
+ * records: one is the capture ring, the others hold frozen snapshots, newest
+ * first. Freezing moves the capture pointer to the front of the frozen list
+ * and takes the oldest record (or an unused one) as the new ring; no samples
+ * are copied.
+ *
+ * Writing a snapshot to flash follows the frame recorder: one sector erase or
+ * one 256-byte page program per snapshotService() call, header page last, so
+ * a write cut short by a reset leaves no valid record.
+ */
+
+#include "snapshot.h"
+
+#if ENABLE_TRIGGER_SNAPSHOTS
+
+#include "crc.h"
+#include "storage.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_CORE1
+#include "log.h"
+
+static_assert(sizeof(SnapshotSample) == 16, "SnapshotSample is part of the 'N' protocol");
+static_assert(sizeof(SnapshotHeader) == 68, "SnapshotHeader is part of the 'N' protocol");
+static_assert(sizeof(SnapshotRecord) <= FLASH_REGION_SNAPSHOT_SLOT_SIZE, "Snapshot record does not fit its flash slot");
+static_assert(SNAPSHOT_RAM_SLOTS >= 1, "At least one RAM slot is needed to freeze into");
+static_assert(SNAPSHOT_RING_SIZE <= 0xFFFF, "Snapshot ring indices are 16-bit");
+
+static SnapshotRecord snapshot_records[SNAPSHOT_RAM_SLOTS + 1] __attribute__((aligned(4)));
+static SnapshotRecord* snapshot_capture = &snapshot_records[0];  ///< The ring being written.
+static SnapshotRecord* snapshot_frozen[SNAPSHOT_RAM_SLOTS];     ///< Frozen snapshots, newest first.
+static uint8_t snapshot_frozen_count = 0;
+static uint16_t snapshot_write = 0;            ///< Ring index of the next sample.
+static uint16_t snapshot_filled = 0;           ///< Samples in the ring.
+static bool snapshot_triggered = false;        ///< A post-trigger capture is running.
+static uint16_t snapshot_post_remaining = 0;   ///< Samples still to capture after the trigger.
+static uint32_t snapshot_next_sequence = 1;
+static SnapshotStats snapshot_stats;
+
+#if SNAPSHOT_FLASH_SLOTS > 0
+/** @brief Flash pages holding one record. */
+#define SNAPSHOT_RECORD_PAGES ((sizeof(SnapshotRecord) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE)
+/** @brief Sectors per flash slot. */
+#define SNAPSHOT_SLOT_SECTORS (FLASH_REGION_SNAPSHOT_SLOT_SIZE / FLASH_SECTOR_SIZE)
+
+static uint8_t snapshot_flash_slots = 0;              ///< Usable flash slots; 0 if the flash layout has no room.
+static uint8_t snapshot_flash_next = 0;               ///< Slot the next snapshot is written to.
+static SnapshotRecord* snapshot_persist = nullptr;    ///< RAM record being written to flash.
+static uint16_t snapshot_persist_step = 0;
+static uint32_t snapshot_persisted_sequence = 0;      ///< Newest snapshot written (or being written) to flash.
+static uint8_t snapshot_page_buffer[FLASH_PAGE_SIZE] __attribute__((aligned(4)));
+
+/**
+ * @brief Gets a flash slot's offset in the flash region.
+ */
+static uint32_t slotOffset(uint8_t slot) {
+  return FLASH_REGION_SNAPSHOT_OFFSET + (uint32_t)slot * FLASH_REGION_SNAPSHOT_SLOT_SIZE;
+}
+
+/**
+ * @brief Calculates the CRC-32 stored in a record's header.
+ */
+static uint32_t recordCrc(const SnapshotRecord* record) {
+  const uint8_t* start = (const uint8_t*)&record->header.config_epoch;
+  return crc32(start, (const uint8_t*)(record + 1) - start);
+}
+
+/**
+ * @brief Checks a flash record's marker, layout and CRC-32.
+ */
+static bool flashRecordValid(const SnapshotRecord* record) {
+  return record->header.magic == SNAPSHOT_MAGIC && record->header.format == SNAPSHOT_FORMAT_VERSION &&
+         record->header.capacity == SNAPSHOT_RING_SIZE && record->header.crc == recordCrc(record);
+}
+
+/**
+ * @brief Programs one 256-byte page of the record being written.
+ * @param page The page index within the record.
+ */
+static void programRecordPage(uint16_t page) {
+  uint32_t page_offset = (uint32_t)page * FLASH_PAGE_SIZE;
+  const uint8_t* data = (const uint8_t*)snapshot_persist + page_offset;
+  if (page_offset + FLASH_PAGE_SIZE > sizeof(SnapshotRecord)) {
+    // The record's last page is partial; pad it through a buffer instead of reading past the record
+    memset(snapshot_page_buffer, 0xFF, FLASH_PAGE_SIZE);
+    memcpy(snapshot_page_buffer, data, sizeof(SnapshotRecord) - page_offset);
+    data = snapshot_page_buffer;
+  }
+  flashRegionProgram(slotOffset(snapshot_flash_next) + page_offset, data, FLASH_PAGE_SIZE);
+}
+#endif
+
+/**
+ * @brief Calculates the configuration epoch: the CRC-32 of the current configuration image.
+ */
+static uint32_t configEpoch() {
+  ConfigImage image;
+  buildConfigImage(image);
+  return crc32((const uint8_t*)&image, sizeof(image));
+}
+
+/**
+ * @brief Finishes the capture and makes a free record the new ring.
+ */
+static void freezeCapture() {
+  SnapshotRecord* record = snapshot_capture;
+  SnapshotHeader& header = record->header;
+  header.magic = SNAPSHOT_MAGIC;
+  header.sequence = snapshot_next_sequence++;
+  header.crc = 0;
+  header.capacity = SNAPSHOT_RING_SIZE;
+  header.count = header.trigger_index + 1 + SNAPSHOT_POST_FRAMES;
+  header.format = SNAPSHOT_FORMAT_VERSION;
+
+  SnapshotRecord* next;
+  if (snapshot_frozen_count < SNAPSHOT_RAM_SLOTS) {
+    // Until the list is full the ring is snapshot_records[count] and the records after it are unused
+    next = &snapshot_records[snapshot_frozen_count + 1];
+    snapshot_frozen_count++;
+  } else {
+    next = snapshot_frozen[SNAPSHOT_RAM_SLOTS - 1];
+#if SNAPSHOT_FLASH_SLOTS > 0
+    if (next == snapshot_persist) {
+      snapshot_persist = nullptr;
+      snapshot_stats.persist_aborted++;
+    }
+#endif
+  }
+  for (uint8_t i = snapshot_frozen_count - 1; i > 0; i--) {
+    snapshot_frozen[i] = snapshot_frozen[i - 1];
+  }
+  snapshot_frozen[0] = record;
+
+  snapshot_capture = next;
+  memset(&next->header, 0, sizeof(next->header));
+  snapshot_write = 0;
+  snapshot_filled = 0;
+  snapshot_triggered = false;
+  snapshot_stats.captured++;
+
+  if (LOG_DEBUG_ENABLED()) {
+    safeSerialPrintfln("Core 1: Snapshot %lu - source %u, %u samples (%u before the trigger)",
+                       header.sequence, header.trigger.source, header.count, header.trigger_index);
+  }
+}
+
+/**
+ * @brief Prepares capture and finds the newest snapshot in flash.
+ *
+ * @details Call once before normal operation starts. Snapshot numbers
+ * continue after the newest one in flash.
+ */
+void snapshotInit() {
+#if SNAPSHOT_FLASH_SLOTS > 0
+  if (flashRegionSize() >= FLASH_REGION_SNAPSHOT_OFFSET + FLASH_REGION_SNAPSHOT_SIZE) {
+    snapshot_flash_slots = SNAPSHOT_FLASH_SLOTS;
+  } else {
+    if (LOG_INFO_ENABLED()) safeSerialPrintln("Core 1: Snapshots kept in RAM only - flash layout has no room for them");
+  }
+  uint8_t newest = SNAPSHOT_FLASH_SLOTS;
+  for (uint8_t slot = 0; slot < snapshot_flash_slots; slot++) {
+    const SnapshotRecord* record = (const SnapshotRecord*)flashRegionData(slotOffset(slot));
+    if (!flashRecordValid(record)) continue;
+    if (newest == SNAPSHOT_FLASH_SLOTS ||
+        (int32_t)(record->header.sequence - snapshot_next_sequence) >= 0) {
+      newest = slot;
+      snapshot_next_sequence = record->header.sequence + 1;
+    }
+  }
+  if (newest != SNAPSHOT_FLASH_SLOTS) {
+    snapshot_flash_next = (newest + 1) % snapshot_flash_slots;
+    snapshot_persisted_sequence = snapshot_next_sequence - 1;
+  }
+#endif
+  if (LOG_DEBUG_ENABLED()) {
+    safeSerialPrintfln("Core 1: Trigger snapshots - %u + %u samples, %u RAM slots, next snapshot %lu",
+                       SNAPSHOT_PRE_FRAMES, SNAPSHOT_POST_FRAMES, SNAPSHOT_RAM_SLOTS, snapshot_next_sequence);
+  }
+}
+
+/**
+ * @brief Adds one processed sample to the capture ring.
+ *
+ * @details A struct store and two counter updates per sample; completes the
+ * snapshot once its post-trigger samples are in.
+ *
+ * @param sample The sample.
+ */
+void snapshotRecord(const SnapshotSample& sample) {
+  snapshot_capture->samples[snapshot_write] = sample;
+  if (++snapshot_write == SNAPSHOT_RING_SIZE) snapshot_write = 0;
+  if (snapshot_filled < SNAPSHOT_RING_SIZE) snapshot_filled++;
+  if (snapshot_triggered && --snapshot_post_remaining == 0) freezeCapture();
+}
+
+/**
+ * @brief Marks the most recently recorded sample as a trigger point.
+ *
+ * @details Call on the rising edge of a pipeline's trigger latch, after
+ * recording the sample that caused it.
+ *
+ * @param info The pipeline and estimator state to keep with the snapshot.
+ */
+void snapshotTrigger(const SnapshotTriggerInfo& info) {
+  if (snapshot_triggered) {
+    snapshot_stats.merged++;
+    return;
+  }
+  if (snapshot_filled == 0) return;
+
+  SnapshotHeader& header = snapshot_capture->header;
+  uint16_t trigger_slot = (snapshot_write == 0 ? SNAPSHOT_RING_SIZE : snapshot_write) - 1;
+  uint16_t pre = min((uint16_t)(snapshot_filled - 1), (uint16_t)SNAPSHOT_PRE_FRAMES);
+  header.trigger = info;
+  header.trigger_index = pre;
+  header.first = (trigger_slot + SNAPSHOT_RING_SIZE - pre) % SNAPSHOT_RING_SIZE;
+  header.trigger_timestamp = snapshot_capture->samples[trigger_slot].timestamp;
+  header.config_epoch = configEpoch();
+
+  snapshot_triggered = true;
+  snapshot_post_remaining = SNAPSHOT_POST_FRAMES;
+  if (snapshot_post_remaining == 0) freezeCapture();
+}
+
+/**
+ * @brief Does the next piece of background flash work. Called from the Core 1 loop.
+ *
+ * @details Writes the newest frozen snapshot to the next flash slot, one
+ * step per call: the CRC, then each sector erase (skipped if blank), then
+ * each page program. Without flash slots this does nothing.
+ */
+void snapshotService() {
+#if SNAPSHOT_FLASH_SLOTS > 0
+  if (snapshot_flash_slots == 0) return;
+  if (snapshot_persist == nullptr) {
+    if (snapshot_frozen_count == 0 || snapshot_frozen[0]->header.sequence == snapshot_persisted_sequence) return;
+    snapshot_persist = snapshot_frozen[0];
+    snapshot_persisted_sequence = snapshot_persist->header.sequence;
+    snapshot_persist_step = 0;
+  }
+
+  uint16_t step = snapshot_persist_step++;
+  if (step == 0) {
+    snapshot_persist->header.crc = recordCrc(snapshot_persist);
+  } else if (step <= SNAPSHOT_SLOT_SECTORS) {
+    uint32_t offset = slotOffset(snapshot_flash_next) + (uint32_t)(step - 1) * FLASH_SECTOR_SIZE;
+    if (!flashRegionBlank(offset, FLASH_SECTOR_SIZE)) flashRegionErase(offset, FLASH_SECTOR_SIZE);
+  } else if (step - SNAPSHOT_SLOT_SECTORS < SNAPSHOT_RECORD_PAGES) {
+    programRecordPage(step - SNAPSHOT_SLOT_SECTORS);
+  } else {
+    // Header page last: only a completely written record becomes valid
+    programRecordPage(0);
+    snapshot_flash_next = (snapshot_flash_next + 1) % snapshot_flash_slots;
+    snapshot_persist = nullptr;
+    snapshot_stats.persisted++;
+  }
+#endif
+}
+
+/**
+ * @brief Checks whether a post-trigger capture is running.
+ * @return True between a trigger and the freeze of its snapshot.
+ */
+bool snapshotCapturing() {
+  return snapshot_triggered;
+}
+
+/**
+ * @brief Gets the number of frozen snapshots in RAM.
+ * @return The count, at most SNAPSHOT_RAM_SLOTS.
+ */
+uint8_t snapshotRamCount() {
+  return snapshot_frozen_count;
+}
+
+/**
+ * @brief Gets a frozen snapshot in RAM.
+ * @param index 0 for the newest.
+ * @return The record, or nullptr if there is none at that index.
+ */
+const SnapshotRecord* snapshotRam(uint8_t index) {
+  return index < snapshot_frozen_count ? snapshot_frozen[index] : nullptr;
+}
+
+/**
+ * @brief Finds a frozen snapshot in RAM by its number.
+ *
+ * @details A later freeze moves the RAM indices and recycles the oldest
+ * record as the capture ring, so a record read in pieces is looked up by
+ * number for every piece.
+ *
+ * @param sequence The snapshot number.
+ * @return The record, or nullptr once the snapshot is no longer in RAM.
+ */
+const SnapshotRecord* snapshotRamBySequence(uint32_t sequence) {
+  for (uint8_t i = 0; i < snapshot_frozen_count; i++) {
+    if (snapshot_frozen[i]->header.sequence == sequence) return snapshot_frozen[i];
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Gets the number of flash snapshot slots.
+ * @return The slot count; 0 if snapshots are kept in RAM only.
+ */
+uint8_t snapshotFlashSlots() {
+#if SNAPSHOT_FLASH_SLOTS > 0
+  return snapshot_flash_slots;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Gets a snapshot in flash through the XIP window.
+ * @param slot The flash slot.
+ * @return The record, or nullptr if the slot holds no complete snapshot.
+ */
+const SnapshotRecord* snapshotFlash(uint8_t slot) {
+#if SNAPSHOT_FLASH_SLOTS > 0
+  if (slot >= snapshot_flash_slots) return nullptr;
+  const SnapshotRecord* record = (const SnapshotRecord*)flashRegionData(slotOffset(slot));
+  return record->header.magic == SNAPSHOT_MAGIC ? record : nullptr;
+#else
+  (void)slot;
+  return nullptr;
+#endif
+}
+
+/**
+ * @brief Gets the snapshot counters.
+ * @return The counters since boot.
+ */
+const SnapshotStats& snapshotGetStats() {
+  return snapshot_stats;
+}
+
+#endif // ENABLE_TRIGGER_SNAPSHOTS
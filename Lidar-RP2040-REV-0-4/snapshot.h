@@ -0,0 +1,134 @@
+/**
+ * @file snapshot.h
+ * @brief This file contains the declarations for trigger snapshot capture.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Like a storage oscilloscope: every processed sample (after
+ * decimation, with its velocity and trigger stages) goes into a ring in RAM.
+ * When a pipeline's trigger latch fires, the ring keeps the last
+ * SNAPSHOT_PRE_FRAMES samples, captures SNAPSHOT_POST_FRAMES more and is then
+ * frozen by swapping the capture pointer with a free slot, so freezing costs
+ * the same however large the window is. The snapshot records which pipeline
+ * fired, the estimator state at that moment and the configuration epoch.
+ *
+ * The newest SNAPSHOT_RAM_SLOTS snapshots stay in RAM; with
+ * SNAPSHOT_FLASH_SLOTS set, each is also written to flash in the background
+ * and survives resets. Both are read with the 'N' GUI command, also while
+ * running (tools/snapshot_dump.py). After a freeze the pre-trigger window
+ * refills from empty, and a trigger while a capture is still running is only
+ * counted.
+ */
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "globals.h"
+#include "calculations.h"
+#include "flash_region.h"
+
+/** @brief Marks a snapshot record ("LSNP"). */
+#define SNAPSHOT_MAGIC 0x504E534CUL
+/** @brief Record layout version; bumped when SnapshotHeader or SnapshotSample change. */
+#define SNAPSHOT_FORMAT_VERSION 1
+/** @brief Samples in a snapshot ring: the pre-trigger window, the trigger sample and the post-trigger capture. */
+#define SNAPSHOT_RING_SIZE (SNAPSHOT_PRE_FRAMES + 1 + SNAPSHOT_POST_FRAMES)
+/** @brief SnapshotHeader::source of the fused dual-sensor pipeline. */
+#define SNAPSHOT_SOURCE_FUSED 0x0F
+/** @brief SnapshotHeader::fusion_mode when the source is not the fused pipeline. */
+#define SNAPSHOT_NO_FUSION 0xFF
+
+/**
+ * @brief SnapshotSample::flags bits.
+ * @{
+ */
+#define SNAPSHOT_FLAG_RAW_TRIGGER 0x01    ///< Distance/velocity condition met.
+#define SNAPSHOT_FLAG_DEBOUNCED 0x02      ///< Debouncer output.
+#define SNAPSHOT_FLAG_LATCHED 0x04        ///< Latch output (the pipeline's trigger).
+/** @} */
+
+/**
+ * @brief One processed sample (16 bytes, little-endian).
+ */
+struct SnapshotSample {
+  uint32_t timestamp;    ///< micros() when the frame was received.
+  uint16_t distance;     ///< Distance in centimeters.
+  uint16_t strength;     ///< Signal strength.
+  float velocity;        ///< Estimated velocity in cm/s.
+  uint8_t source;        ///< Sensor index, or SNAPSHOT_SOURCE_FUSED.
+  uint8_t flags;         ///< SNAPSHOT_FLAG_* bits.
+  uint8_t switch_code;   ///< Switch position selecting the thresholds.
+  uint8_t reserved;      ///< Zero.
+};
+
+/**
+ * @brief What the trigger point records besides the samples.
+ */
+struct SnapshotTriggerInfo {
+  uint8_t source;                           ///< Pipeline that fired.
+  uint8_t switch_code;                      ///< Switch position at the trigger.
+  uint8_t load_mode;                        ///< LoadMode of the load scheduler.
+  uint8_t fusion_mode;                      ///< FusionMode, or SNAPSHOT_NO_FUSION.
+  VelocityEstimatorState estimators[2];     ///< The source's estimator; for the fused pipeline sensors 0 and 1.
+};
+
+/**
+ * @brief Header of a snapshot record (68 bytes, little-endian), followed by SNAPSHOT_RING_SIZE samples.
+ *
+ * @details The samples are a ring: chronological sample i is at ring index
+ * (first + i) % capacity, for i < count. Sample trigger_index is the one
+ * that fired the trigger.
+ */
+struct SnapshotHeader {
+  uint32_t magic;             ///< SNAPSHOT_MAGIC once frozen.
+  uint32_t sequence;          ///< Snapshot number; continues across resets when snapshots go to flash.
+  uint32_t crc;               ///< CRC-32 of the record after this field; set when written to flash, else 0.
+  uint32_t config_epoch;      ///< CRC-32 of the configuration image in effect (as reported by 'B').
+  uint32_t trigger_timestamp; ///< micros() of the trigger sample.
+  uint16_t capacity;          ///< SNAPSHOT_RING_SIZE.
+  uint16_t first;             ///< Ring index of the oldest sample.
+  uint16_t count;             ///< Samples in the snapshot.
+  uint16_t trigger_index;     ///< Chronological index of the trigger sample (the pre-trigger sample count).
+  uint8_t format;             ///< SNAPSHOT_FORMAT_VERSION.
+  uint8_t reserved[3];        ///< Zero.
+  SnapshotTriggerInfo trigger;
+};
+
+/**
+ * @brief A snapshot as kept in RAM and flash.
+ */
+struct SnapshotRecord {
+  SnapshotHeader header;
+  SnapshotSample samples[SNAPSHOT_RING_SIZE];
+};
+
+/**
+ * @brief Snapshot counters since boot.
+ */
+struct SnapshotStats {
+  uint32_t captured;        ///< Snapshots frozen.
+  uint32_t merged;          ///< Triggers that fired during another snapshot's post-trigger capture.
+  uint32_t persisted;       ///< Snapshots written to flash.
+  uint32_t persist_aborted; ///< Flash writes abandoned because their RAM slot was reused first.
+};
+
+#if ENABLE_TRIGGER_SNAPSHOTS
+void snapshotInit();
+void snapshotRecord(const SnapshotSample& sample);
+void snapshotTrigger(const SnapshotTriggerInfo& info);
+void snapshotService();
+bool snapshotCapturing();
+uint8_t snapshotRamCount();
+const SnapshotRecord* snapshotRam(uint8_t index);
+const SnapshotRecord* snapshotRamBySequence(uint32_t sequence);
+uint8_t snapshotFlashSlots();
+const SnapshotRecord* snapshotFlash(uint8_t slot);
+const SnapshotStats& snapshotGetStats();
+#else
+inline void snapshotInit() {}
+inline void snapshotRecord(const SnapshotSample&) {}
+inline void snapshotTrigger(const SnapshotTriggerInfo&) {}
+inline void snapshotService() {}
+#endif
+
+#endif // SNAPSHOT_H
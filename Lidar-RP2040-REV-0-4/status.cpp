@@ -12,6 +12,10 @@
 #include "status.h"
 #include "globals.h"
 #include "globals_config.h"
+#include "lidar_sensor.h"
+#include "flash_region.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_STATUS
+#include "log.h"
 
 /**
  * @brief Handles the debug output.
@@ -22,7 +26,7 @@
  */
 void handleDebugOutput() {
     if (safeMillisElapsed(timing_info.last_debug_output, millis()) >= RUNTIME_DEBUG_OUTPUT_INTERVAL_MS) {
-    if (current_state == STATE_RUNNING && isDebugEnabled()) {
+    if (current_state == STATE_RUNNING && LOG_DEBUG_ENABLED()) {
       uint32_t frames_received_local, error_flags_local;
       uint8_t switch_code_local, buffer_count_local;
       bool trigger_output_local;
@@ -39,7 +43,7 @@ void handleDebugOutput() {
       strength_local = core_comm.strength;
       mutex_exit(&comm_mutex);
 
-      buffer_count_local = getBufferUtilization();
+      buffer_count_local = getMaxBufferUtilization();
       safeSerialPrintfln("DEBUG: Velocity=%6.1fcm/s   Strength=%5d   Dist=%4dcm   Errors=0x%02x   Trigger=%s",
         velocity_local, strength_local, distance_local, error_flags_local,
         trigger_output_local ? "ACTIVE" : "INACTIVE");
@@ -82,14 +86,25 @@ void handleStatusLED() {
 /**
  * @brief Reports the status of Core 0.
  *
- * @details This function is a placeholder for reporting the status of Core 0.
- * The implementation has been optimized out in the current version.
+ * @details When debug output is enabled, prints the per-sensor acquisition statistics
+ * of the last one-second window: frame rate, invalid frames, parser time and the
+ * share of Core 0 time spent parsing. This is the load figure used to size
+ * multi-sensor installs.
  */
 void reportCore0Status() {
   static uint32_t last_status_report = 0;
   if (safeMillisElapsed(last_status_report, millis()) >= RUNTIME_STATUS_CHECK_INTERVAL_MS) {
-    if (core0_state == CORE0_READY && isDebugEnabled()) {
-      // Status reporting preserved but optimized
+    if (core0_state == CORE0_READY && LOG_DEBUG_ENABLED()) {
+      uint32_t total_poll_us = 0;
+      for (uint8_t i = 0; i < LIDAR_SENSOR_COUNT; i++) {
+        const LidarSensorStats& stats = lidar_sensors[i]->getStats();
+        total_poll_us += stats.poll_time_us_total;
+        safeSerialPrintfln("Core 0: Sensor %d - %lu fps (%lu invalid), queue %d/%d, parse max %lu us, total %lu us/s",
+          i, stats.frames_per_second, stats.invalid_per_second, getBufferUtilization(i), FRAME_BUFFER_SIZE,
+          stats.poll_time_us_max, stats.poll_time_us_total);
+      }
+      safeSerialPrintfln("Core 0: Parser load %lu.%lu%% of Core 0 across %d sensor(s)",
+        total_poll_us / 10000, (total_poll_us / 1000) % 10, LIDAR_SENSOR_COUNT);
     }
     last_status_report = millis();
   }
@@ -98,14 +113,23 @@ void reportCore0Status() {
 /**
  * @brief Reports the status of Core 1.
  *
- * @details This function is a placeholder for reporting the status of Core 1.
- * The implementation has been optimized out in the current version.
+ * @details When debug output is enabled and the flash was written since the
+ * last report, prints the flash write counters: erases and programs since
+ * boot with the longest stall of each (the time Core 0 was paused), and the
+ * total stall time. This is the worst case the LiDAR UARTs have to ride out.
  */
 void reportCore1Status() {
   static uint32_t last_status_report = 0;
+  static uint32_t reported_flash_writes = 0;
   if (safeMillisElapsed(last_status_report, millis()) >= RUNTIME_STATUS_CHECK_INTERVAL_MS) {
-    if ((current_state == STATE_RUNNING || current_state == STATE_CONFIG) && isDebugEnabled()) {
-      // Status reporting preserved but optimized
+    if ((current_state == STATE_RUNNING || current_state == STATE_CONFIG) && LOG_DEBUG_ENABLED()) {
+      const FlashRegionStats& flash = flashRegionGetStats();
+      uint32_t flash_writes = flash.erases + flash.programs;
+      if (flash_writes != reported_flash_writes) {
+        safeSerialPrintfln("Core 1: Flash - %lu erases (max stall %lu us), %lu programs (max stall %lu us), %lu ms stalled in total",
+          flash.erases, flash.erase_max_us, flash.programs, flash.program_max_us, flash.stall_total_us / 1000);
+        reported_flash_writes = flash_writes;
+      }
     }
     last_status_report = millis();
   }
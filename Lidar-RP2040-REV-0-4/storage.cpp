@@ -13,6 +13,9 @@
 
 #include "storage.h"
 #include "globals_config.h"  // NEW: Include globals configuration
+#include "config_store.h"
+#define LOG_MODULE_FLOOR LOG_FLOOR_STORAGE
+#include "log.h"
 
 /**
  * @brief Loads the default configuration.
@@ -21,7 +24,7 @@
  * This is typically used when no valid configuration is found in storage.
  */
 void loadDefaultConfig() {
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Loading factory default configuration...");
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Loading factory default configuration...");
   uint16_t default_distances[8] = { 50, 100, 200, 300, 400, 500, 600, 700 };
   int16_t default_vel_min[8] = { -2200, -2200, -2200, -2200, -2200, -2200, -2200, -2200 };
   int16_t default_vel_max[8] = { -250, -250, -250, -250, -250, -250, -250, -250 };
@@ -35,7 +38,7 @@ void loadDefaultConfig() {
   memcpy(currentConfig.trigger_rules, default_rules, sizeof(default_rules));
   currentConfig.use_velocity_trigger = true;
   currentConfig.enable_debug = false;
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Factory defaults loaded");
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Factory defaults loaded");
 }
 
 /**
@@ -48,12 +51,12 @@ bool validateConfiguration(const LidarConfiguration& config) {
   for (int i = 0; i < 8; i++) {
     if (config.distance_thresholds[i] < MIN_DISTANCE_CM || 
         config.distance_thresholds[i] > MAX_DISTANCE_CM) {
-      safeSerialPrintfln("Config validation failed: distance[%d] = %d out of range", i, config.distance_thresholds[i]);
+      if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Config validation failed: distance[%d] = %d out of range", i, config.distance_thresholds[i]);
       safeSetErrorFlag(ERROR_FLAG_CONFIG_ERROR, true);
       return false;
     }
     if (config.velocity_min_thresholds[i] > config.velocity_max_thresholds[i]) {
-      safeSerialPrintfln("Config validation failed: velocity range[%d] min > max", i);
+      if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Config validation failed: velocity range[%d] min > max", i);
       safeSetErrorFlag(ERROR_FLAG_CONFIG_ERROR, true);
       return false;
     }
@@ -77,53 +80,87 @@ uint16_t calculateChecksum(const LidarConfiguration& config) {
   return sum;
 }
 
+/**
+ * @brief Reads one file written by firmware that kept its configuration in LittleFS.
+ *
+ * @param path The file path.
+ * @param data The buffer to fill.
+ * @param size The expected file size.
+ * @return True if the file exists and has the expected size.
+ */
+static bool readLegacyFile(const char* path, void* data, size_t size) {
+  if (!LittleFS.exists(path)) return false;
+  File file = LittleFS.open(path, "r");
+  if (!file) return false;
+  size_t bytesRead = file.readBytes((char*)data, size);
+  file.close();
+  return bytesRead == size;
+}
+
+/**
+ * @brief Moves a configuration saved by older firmware into the configuration store.
+ *
+ * @details Only called when the store is empty. The filesystem is mounted
+ * read-only in effect: formatting is disabled, so a blank or already reused
+ * region simply fails to mount. Each file is taken only if its checksum and
+ * ranges are valid; a missing part keeps its defaults. Once the store has
+ * been written the old filesystem is gone, so this runs at most once.
+ *
+ * @param image The image to fill; must hold the defaults on entry.
+ * @return True if at least one part was migrated.
+ */
+static bool loadLegacyConfiguration(ConfigImage& image) {
+  LittleFSConfig fs_config;
+  fs_config.setAutoFormat(false);
+  LittleFS.setConfig(fs_config);
+  if (!LittleFS.begin()) return false;
+
+  bool migrated = false;
+  LidarConfiguration lidar;
+  if (readLegacyFile(CONFIG_FILE_PATH, &lidar, sizeof(lidar)) &&
+      calculateChecksum(lidar) == lidar.checksum && validateConfiguration(lidar)) {
+    image.lidar = lidar;
+    migrated = true;
+  }
+  GlobalConfiguration globals;
+  if (readLegacyFile(GLOBALS_FILE_PATH, &globals, sizeof(globals)) &&
+      calculateGlobalsChecksum(globals) == globals.checksum && validateGlobalConfiguration(globals)) {
+    image.globals = globals;
+    migrated = true;
+  }
+  LittleFS.end();
+  return migrated;
+}
+
 /**
  * @brief Loads the configuration from storage.
  *
- * @details This function reads the configuration data from non-volatile storage and
- * loads it into the current configuration. If no valid configuration is found,
- * it loads the default configuration.
+ * @details Loads the thresholds, rules, mode and runtime globals from the
+ * newest valid record of the flash configuration store. The record is
+ * validated in place, so this takes microseconds. If the store is empty, a
+ * configuration left in LittleFS by older firmware is migrated into it;
+ * otherwise the defaults are used.
  */
 void loadConfiguration() {
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Attempting to load configuration from LittleFS...");
-  if (!LittleFS.begin()) {
-    if (isDebugEnabled()) safeSerialPrintln("Core 1: LittleFS mount failed, formatting...");
-    LittleFS.format();
-    if (!LittleFS.begin()) {
-      if (isDebugEnabled()) safeSerialPrintln("Core 1: LittleFS initialization failed, using defaults");
-      loadDefaultConfig();
-      return;
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Loading configuration from the config store...");
+  const ConfigImage* stored = configStoreActive();
+  if (stored != nullptr && applyConfigImage(*stored)) {
+    if (LOG_DEBUG_ENABLED()) safeSerialPrintfln("Core 1: Valid configuration loaded (generation %lu)", configStoreGeneration());
+  } else {
+    if (LOG_ERROR_ENABLED() && stored != nullptr) safeSerialPrintln("Core 1: Stored configuration rejected - using defaults");
+    loadDefaultConfig();
+    loadDefaultGlobals();
+    ConfigImage image;
+    buildConfigImage(image);
+    if (stored == nullptr && loadLegacyConfiguration(image) && applyConfigImage(image)) {
+      if (LOG_INFO_ENABLED()) safeSerialPrintln("Core 1: Migrated LittleFS configuration to the config store");
+      saveConfiguration();
+    } else {
+      applyConfigImage(image);
     }
   }
 
-  if (LittleFS.exists(CONFIG_FILE_PATH)) {
-    File configFile = LittleFS.open(CONFIG_FILE_PATH, "r");
-    if (configFile) {
-      size_t bytesRead = configFile.readBytes((char*)&currentConfig, sizeof(LidarConfiguration));
-      configFile.close();
-      if (isDebugEnabled()) safeSerialPrintfln("Core 1: Read %zu bytes from config file", bytesRead);
-
-      if (bytesRead == sizeof(LidarConfiguration)) {
-        uint16_t calculated_checksum = calculateChecksum(currentConfig);
-        if (isDebugEnabled()) safeSerialPrintfln("Core 1: Checksum - stored: %d, calculated: %d", currentConfig.checksum, calculated_checksum);
-        
-        if (calculated_checksum == currentConfig.checksum && validateConfiguration(currentConfig)) {
-          if (isDebugEnabled()) safeSerialPrintln("Core 1: Valid configuration loaded from LittleFS");
-          mutex_enter_blocking(&comm_mutex);
-          core_comm.enable_debug = currentConfig.enable_debug;
-          mutex_exit(&comm_mutex);
-          return;
-        } else if (isDebugEnabled()) safeSerialPrintln("Core 1: Configuration validation failed - using defaults");
-      } else if (isDebugEnabled()) safeSerialPrintln("Core 1: Invalid file size - using defaults");
-    } else if (isDebugEnabled()) safeSerialPrintln("Core 1: Could not open config file - using defaults");
-  } else if (isDebugEnabled()) safeSerialPrintln("Core 1: Config file not found - using defaults");
-
-  loadDefaultConfig();
-  mutex_enter_blocking(&comm_mutex);
-  core_comm.enable_debug = currentConfig.enable_debug;
-  mutex_exit(&comm_mutex);
-  
-  if (isDebugEnabled()) {
+  if (LOG_DEBUG_ENABLED()) {
     safeSerialPrintfln("Core 1: Config summary - Mode: %s, Debug: %s",
       currentConfig.use_velocity_trigger ? "Distance+Velocity" : "Distance Only",
       currentConfig.enable_debug ? "ON" : "OFF");
@@ -133,60 +170,82 @@ void loadConfiguration() {
 /**
  * @brief Saves the current configuration to storage.
  *
- * @return True if the configuration was saved successfully, false otherwise.
+ * @details Queues the thresholds, rules, mode and runtime globals as one
+ * record for the inactive slot of the configuration store. The record is
+ * written in the background by configStoreService(); saves queued before it
+ * starts are coalesced into one write of the newest configuration.
+ *
+ * @return The ticket to pass to configStoreCommitStatus(), or 0 if the
+ *         configuration is invalid or cannot be stored.
  */
-bool saveConfiguration() {
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Saving configuration to LittleFS...");
-  if (!validateConfiguration(currentConfig)) {
-    safeSerialPrintln("Core 1: ERROR - Cannot save invalid configuration");
-    return false;
+uint32_t saveConfiguration() {
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Saving configuration to the config store...");
+  if (!validateConfiguration(currentConfig) || !validateGlobalConfiguration(runtimeGlobals)) {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintln("Core 1: ERROR - Cannot save invalid configuration");
+    return 0;
   }
   currentConfig.checksum = calculateChecksum(currentConfig);
+  runtimeGlobals.checksum = calculateGlobalsChecksum(runtimeGlobals);
 
-  File configFile = LittleFS.open(CONFIG_FILE_PATH, "w");
-  if (!configFile) {
-    safeSerialPrintln("Core 1: ERROR - Failed to open config file for writing");
-    return false;
-  }
-  size_t bytesWritten = configFile.write((uint8_t*)&currentConfig, sizeof(LidarConfiguration));
-  configFile.close();
-
-  if (isDebugEnabled()) safeSerialPrintfln("Core 1: Wrote %zu bytes to config file", bytesWritten);
-  
-  bool config_success = false;
-  if (bytesWritten == sizeof(LidarConfiguration)) {
-    if (isDebugEnabled()) safeSerialPrintln("Core 1: Configuration successfully saved to LittleFS");
-    config_success = true;
-  } else {
-    safeSerialPrintln("Core 1: ERROR - Incomplete write to config file");
-  }
-  
-  // NEW: Also save global configuration
-  if (!saveGlobalConfiguration()) {
-    safeSerialPrintln("Core 1: WARNING - Failed to save global configuration");
-    // Don't fail the entire operation, just warn
-  }
-  
-  return config_success;
+  ConfigImage image;
+  buildConfigImage(image);
+  return configStoreQueueSave(image);
 }
 
 /**
  * @brief Performs a factory reset.
  *
- * @details This function resets the configuration to its default values and saves it
- * to storage. It then reboots the device.
+ * @details This function queues the erase of the stored configuration and
+ * loads the default values. The caller restarts the device once
+ * configStoreBusy() is false.
  */
 void factoryReset() {
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Performing factory reset...");
-  if (LittleFS.remove(CONFIG_FILE_PATH)) {
-    if (isDebugEnabled()) safeSerialPrintln("Core 1: Config file removed from LittleFS");
-  } else if (isDebugEnabled()) safeSerialPrintln("Core 1: Config file removal failed (may not exist)");
-
-  // NEW: Also reset globals
-  factoryResetGlobals();
+  if (LOG_DEBUG_ENABLED()) safeSerialPrintln("Core 1: Performing factory reset...");
+  configStoreQueueErase();
 
   loadDefaultConfig();
-  if (isDebugEnabled()) safeSerialPrintln("Core 1: Factory reset complete, rebooting in 100ms...");
-  delay(100);
-  rp2040.restart();
-}
\ No newline at end of file
+  loadDefaultGlobals();
+}
+
+/**
+ * @brief Copies the current configuration into a transfer image.
+ *
+ * @param image The image to fill.
+ */
+void buildConfigImage(ConfigImage& image) {
+  memset(&image, 0, sizeof(image));
+  image.version = CONFIG_IMAGE_VERSION;
+  memcpy(&image.lidar, &currentConfig, sizeof(image.lidar));
+  image.lidar.checksum = calculateChecksum(currentConfig);
+  memcpy(&image.globals, &runtimeGlobals, sizeof(image.globals));
+  image.globals.checksum = calculateGlobalsChecksum(runtimeGlobals);
+}
+
+/**
+ * @brief Validates a transfer image and makes it the current configuration.
+ *
+ * @details Both parts are validated before either is applied, so the device
+ * never runs with half of an image.
+ *
+ * @param image The image to apply.
+ * @return True if the image was applied, false if it was rejected.
+ */
+bool applyConfigImage(const ConfigImage& image) {
+  if (image.version != CONFIG_IMAGE_VERSION) {
+    if (LOG_ERROR_ENABLED()) safeSerialPrintfln("Core 1: Config image version %d not supported (expected %d)", image.version, CONFIG_IMAGE_VERSION);
+    return false;
+  }
+  if (!validateConfiguration(image.lidar) || !validateGlobalConfiguration(image.globals)) {
+    return false;
+  }
+
+  currentConfig = image.lidar;
+  currentConfig.checksum = calculateChecksum(currentConfig);
+  runtimeGlobals = image.globals;
+  runtimeGlobals.checksum = calculateGlobalsChecksum(runtimeGlobals);
+
+  mutex_enter_blocking(&comm_mutex);
+  core_comm.enable_debug = currentConfig.enable_debug;
+  mutex_exit(&comm_mutex);
+  return true;
+}
@@ -13,6 +13,20 @@
 #define STORAGE_H
 
 #include "globals.h"
+#include "globals_config.h"
+
+/** @brief Layout version of ConfigImage - bump whenever LidarConfiguration or GlobalConfiguration changes. */
+#define CONFIG_IMAGE_VERSION 1
+
+/**
+ * @brief The complete device configuration as transferred by the GUI bulk commands ('B'/'b').
+ */
+struct ConfigImage {
+  uint8_t version;                ///< CONFIG_IMAGE_VERSION of the layout.
+  uint8_t reserved[3];            ///< Zero.
+  LidarConfiguration lidar;       ///< Thresholds, rules and mode.
+  GlobalConfiguration globals;    ///< Runtime global parameters.
+};
 
 /**
  * @brief Loads the default configuration.
@@ -50,16 +64,38 @@ void loadConfiguration();
 /**
  * @brief Saves the current configuration to storage.
  *
- * @return True if the configuration was saved successfully, false otherwise.
+ * @details The save is queued and written in the background.
+ *
+ * @return The ticket to pass to configStoreCommitStatus(), or 0 if the
+ *         configuration is invalid or cannot be stored.
  */
-bool saveConfiguration();
+uint32_t saveConfiguration();
 
 /**
  * @brief Performs a factory reset.
  *
- * @details This function resets the configuration to its default values and saves it
- * to storage.
+ * @details This function resets the configuration to its default values and queues
+ * the erase of the stored configuration. The caller restarts the device once
+ * configStoreBusy() is false.
  */
 void factoryReset();
 
+/**
+ * @brief Copies the current configuration into a transfer image.
+ *
+ * @param image The image to fill.
+ */
+void buildConfigImage(ConfigImage& image);
+
+/**
+ * @brief Validates a transfer image and makes it the current configuration.
+ *
+ * @details Both parts are validated before either is applied, so the device
+ * never runs with half of an image.
+ *
+ * @param image The image to apply.
+ * @return True if the image was applied, false if it was rejected.
+ */
+bool applyConfigImage(const ConfigImage& image);
+
 #endif // STORAGE_H
\ No newline at end of file
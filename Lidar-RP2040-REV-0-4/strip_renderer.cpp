@@ -0,0 +1,118 @@
+/**
+ * @file strip_renderer.cpp
+ * @brief This file contains the implementation of the StripRenderer class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the integer bar graph, marker and comet rendering. The only
+ * float operation per frame is the conversion of the target velocity.
+ */
+
+#include "strip_renderer.h"
+#include "color_lut.h"
+
+/** @brief Distance span covered by the strip. */
+static const uint32_t STRIP_SPAN_CM = NEOPIXEL_STRIP_RANGE_CM - MIN_DISTANCE_CM;
+
+/**
+ * @brief Maps a distance to the pixel that represents it.
+ * @param distance_cm The distance in centimeters.
+ * @return The pixel index, clamped to the strip.
+ */
+uint16_t StripRenderer::pixelForDistance(uint32_t distance_cm) {
+  if (distance_cm <= MIN_DISTANCE_CM) return 0;
+  if (distance_cm >= NEOPIXEL_STRIP_RANGE_CM) return NEOPIXEL_PIXEL_COUNT - 1;
+  return (uint16_t)((distance_cm - MIN_DISTANCE_CM) * (NEOPIXEL_PIXEL_COUNT - 1) / STRIP_SPAN_CM);
+}
+
+/**
+ * @brief Renders the bar, threshold markers and velocity comet.
+ *
+ * @details The distance is smoothed with the same 0.3 factor as the single pixel
+ * display, in 8.8 fixed point. Bar pixels take the gradient color of their own
+ * position, dimmed to 30-100% by signal strength. Markers are drawn over the
+ * bar, the active switch position brighter than the others. The comet moves
+ * at the strip-scaled speed of the target (toward the sensor end when
+ * approaching) and wraps around; its tail fades along the gamma curve. It is
+ * hidden below 5 cm/s.
+ *
+ * @param distance The distance in centimeters.
+ * @param velocity The velocity in cm/s.
+ * @param strength The signal strength as brightness (0-255).
+ * @param switch_code The active switch position, whose marker is highlighted.
+ * @param now_ms The current time in milliseconds.
+ */
+void StripRenderer::render(uint16_t distance, float velocity, uint8_t strength, uint8_t switch_code, uint32_t now_ms) {
+  // Smoothing: s += (d - s) * 77/256 (about 0.3)
+  uint32_t distance_q8 = (uint32_t)distance << 8;
+  if (!smoothing_initialized) {
+    smoothed_distance_q8 = distance_q8;
+    smoothing_initialized = true;
+  } else {
+    int32_t delta = (int32_t)distance_q8 - (int32_t)smoothed_distance_q8;
+    smoothed_distance_q8 += (delta * 77) / 256;
+  }
+
+  // Bar
+  uint16_t bar_end = pixelForDistance(smoothed_distance_q8 >> 8);
+  uint8_t brightness = 77 + ((uint32_t)strength * 178) / 255;  // 30-100%
+  for (uint16_t i = 0; i < NEOPIXEL_PIXEL_COUNT; i++) {
+    if (i <= bar_end) {
+      uint8_t position = (NEOPIXEL_PIXEL_COUNT > 1) ? (uint8_t)((uint32_t)i * 255 / (NEOPIXEL_PIXEL_COUNT - 1)) : 0;
+      framebuffer[i] = scaleColor(gradientColor8(position), brightness, 255);
+    } else {
+      framebuffer[i] = 0;
+    }
+  }
+
+  // Threshold markers
+  for (uint8_t position = 0; position < 8; position++) {
+    framebuffer[pixelForDistance(currentConfig.distance_thresholds[position])] = 0x00202020;
+  }
+  framebuffer[pixelForDistance(currentConfig.distance_thresholds[switch_code & 0x07])] = 0x00A0A0A0;
+
+  // Velocity comet
+  uint32_t dt_ms = now_ms - last_render_ms;
+  last_render_ms = now_ms;
+  if (dt_ms > 100) dt_ms = 100;  // After a pause, don't jump
+
+  int32_t velocity_cm_s = (int32_t)velocity;
+  if (velocity_cm_s > -5 && velocity_cm_s < 5) return;
+
+  const int32_t strip_q8 = (int32_t)NEOPIXEL_PIXEL_COUNT << 8;
+  int64_t step_q8 = (int64_t)velocity_cm_s * (NEOPIXEL_PIXEL_COUNT - 1) * 256 * (int32_t)dt_ms / ((int64_t)STRIP_SPAN_CM * 1000);
+  comet_position_q8 = (int32_t)((comet_position_q8 + step_q8) % strip_q8);
+  if (comet_position_q8 < 0) comet_position_q8 += strip_q8;
+
+  int32_t head = comet_position_q8 >> 8;
+  int32_t trail = (velocity_cm_s < 0) ? 1 : -1;  // The tail follows behind the direction of travel
+  // No longer than the strip, so the tail never wraps onto itself and the index below stays non-negative
+  const int32_t tail_length = min((int32_t)NEOPIXEL_COMET_TAIL, (int32_t)NEOPIXEL_PIXEL_COUNT);
+  for (int32_t k = 0; k < tail_length; k++) {
+    int32_t pixel = (head + k * trail + NEOPIXEL_PIXEL_COUNT) % NEOPIXEL_PIXEL_COUNT;
+    uint8_t level = gammaLevel(255 * (tail_length - k) / tail_length);
+    framebuffer[pixel] = addColor(framebuffer[pixel], packColor(0, level, level));
+  }
+}
+
+/**
+ * @brief Sets every pixel to one color.
+ * @param color The color in 0x00RRGGBB format.
+ */
+void StripRenderer::fill(uint32_t color) {
+  for (uint16_t i = 0; i < NEOPIXEL_PIXEL_COUNT; i++) {
+    framebuffer[i] = color;
+  }
+}
+
+/**
+ * @brief Blends the compositor's overlay layers onto every pixel.
+ * @param compositor The compositor holding the overlay layers.
+ */
+void StripRenderer::applyOverlays(const LedCompositor& compositor) {
+  if (!compositor.hasOverlay()) return;
+  for (uint16_t i = 0; i < NEOPIXEL_PIXEL_COUNT; i++) {
+    framebuffer[i] = compositor.composeOver(framebuffer[i]);
+  }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file strip_renderer.h
+ * @brief This file contains the declaration of the StripRenderer class.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Renders the distance display for a NeoPixel strip of NEOPIXEL_PIXEL_COUNT
+ * pixels: the distance as a bar from the sensor end, each switch position's
+ * threshold as a marker, and the velocity as a comet running along the strip.
+ * All pixels are computed with integer math into a framebuffer of 0x00RRGGBB
+ * colors.
+ */
+#ifndef STRIP_RENDERER_H
+#define STRIP_RENDERER_H
+
+#include "globals.h"
+#include "led_compositor.h"
+
+/**
+ * @class StripRenderer
+ * @brief Builds the strip framebuffer from the published display target.
+ */
+class StripRenderer {
+private:
+  uint32_t framebuffer[NEOPIXEL_PIXEL_COUNT] = {};
+  uint32_t smoothed_distance_q8 = 0;  ///< Smoothed distance in 1/256 cm.
+  bool smoothing_initialized = false;
+  int32_t comet_position_q8 = 0;      ///< Comet head in 1/256 pixel.
+  uint32_t last_render_ms = 0;
+
+  static uint16_t pixelForDistance(uint32_t distance_cm);
+
+public:
+  /**
+   * @brief Renders the bar, threshold markers and velocity comet.
+   * @param distance The distance in centimeters.
+   * @param velocity The velocity in cm/s.
+   * @param strength The signal strength as brightness (0-255).
+   * @param switch_code The active switch position, whose marker is highlighted.
+   * @param now_ms The current time in milliseconds.
+   */
+  void render(uint16_t distance, float velocity, uint8_t strength, uint8_t switch_code, uint32_t now_ms);
+
+  /**
+   * @brief Sets every pixel to one color.
+   * @param color The color in 0x00RRGGBB format.
+   */
+  void fill(uint32_t color);
+
+  /**
+   * @brief Blends the compositor's overlay layers onto every pixel.
+   * @param compositor The compositor holding the overlay layers.
+   */
+  void applyOverlays(const LedCompositor& compositor);
+
+  /**
+   * @brief Gets the framebuffer.
+   * @return NEOPIXEL_PIXEL_COUNT colors in 0x00RRGGBB format.
+   */
+  const uint32_t* getPixels() const { return framebuffer; }
+};
+
+#endif // STRIP_RENDERER_H
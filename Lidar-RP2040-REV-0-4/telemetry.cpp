@@ -0,0 +1,144 @@
+/**
+ * @file telemetry.cpp
+ * @brief This file contains the implementation of the binary telemetry stream.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the decimation, batching and sending of telemetry records.
+ * Everything here runs on Core 1, so the batch needs no locking. Sending never
+ * blocks: a full batch that does not fit in the USB transmit buffer is dropped
+ * and the sequence numbers show the gap to the host.
+ */
+
+#include "telemetry.h"
+#include "gui.h"
+
+/** @brief Command byte of telemetry batch packets. */
+#define TELEMETRY_PACKET_CMD 'y'
+
+/**
+ * @brief The batch being filled, laid out exactly as the 'y' packet payload.
+ */
+struct TelemetryBatch {
+  TelemetryBatchHeader header;
+  TelemetryRecord records[TELEMETRY_RECORDS_PER_PACKET];
+};
+
+static TelemetryBatch telemetry_batch;
+static uint8_t telemetry_decimation = 0;   ///< Keep every Nth sample; 0 = not subscribed.
+static uint8_t telemetry_skip_count = 0;   ///< Samples since the last kept one.
+static uint16_t telemetry_sequence = 0;    ///< Sequence number of the next record.
+static uint32_t telemetry_batch_start_ms = 0;
+static GuiReplyTarget telemetry_target = { GUI_PROTOCOL_V1, 0 };  ///< Framing of the subscribing request.
+
+/**
+ * @brief Sends the current batch if it has any records, then starts a new one.
+ * @return True if the batch was sent or empty, false if it was dropped.
+ */
+static bool sendBatch() {
+  uint8_t count = telemetry_batch.header.count;
+  if (count == 0) return true;
+
+  telemetry_batch.header.decimation = telemetry_decimation;
+  uint8_t len = sizeof(TelemetryBatchHeader) + count * sizeof(TelemetryRecord);
+  bool sent = trySendResponsePacket(telemetry_target, TELEMETRY_PACKET_CMD, (const uint8_t*)&telemetry_batch, len);
+
+  telemetry_batch.header.count = 0;
+  telemetry_batch.header.first_sequence = telemetry_sequence;
+  return sent;
+}
+
+/**
+ * @brief Starts, changes or stops the telemetry stream.
+ *
+ * @details Any partly filled batch is sent first so that records never mix
+ * decimation settings within one packet. The sequence numbers continue across
+ * subscriptions. Batches are sent in the framing of the subscribing request;
+ * a v2 subscription's batches echo its sequence ID.
+ *
+ * @param decimation Send every Nth processed sample (1 = full rate); 0 stops the stream.
+ */
+void telemetrySubscribe(uint8_t decimation) {
+  sendBatch();
+  telemetry_decimation = decimation;
+  telemetry_skip_count = 0;
+  telemetry_target = guiCurrentReplyTarget();
+  telemetry_batch.header.first_sequence = telemetry_sequence;
+}
+
+/**
+ * @brief Checks whether the GUI is subscribed to the telemetry stream.
+ * @return True if records are being collected.
+ */
+bool telemetryActive() {
+  return telemetry_decimation != 0;
+}
+
+/**
+ * @brief Offers one processed sample to the telemetry stream.
+ *
+ * @details Only every Nth sample is kept, where N is the subscribed decimation.
+ * The batch is sent as soon as it is full.
+ *
+ * @param timestamp_us The sample timestamp in microseconds.
+ * @param distance The distance in centimeters.
+ * @param strength The signal strength.
+ * @param velocity The velocity in cm/s.
+ * @param trigger True if the sample's trigger latch is active.
+ * @param source The sensor index, or TELEMETRY_SOURCE_FUSED.
+ * @param queue_depth The fill level of the fullest frame queue.
+ */
+void telemetryRecord(uint32_t timestamp_us, uint16_t distance, uint16_t strength, float velocity,
+                     bool trigger, uint8_t source, uint8_t queue_depth) {
+  if (telemetry_decimation == 0) return;
+  if (++telemetry_skip_count < telemetry_decimation) return;
+  telemetry_skip_count = 0;
+
+  if (telemetry_batch.header.count == 0) {
+    telemetry_batch_start_ms = millis();
+  }
+
+  TelemetryRecord& record = telemetry_batch.records[telemetry_batch.header.count++];
+  record.timestamp_us = timestamp_us;
+  record.distance = distance;
+  record.strength = strength;
+  record.velocity = velocity;
+  record.flags = (trigger ? TELEMETRY_FLAG_TRIGGER : 0) | (source << TELEMETRY_SOURCE_SHIFT);
+  record.queue_depth = queue_depth;
+  telemetry_sequence++;
+
+  if (telemetry_batch.header.count == TELEMETRY_RECORDS_PER_PACKET) {
+    sendBatch();
+  }
+}
+
+/**
+ * @brief Accounts for a processed sample that is shed under load instead of recorded.
+ *
+ * @details Costs a counter update. A sample that would have been kept still
+ * uses up its sequence number, so the host sees shed samples as a gap. A partly
+ * filled batch is sent first, because a batch holds consecutive records only.
+ */
+void telemetrySkip() {
+  if (telemetry_decimation == 0) return;
+  if (++telemetry_skip_count < telemetry_decimation) return;
+  telemetry_skip_count = 0;
+
+  sendBatch();
+  telemetry_sequence++;
+  telemetry_batch.header.first_sequence = telemetry_sequence;
+}
+
+/**
+ * @brief Sends a partly filled batch once it is older than TELEMETRY_FLUSH_MS. Called from the Core 1 loop.
+ *
+ * @details Bounds the latency of the stream when the decimated sample rate is
+ * too low to fill a packet quickly.
+ */
+void telemetryFlush() {
+  if (telemetry_batch.header.count == 0) return;
+  if (safeMillisElapsed(telemetry_batch_start_ms, millis()) >= TELEMETRY_FLUSH_MS) {
+    sendBatch();
+  }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file telemetry.h
+ * @brief This file contains the declarations for the binary telemetry stream.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details While the GUI is subscribed ('Y' command), Core 1 records one compact
+ * telemetry record for every Nth processed sample and sends the records in
+ * batches as 'y' packets. In v1 framing a full batch packet is exactly one 64-byte USB
+ * full-speed packet. Every record carries a sequence number (the batch header
+ * holds the first one), so the host can count records lost to decimation
+ * changes, to a full USB transmit buffer or to load shedding (LOAD_SHED). tools/telemetry_stream.py
+ * subscribes and decodes the stream.
+ */
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "globals.h"
+
+/** @brief Records per 'y' packet: 4-byte header + 4 * 14-byte records + 4 bytes framing = 64 bytes. */
+#define TELEMETRY_RECORDS_PER_PACKET 4
+
+/** @brief TelemetryRecord::flags bit set while the record's trigger latch is active. */
+#define TELEMETRY_FLAG_TRIGGER 0x01
+/** @brief TelemetryRecord::flags bits holding the source sensor index. */
+#define TELEMETRY_SOURCE_SHIFT 4
+/** @brief Source index used for the fused output of the dual-sensor voting stage. */
+#define TELEMETRY_SOURCE_FUSED 0x0F
+
+/**
+ * @brief One telemetry record as sent on the wire (14 bytes, little-endian).
+ */
+struct __attribute__((packed)) TelemetryRecord {
+  uint32_t timestamp_us;  ///< Sample timestamp (micros()).
+  uint16_t distance;      ///< Distance in centimeters.
+  uint16_t strength;      ///< Signal strength.
+  float velocity;         ///< Velocity in cm/s.
+  uint8_t flags;          ///< TELEMETRY_FLAG_TRIGGER and the source index.
+  uint8_t queue_depth;    ///< Fill level of the fullest frame queue when the batch was popped.
+};
+
+/**
+ * @brief Header of a 'y' packet payload (4 bytes, little-endian).
+ */
+struct __attribute__((packed)) TelemetryBatchHeader {
+  uint16_t first_sequence;  ///< Sequence number of the first record in the packet.
+  uint8_t count;            ///< Number of records that follow.
+  uint8_t decimation;       ///< Decimation in effect when the batch was sent.
+};
+
+void telemetrySubscribe(uint8_t decimation);
+bool telemetryActive();
+void telemetryRecord(uint32_t timestamp_us, uint16_t distance, uint16_t strength, float velocity,
+                     bool trigger, uint8_t source, uint8_t queue_depth);
+void telemetrySkip();
+void telemetryFlush();
+
+#endif // TELEMETRY_H
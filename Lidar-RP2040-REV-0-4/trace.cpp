@@ -0,0 +1,86 @@
+/**
+ * @file trace.cpp
+ * @brief This file contains the implementation of the on-device trace buffer.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Implements the per-core trace rings. Recording takes no lock: each core
+ * writes only its own ring. Reading freezes recording on both cores so a dump is
+ * a consistent snapshot.
+ */
+
+#include "trace.h"
+#include <atomic>
+#include <hardware/sync.h>
+
+/**
+ * @brief A per-core trace ring. The oldest events are overwritten when full.
+ */
+struct TraceRing {
+  TraceEvent events[TRACE_RING_SIZE];
+  std::atomic<uint32_t> head{0};    ///< Total events recorded; written only by the owning core.
+};
+
+static TraceRing trace_rings[2];
+static std::atomic<bool> trace_frozen{false};
+
+/**
+ * @brief Records an event in the calling core's ring.
+ *
+ * @details The slot is claimed with interrupts masked, so a trace point in an
+ * interrupt handler (such as the LED refresh timer) cannot take the same slot
+ * as the code it interrupted.
+ *
+ * @param type The event type.
+ * @param id The trace point.
+ * @param arg The event argument.
+ */
+void traceRecord(TraceEventType type, TraceId id, uint16_t arg) {
+  if (trace_frozen.load(std::memory_order_relaxed)) return;
+
+  TraceRing& ring = trace_rings[get_core_num()];
+  uint32_t irq_state = save_and_disable_interrupts();
+  uint32_t head = ring.head.load(std::memory_order_relaxed);
+  TraceEvent& event = ring.events[head % TRACE_RING_SIZE];
+  event.timestamp_us = micros();
+  event.type = type;
+  event.id = id;
+  event.arg = arg;
+  ring.head.store(head + 1, std::memory_order_release);
+  restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Stops or resumes recording on both cores.
+ * @param frozen True to stop recording for a dump, false to resume.
+ */
+void traceFreeze(bool frozen) {
+  trace_frozen.store(frozen, std::memory_order_release);
+}
+
+/**
+ * @brief Gets the number of events held in a core's ring.
+ * @param core The core number (0 or 1).
+ * @return The number of events, at most TRACE_RING_SIZE.
+ */
+uint16_t traceEventCount(uint8_t core) {
+  uint32_t head = trace_rings[core].head.load(std::memory_order_acquire);
+  return (head < TRACE_RING_SIZE) ? head : TRACE_RING_SIZE;
+}
+
+/**
+ * @brief Reads one event from a core's ring, oldest first.
+ * @param core The core number (0 or 1).
+ * @param index The event index, 0 = oldest held event.
+ * @param event Receives the event.
+ * @return True if the index was in range.
+ */
+bool traceGetEvent(uint8_t core, uint16_t index, TraceEvent& event) {
+  const TraceRing& ring = trace_rings[core];
+  uint32_t head = ring.head.load(std::memory_order_acquire);
+  uint16_t count = traceEventCount(core);
+  if (index >= count) return false;
+  event = ring.events[(head - count + index) % TRACE_RING_SIZE];
+  return true;
+}
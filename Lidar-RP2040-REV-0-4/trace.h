@@ -0,0 +1,70 @@
+/**
+ * @file trace.h
+ * @brief This file contains the declarations for the on-device trace buffer.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Each core records compact begin/end/instant events with microsecond
+ * timestamps into its own fixed-size ring, overwriting the oldest events. The
+ * rings are read back over the GUI protocol ('X' command) and converted to
+ * Chrome trace JSON by tools/trace_to_chrome.py, which shows both cores'
+ * timelines side by side.
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "globals.h"
+
+/**
+ * @brief Defines the trace event types.
+ */
+enum TraceEventType : uint8_t {
+  TRACE_BEGIN = 'B',    ///< Start of a duration.
+  TRACE_END = 'E',      ///< End of a duration.
+  TRACE_INSTANT = 'i'   ///< A point in time.
+};
+
+/**
+ * @brief Defines the instrumented trace points. Keep in sync with tools/trace_to_chrome.py.
+ */
+enum TraceId : uint8_t {
+  TRACE_CORE0_STATE,    ///< Instant: Core 0 init state changed (arg = new state).
+  TRACE_CORE1_STATE,    ///< Instant: Core 1 init state changed (arg = new state).
+  TRACE_SYSTEM_STATE,   ///< Instant: system state changed (arg = new state).
+  TRACE_FRAME_PARSE,    ///< Duration: validating and queueing one frame (arg = sensor).
+  TRACE_QUEUE_POP,      ///< Duration: popping one batch (arg = sensor).
+  TRACE_VELOCITY,       ///< Duration: velocity update for one frame (arg = sensor).
+  TRACE_TRIGGER,        ///< Instant: TRIG output changed (arg = new output state).
+  TRACE_LED_SHOW,       ///< Duration: NeoPixel show().
+  TRACE_FLASH_WRITE,    ///< Duration: flash erase or program (arg = 4 KiB sector in the FS region).
+  TRACE_GUI_COMMAND,    ///< Duration: executing one GUI command (arg = command byte).
+  TRACE_ID_COUNT
+};
+
+/**
+ * @brief One trace event (8 bytes).
+ */
+struct TraceEvent {
+  uint32_t timestamp_us;  ///< micros() when the event was recorded.
+  uint8_t type;           ///< TraceEventType.
+  uint8_t id;             ///< TraceId.
+  uint16_t arg;           ///< Event-specific argument.
+};
+
+void traceRecord(TraceEventType type, TraceId id, uint16_t arg);
+void traceFreeze(bool frozen);
+uint16_t traceEventCount(uint8_t core);
+bool traceGetEvent(uint8_t core, uint16_t index, TraceEvent& event);
+
+#if ENABLE_TRACE
+#define TRACE_BEGIN_EVENT(id, arg) traceRecord(TRACE_BEGIN, (id), (arg))
+#define TRACE_END_EVENT(id, arg) traceRecord(TRACE_END, (id), (arg))
+#define TRACE_INSTANT_EVENT(id, arg) traceRecord(TRACE_INSTANT, (id), (arg))
+#else
+#define TRACE_BEGIN_EVENT(id, arg) do {} while (0)
+#define TRACE_END_EVENT(id, arg) do {} while (0)
+#define TRACE_INSTANT_EVENT(id, arg) do {} while (0)
+#endif
+
+#endif // TRACE_H
@@ -12,9 +12,6 @@
 
 #include "trigger.h"
 
-TriggerDebouncer trigger_debouncer;
-TriggerLatch trigger_latch;
-
 /**
  * @brief Updates the trigger latch with a new trigger event.
  *
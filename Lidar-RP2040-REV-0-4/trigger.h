@@ -65,9 +65,4 @@ public:
   bool update(bool raw_state);
 };
 
-/** @brief The global trigger debouncer instance. */
-extern TriggerDebouncer trigger_debouncer;
-/** @brief The global trigger latch instance. */
-extern TriggerLatch trigger_latch;
-
 #endif // TRIGGER_H
\ No newline at end of file
@@ -58,6 +58,9 @@
 #include <stdlib.h>
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "pico/time.h"
+#include "pico/critical_section.h"
 #include "rp2040_pio.h"
 #endif
 
@@ -241,6 +244,25 @@ public:
   void clear(void);
   void updateLength(uint16_t n);
   void updateType(neoPixelType t);
+#if defined(ARDUINO_ARCH_RP2040)
+  bool showAsync(void);
+  /*!
+    @brief   Check whether the last showAsync() frame, and any frame queued
+             behind it, has been sent and latched.
+    @return  true if the DMA channel is idle and the latch time has passed.
+  */
+  bool showComplete(void) {
+    rp2040PollLatch();
+    return !dmaBusy;
+  }
+  /*!
+    @brief   Select the alarm pool that times the showAsync() latch. The
+             latch callback, and the transfer of a frame queued behind it,
+             run on the core that created the pool.
+    @param   pool  The alarm pool, or NULL for the SDK's default pool.
+  */
+  void setAlarmPool(alarm_pool_t *pool) { dmaAlarmPool = pool; }
+#endif
   /*!
     @brief   Check whether a call to show() will start sending data
              immediately or will 'block' for a required interval. NeoPixels
@@ -270,6 +292,13 @@ public:
     // stall for 30+ minutes, or having to document and frequently remind
     // and/or provide tech support explaining an unintuitive need for
     // show() calls at least once an hour.
+#if defined(ARDUINO_ARCH_RP2040)
+    // An asynchronous transfer owns the state machine until its latch
+    // alarm fires.
+    rp2040PollLatch();
+    if (dmaBusy)
+      return false;
+#endif
     uint32_t now = micros();
     if (endTime > now) {
       endTime = now;
@@ -387,9 +416,28 @@ private:
   bool   rp2040claimPIO(void);
   void   rp2040releasePIO(void);
   void   rp2040Show(uint8_t *pixels, uint32_t numBytes);
+  void   rp2040ConfigureSM(void);
+  void   rp2040PackPixels(uint32_t *words, const uint8_t *bytes,
+                          uint16_t count) const;
+  bool   rp2040AllocDmaBuffers(void);
+  void   rp2040StartTransfer(void);
+  void   rp2040EndLatch(void);
+  void   rp2040PollLatch(void);
+  static int64_t rp2040LatchAlarm(alarm_id_t id, void *user_data);
   PIO    pio = NULL;
   uint   pio_sm = -1;
   uint   pio_program_offset = 0;
+  uint8_t pio_bits = 0;                       ///< Autopull size, 24 (RGB) or 32 (RGBW)
+  int    dma_chan = -1;                       ///< DMA channel for showAsync()
+  uint32_t *dmaBuffer[2] = {NULL, NULL};      ///< Front (on the wire) and back pixel words
+  uint16_t dmaBufferWords = 0;                ///< Pixels in each DMA buffer
+  uint8_t dmaFront = 0;                       ///< Index of the buffer being sent
+  volatile bool dmaBusy = false;              ///< Transfer or latch in progress
+  volatile bool dmaPending = false;           ///< Back buffer waits for the latch
+  volatile bool dmaLatchPolled = false;       ///< No alarm slot: latch end is polled
+  uint32_t dmaLatchEnd = 0;                   ///< time_us_32() at which a polled latch ends
+  alarm_pool_t *dmaAlarmPool = NULL;          ///< Pool for the latch alarm, NULL for the default
+  critical_section_t dmaLock;                 ///< Guards the above against the alarm
 #endif
 
 protected:
@@ -16,13 +16,22 @@ bool Adafruit_NeoPixel::rp2040claimPIO(void) {
   }
 
   // yay ok!
-  
-  if (is800KHz) {
-    // 800kHz, 8 bit transfers
-    ws2812_program_init(pio, pio_sm, pio_program_offset, pin, 800000, 8);
-  } else {
-    // 400kHz, 8 bit transfers
-    ws2812_program_init(pio, pio_sm, pio_program_offset, pin, 400000, 8);
+
+  // Whole pixels per FIFO word: 24-bit autopull for RGB, 32-bit for RGBW
+  rp2040ConfigureSM();
+
+  // DMA channel for showAsync(), paced by the state machine's TX DREQ.
+  // Each transfer is one packed pixel word. Without a free channel
+  // showAsync() falls back to show().
+  dma_chan = dma_claim_unused_channel(false);
+  if (dma_chan >= 0) {
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, pio_sm, true));
+    dma_channel_configure(dma_chan, &c, &pio->txf[pio_sm], NULL, 0, false);
+    critical_section_init(&dmaLock);
   }
 
   return true;
@@ -32,10 +41,50 @@ void Adafruit_NeoPixel::rp2040releasePIO(void) {
   if (pio == NULL) 
     return;
 
+  if (dma_chan >= 0) {
+    // Let the frame on the wire (and any queued one) finish cleanly
+    while (!showComplete())
+      tight_loop_contents();
+    dma_channel_unclaim(dma_chan);
+    critical_section_deinit(&dmaLock);
+    dma_chan = -1;
+  }
+  free(dmaBuffer[0]);
+  free(dmaBuffer[1]);
+  dmaBuffer[0] = dmaBuffer[1] = NULL;
+  dmaBufferWords = 0;
+
   pio_remove_program_and_unclaim_sm(&ws2812_program, pio, pio_sm,  pio_program_offset);
 }
 
 
+// Private, (re)initializes the state machine for the current pixel size
+void Adafruit_NeoPixel::rp2040ConfigureSM(void) {
+  pio_bits = (wOffset == rOffset) ? 24 : 32;
+  ws2812_program_init(pio, pio_sm, pio_program_offset, pin,
+                      is800KHz ? 800000 : 400000, pio_bits);
+}
+
+// Private, packs pixels into left-aligned FIFO words. The program shifts
+// out MSB first, so the first byte on the wire goes in bits 31..24.
+void Adafruit_NeoPixel::rp2040PackPixels(uint32_t *words,
+                                         const uint8_t *bytes,
+                                         uint16_t count) const {
+  if (pio_bits == 32) {
+    while (count--) {
+      *words++ = ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+                 ((uint32_t)bytes[2] << 8) | bytes[3];
+      bytes += 4;
+    }
+  } else {
+    while (count--) {
+      *words++ = ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+                 ((uint32_t)bytes[2] << 8);
+      bytes += 3;
+    }
+  }
+}
+
 // Private, called from show()
 void  Adafruit_NeoPixel::rp2040Show(uint8_t *pixels, uint32_t numBytes)
 {
@@ -44,8 +93,135 @@ void  Adafruit_NeoPixel::rp2040Show(uint8_t *pixels, uint32_t numBytes)
     return;
   }
 
-  while(numBytes--)
-    // Bits for transmission must be shifted to top 8 bits
-    pio_sm_put_blocking(pio, pio_sm, ((uint32_t)*pixels++)<< 24);
+  // updateType() may have switched between RGB and RGBW since begin()
+  if (pio_bits != ((wOffset == rOffset) ? 24 : 32))
+    rp2040ConfigureSM();
+
+  // One FIFO write per pixel instead of one per byte
+  uint32_t bytesPerPixel = pio_bits / 8;
+  for (uint32_t n = numBytes / bytesPerPixel; n; n--) {
+    uint32_t word;
+    rp2040PackPixels(&word, pixels, 1);
+    pio_sm_put_blocking(pio, pio_sm, word);
+    pixels += bytesPerPixel;
+  }
+}
+
+/*!
+  @brief   Transmit the pixel buffer without waiting for the wire.
+           The pixel data is copied into a DMA buffer, so the caller may
+           modify pixels immediately. If a frame is still being sent or
+           latched, the new frame replaces any frame already queued behind
+           it and goes out as soon as the latch time has elapsed. The latch
+           is tracked by a timer alarm (see setAlarmPool()) rather than a
+           spin in canShow().
+  @return  true if the frame was handed to DMA, false if it had to be sent
+           with the blocking show() (no DMA channel or buffer memory).
+*/
+bool Adafruit_NeoPixel::showAsync(void) {
+  if (!pixels)
+    return false;
+
+  if (dma_chan < 0 || !numLEDs || !rp2040AllocDmaBuffers()) {
+    show();
+    return false;
+  }
+
+  rp2040PollLatch();
+  critical_section_enter_blocking(&dmaLock);
+  rp2040PackPixels(dmaBuffer[dmaFront ^ 1], pixels, dmaBufferWords);
+  if (dmaBusy) {
+    dmaPending = true;
+  } else {
+    rp2040StartTransfer();
+  }
+  critical_section_exit(&dmaLock);
+  return true;
+}
+
+// Private, (re)allocates the two DMA buffers to one word per pixel and
+// picks up any change of pixel size
+bool Adafruit_NeoPixel::rp2040AllocDmaBuffers(void) {
+  uint8_t bits = (wOffset == rOffset) ? 24 : 32;
+  if (dmaBufferWords == numLEDs && pio_bits == bits)
+    return true;
+
+  // Never pull a buffer or the state machine out from under a transfer
+  while (!showComplete())
+    tight_loop_contents();
+
+  if (pio_bits != bits)
+    rp2040ConfigureSM();
+  if (dmaBufferWords == numLEDs)
+    return true;
+
+  free(dmaBuffer[0]);
+  free(dmaBuffer[1]);
+  dmaBuffer[0] = (uint32_t *)malloc(numLEDs * sizeof(uint32_t));
+  dmaBuffer[1] = (uint32_t *)malloc(numLEDs * sizeof(uint32_t));
+  if (!dmaBuffer[0] || !dmaBuffer[1]) {
+    free(dmaBuffer[0]);
+    free(dmaBuffer[1]);
+    dmaBuffer[0] = dmaBuffer[1] = NULL;
+    dmaBufferWords = 0;
+    return false;
+  }
+  dmaBufferWords = numLEDs;
+  return true;
+}
+
+// Private, called with dmaLock held. Sends the back buffer and arms the
+// alarm that ends the latch period. Also runs in the alarm interrupt, so it
+// must never wait for the wire.
+void Adafruit_NeoPixel::rp2040StartTransfer(void) {
+  dmaFront ^= 1;
+  dmaBusy = true;
+  dma_channel_transfer_from_buffer_now(dma_chan, dmaBuffer[dmaFront],
+                                       dmaBufferWords);
+
+  // Time on the wire (1.25 or 2.5 us per bit), plus the 300 us latch. The
+  // clock divider is fractional, so allow a few microseconds of slack.
+  uint32_t us = (uint32_t)dmaBufferWords * pio_bits * (is800KHz ? 5 : 10) / 4 +
+                300 + 10;
+  alarm_pool_t *pool = dmaAlarmPool ? dmaAlarmPool : alarm_pool_get_default();
+  dmaLatchEnd = time_us_32() + us;
+  // No alarm slot: the next showAsync(), canShow() or showComplete() ends
+  // the latch once its time has passed, and sends any queued frame
+  dmaLatchPolled =
+      alarm_pool_add_alarm_in_us(pool, us, rp2040LatchAlarm, this, false) <= 0;
+}
+
+// Private, called with dmaLock held when the latch time has passed. Sends
+// the queued frame, if any, else frees the strip.
+void Adafruit_NeoPixel::rp2040EndLatch(void) {
+  if (dmaPending) {
+    dmaPending = false;
+    rp2040StartTransfer();
+  } else {
+    dmaBusy = false;
+  }
+}
+
+// Private, ends a latch that has no alarm once its time has passed
+void Adafruit_NeoPixel::rp2040PollLatch(void) {
+  if (!dmaLatchPolled)
+    return;
+  critical_section_enter_blocking(&dmaLock);
+  if (dmaLatchPolled && (int32_t)(time_us_32() - dmaLatchEnd) >= 0) {
+    dmaLatchPolled = false;
+    rp2040EndLatch();
+  }
+  critical_section_exit(&dmaLock);
+}
+
+// Private, latch alarm callback (interrupt context)
+int64_t Adafruit_NeoPixel::rp2040LatchAlarm(alarm_id_t id, void *user_data) {
+  (void)id;
+  Adafruit_NeoPixel *strip = (Adafruit_NeoPixel *)user_data;
+
+  critical_section_enter_blocking(&strip->dmaLock);
+  strip->rp2040EndLatch();
+  critical_section_exit(&strip->dmaLock);
+  return 0; // One-shot
 }
 #endif
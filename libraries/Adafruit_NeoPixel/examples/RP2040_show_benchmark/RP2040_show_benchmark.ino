@@ -0,0 +1,73 @@
+// RP2040 show() throughput benchmark for the Adafruit NeoPixel library.
+// Released under the GPLv3 license to match the rest of the
+// Adafruit NeoPixel library
+//
+// Times show() and showAsync() for strips of 1, 60 and 300 pixels and
+// prints the CPU time per call, the wire time and the number of PIO FIFO
+// writes. With packed pixel words there is one FIFO write per pixel
+// (it was one per byte), so the blocking path issues 3x fewer writes for
+// RGB and 4x fewer for RGBW; showAsync() returns after packing the words
+// and leaves the transfer to DMA.
+//
+// Nothing needs to be connected, but a strip on PIN shows the test pattern.
+
+#include <Adafruit_NeoPixel.h>
+
+#if !defined(ARDUINO_ARCH_RP2040)
+#error This benchmark is for RP2040 boards only
+#endif
+
+#define PIN        6  // Any free GPIO
+#define ITERATIONS 100
+
+const uint16_t lengths[] = { 1, 60, 300 };
+
+void runBenchmark(uint16_t numPixels, neoPixelType type, const char *name) {
+  Adafruit_NeoPixel strip(numPixels, PIN, type);
+  strip.begin();
+  for (uint16_t i = 0; i < numPixels; i++)
+    strip.setPixelColor(i, strip.ColorHSV(i * 65536L / numPixels, 255, 32));
+
+  // Blocking show(): waits for the previous latch and pushes every word
+  uint32_t showUs = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    while (!strip.canShow())
+      ;
+    uint32_t start = micros();
+    strip.show();
+    showUs += micros() - start;
+  }
+
+  // showAsync(): only the packing is on the CPU
+  uint32_t asyncUs = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    while (!strip.showComplete())
+      ;
+    uint32_t start = micros();
+    strip.showAsync();
+    asyncUs += micros() - start;
+  }
+  while (!strip.showComplete())
+    ;
+
+  uint8_t bytesPerPixel = (type & 0xC0) == ((type & 0x30) << 2) ? 3 : 4;
+  Serial.printf("%-4s %4u px  show() %6lu us  showAsync() %4lu us  "
+                "wire %6lu us  FIFO writes %u (was %u)\n",
+                name, numPixels, showUs / ITERATIONS, asyncUs / ITERATIONS,
+                (unsigned long)numPixels * bytesPerPixel * 10, numPixels,
+                numPixels * bytesPerPixel);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 3000)
+    ;
+  Serial.println("RP2040 NeoPixel show() benchmark");
+
+  for (uint16_t n : lengths)
+    runBenchmark(n, NEO_GRB + NEO_KHZ800, "RGB");
+  for (uint16_t n : lengths)
+    runBenchmark(n, NEO_GRBW + NEO_KHZ800, "RGBW");
+}
+
+void loop() {}
@@ -3,7 +3,9 @@
 // -------------------------------------------------- //
 
 // Unless you know what you are doing...
-// Lines 47 and 52 have been edited to set transmit bit count
+// Lines 47 and 52 have been edited to set transmit bit count. The library
+// passes 24 (RGB) or 32 (RGBW) so each FIFO word carries a whole pixel,
+// left-aligned; the program itself shifts out any number of bits.
 
 #if !PICO_NO_HARDWARE
 #include "hardware/pio.h"
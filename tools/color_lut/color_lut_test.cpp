@@ -0,0 +1,129 @@
+/**
+ * @file color_lut_test.cpp
+ * @brief Compares the fixed-point distance colors with the float code they replaced.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Usage: color_lut_test
+ *
+ * Sweeps distance 0-1300 cm, strength 0-255 in steps of 5 and velocity
+ * -20/0/20 cm/s. Each point is fed to the float code until its smoothing has
+ * settled, and compared with distanceColor() of the settled fixed-point
+ * average (which equals the input). Exits with 1 if any channel differs by
+ * more than one LSB.
+ */
+
+#include "color_lut.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+/** @brief Largest allowed difference per channel. */
+static const int MAX_ERROR_LSB = 1;
+/** @brief Samples fed to the float smoothing before its output is compared. */
+static const int SETTLE_SAMPLES = 64;
+
+/** @brief The float smoothing factor of the former code. */
+static const float NEOPIXEL_SMOOTHING_ALPHA = 0.3f;
+
+/**
+ * @brief The former float distance color, as it was before color_lut.h.
+ */
+struct FloatDistanceColor {
+  bool smoothing_initialized = false;
+  float smoothed_distance = 0;
+  float smoothed_strength = 0;
+
+  uint32_t calculate(uint16_t distance_cm, float velocity_cm_s, uint8_t signal_strength) {
+    if (!smoothing_initialized) {
+      smoothed_distance = distance_cm;
+      smoothed_strength = signal_strength;
+      smoothing_initialized = true;
+    } else {
+      smoothed_distance = NEOPIXEL_SMOOTHING_ALPHA * distance_cm + (1.0f - NEOPIXEL_SMOOTHING_ALPHA) * smoothed_distance;
+      smoothed_strength = NEOPIXEL_SMOOTHING_ALPHA * signal_strength + (1.0f - NEOPIXEL_SMOOTHING_ALPHA) * smoothed_strength;
+    }
+
+    float distance = smoothed_distance;
+    float strength = smoothed_strength;
+    if (distance < MIN_DISTANCE_CM) distance = MIN_DISTANCE_CM;
+    if (distance > MAX_DISTANCE_CM) distance = MAX_DISTANCE_CM;
+    float position = (distance - MIN_DISTANCE_CM) / (MAX_DISTANCE_CM - MIN_DISTANCE_CM);
+
+    uint8_t r, g, b;
+    if (position <= 0.5f) {
+      float local_pos = position * 2.0f;
+      r = 255;
+      g = (uint8_t)(255 * local_pos);
+      b = 0;
+    } else {
+      float local_pos = (position - 0.5f) * 2.0f;
+      r = (uint8_t)(255 * (1.0f - local_pos));
+      g = (uint8_t)(255 * (1.0f - local_pos));
+      b = (uint8_t)(255 * local_pos);
+    }
+
+    float saturation_factor = 1.0f;
+    if (std::fabs(velocity_cm_s) > 5.0f) {
+      if (velocity_cm_s < -5.0f) {
+        saturation_factor = 1.2f;
+      } else if (velocity_cm_s > 5.0f) {
+        saturation_factor = 0.7f;
+      }
+    }
+    r = (uint8_t)std::min(std::max(r * saturation_factor, 0.0f), 255.0f);
+    g = (uint8_t)std::min(std::max(g * saturation_factor, 0.0f), 255.0f);
+    b = (uint8_t)std::min(std::max(b * saturation_factor, 0.0f), 255.0f);
+
+    float brightness = 0.3f + 0.7f * (strength / 255.0f);
+    r = (uint8_t)(r * brightness);
+    g = (uint8_t)(g * brightness);
+    b = (uint8_t)(b * brightness);
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+};
+
+/**
+ * @brief Gets the largest per-channel difference of two colors.
+ */
+static int channelError(uint32_t a, uint32_t b) {
+  int error = 0;
+  for (int shift = 0; shift <= 16; shift += 8) {
+    error = std::max(error, std::abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)));
+  }
+  return error;
+}
+
+int main() {
+  static const float VELOCITIES[] = {-20.0f, 0.0f, 20.0f};
+  int worst = 0;
+  long points = 0;
+  long differing = 0;
+
+  for (float velocity : VELOCITIES) {
+    for (int strength = 0; strength <= 255; strength += 5) {
+      for (int distance = 0; distance <= 1300; distance++) {
+        FloatDistanceColor reference;
+        uint32_t expected = 0;
+        for (int i = 0; i < SETTLE_SAMPLES; i++) {
+          expected = reference.calculate(distance, velocity, strength);
+        }
+        uint32_t actual = distanceColor(distance << 8, velocity, (uint32_t)strength << 8);
+
+        int error = channelError(expected, actual);
+        points++;
+        if (error > 0) differing++;
+        if (error > worst) {
+          worst = error;
+          printf("d=%d s=%d v=%.0f: float 0x%06X, fixed 0x%06X (%d LSB)\n",
+                 distance, strength, velocity, expected, actual, error);
+        }
+      }
+    }
+  }
+
+  printf("%ld points, %ld differ, largest difference %d LSB\n", points, differing, worst);
+  return worst > MAX_ERROR_LSB ? 1 : 0;
+}
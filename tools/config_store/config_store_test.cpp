@@ -0,0 +1,167 @@
+/**
+ * @file config_store_test.cpp
+ * @brief Host test of the A/B configuration store on a RAM image of the flash region.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Usage: config_store_test
+ *
+ * Builds config_store.cpp, flash_region.cpp and crc.cpp from the firmware
+ * unchanged, with the SDK flash calls writing a RAM image that behaves like
+ * NOR flash (erase sets bytes to 0xFF, program only clears bits). The cases
+ * run in order on one store, as the Core 1 loop would drive it: coalescing
+ * of queued saves, a failed verification, an erase dropping a save in
+ * flight, and the generation numbering. Exits with 1 if any check fails.
+ */
+
+#include "config_store.h"
+#include "flash_region.h"
+#include "trace.h"
+#include <cstdarg>
+#include <cstdio>
+
+/** @brief Size of the RAM flash region below; the store uses its first two sectors. */
+#define TEST_REGION_SIZE (64u * 1024u)
+
+// The region, bounded by the symbols the arduino-pico linker script defines
+asm(".data\n"
+    ".balign 4096\n"
+    ".global _FS_start\n"
+    "_FS_start: .space 65536, 0xFF\n"
+    ".global _FS_end\n"
+    "_FS_end:\n"
+    ".text\n");
+extern uint8_t _FS_start;
+extern uint8_t _FS_end;
+
+static int failures = 0;
+static uint32_t fake_micros = 0;
+/** @brief Programs left before the next one is corrupted; negative for none. */
+static int corrupt_program_after = -1;
+
+#define CHECK(condition)                                             \
+  do {                                                               \
+    if (!(condition)) {                                              \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);    \
+      failures++;                                                    \
+    }                                                                \
+  } while (0)
+
+// Firmware dependencies of the store
+RP2040 rp2040;
+void RP2040::idleOtherCore() {}
+void RP2040::resumeOtherCore() {}
+void noInterrupts() {}
+void interrupts() {}
+uint32_t micros() { return fake_micros += 45000; }
+bool isDebugEnabled() { return false; }
+void traceRecord(TraceEventType, TraceId, uint16_t) {}
+void safeSerialPrintln(const char* msg) { printf("  %s\n", msg); }
+void safeSerialPrintfln(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  printf("  ");
+  vprintf(format, args);
+  printf("\n");
+  va_end(args);
+}
+
+/**
+ * @brief Maps an SDK flash offset to the RAM image.
+ */
+static uint8_t* imageAt(uint32_t flash_offs) {
+  return (uint8_t*)((uintptr_t)&_FS_start + (flash_offs - (uint32_t)((uintptr_t)&_FS_start - XIP_BASE)));
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+  memset(imageAt(flash_offs), 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count) {
+  uint8_t* image = imageAt(flash_offs);
+  for (size_t i = 0; i < count; i++) image[i] &= data[i];
+  if (corrupt_program_after >= 0 && corrupt_program_after-- == 0) image[8] ^= 0x01;
+}
+
+/**
+ * @brief Runs the store until its queue is empty.
+ * @return The number of configStoreService() calls.
+ */
+static int serviceUntilIdle() {
+  int calls = 0;
+  while (configStoreBusy() && calls < 16) {
+    configStoreService();
+    calls++;
+  }
+  CHECK(!configStoreBusy());
+  return calls;
+}
+
+/**
+ * @brief Makes a test image told apart by its first reserved byte.
+ */
+static ConfigImage testImage(uint8_t marker) {
+  ConfigImage image;
+  memset(&image, 0, sizeof(image));
+  image.version = 1;
+  image.reserved[0] = marker;
+  return image;
+}
+
+int main() {
+  CHECK(flashRegionSize() == TEST_REGION_SIZE);
+  CHECK(configStoreActive() == nullptr);
+  CHECK(configStoreGeneration() == 0);
+
+  printf("Queued saves are coalesced\n");
+  uint32_t t1 = configStoreQueueSave(testImage(1));
+  CHECK(configStoreCommitStatus(t1) == CONFIG_COMMIT_PENDING);
+  configStoreService();  // t1 is taken and its slot erased
+  uint32_t t2 = configStoreQueueSave(testImage(2));
+  uint32_t t3 = configStoreQueueSave(testImage(3));  // Replaces t2 before it is written
+  CHECK(serviceUntilIdle() == 3);                      // t1 program, t3 erase and program
+  CHECK(configStoreCommitStatus(t1) == CONFIG_COMMIT_DONE);
+  CHECK(configStoreCommitStatus(t2) == CONFIG_COMMIT_DONE);
+  CHECK(configStoreCommitStatus(t3) == CONFIG_COMMIT_DONE);
+  CHECK(configStoreActive() != nullptr && configStoreActive()->reserved[0] == 3);
+  CHECK(configStoreGeneration() == 2);
+
+  printf("A failed verification keeps the previous record\n");
+  corrupt_program_after = 0;
+  uint32_t t4 = configStoreQueueSave(testImage(4));
+  serviceUntilIdle();
+  CHECK(configStoreCommitStatus(t4) == CONFIG_COMMIT_FAILED);
+  CHECK(configStoreActive()->reserved[0] == 3);
+  CHECK(configStoreGeneration() == 2);
+
+  printf("A newer save that succeeds also completes the older failed ticket\n");
+  uint32_t t5 = configStoreQueueSave(testImage(5));
+  serviceUntilIdle();
+  CHECK(configStoreCommitStatus(t5) == CONFIG_COMMIT_DONE);
+  CHECK(configStoreCommitStatus(t4) == CONFIG_COMMIT_DONE);
+  CHECK(configStoreActive()->reserved[0] == 5);
+  CHECK(configStoreGeneration() == 3);
+
+  printf("An erase drops the save in flight\n");
+  uint32_t t6 = configStoreQueueSave(testImage(6));
+  configStoreService();  // t6 erased its slot but is not programmed yet
+  configStoreQueueErase();
+  CHECK(configStoreCommitStatus(t6) == CONFIG_COMMIT_FAILED);
+  serviceUntilIdle();
+  CHECK(configStoreCommitStatus(t6) == CONFIG_COMMIT_FAILED);
+  CHECK(configStoreActive() == nullptr);
+  CHECK(flashRegionBlank(0, 2 * FLASH_SECTOR_SIZE));
+
+  printf("Generations restart after an erase\n");
+  uint32_t t7 = configStoreQueueSave(testImage(7));
+  serviceUntilIdle();
+  CHECK(configStoreCommitStatus(t7) == CONFIG_COMMIT_DONE);
+  CHECK(configStoreActive()->reserved[0] == 7);
+  CHECK(configStoreGeneration() == 1);
+
+  const FlashRegionStats& stats = flashRegionGetStats();
+  printf("%lu erases, %lu programs\n", (unsigned long)stats.erases, (unsigned long)stats.programs);
+  printf(failures ? "%d checks failed\n" : "All checks passed\n", failures);
+  return failures ? 1 : 0;
+}
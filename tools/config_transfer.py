@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+LiDAR Config Transfer - reads or writes the complete device configuration (thresholds,
+trigger rules, mode and runtime globals) in one CRC-protected bulk transfer over the GUI
+protocol ('B'/'b' commands).
+
+Read a configured device into an image file, then write that image to further devices
+to commission them. The device must be in configuration mode.
+
+Usage: config_transfer.py --port COM5 read config.bin
+       config_transfer.py --port COM5 write config.bin [--no-save]
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+START_BYTE = 0x7E
+CMD_BULK_READ = ord('B')
+CMD_BULK_WRITE = ord('b')
+RSP_ACK = 0x06
+RSP_NAK = 0x15
+READ_HEADER_SIZE = 8
+MAX_PAYLOAD = 64
+OP_BEGIN = 0
+OP_DATA = 1
+OP_COMMIT = 2
+IMAGE_VERSION = 1  # Must match CONFIG_IMAGE_VERSION in storage.h
+RESPONSE_TIMEOUT_S = 2.0
+
+
+def create_packet(command: int, payload: bytes = b'') -> bytes:
+    body = bytes([command, len(payload)]) + payload
+    return bytes([START_BYTE]) + body + bytes([sum(body) & 0xFF])
+
+
+def read_response(ser: serial.Serial, command: int) -> bytes:
+    """Returns the payload of the next valid response to command, skipping debug text."""
+    buffer = bytearray()
+    deadline = time.time() + RESPONSE_TIMEOUT_S
+    while time.time() < deadline:
+        buffer += ser.read(ser.in_waiting or 1)
+        while True:
+            start = buffer.find(START_BYTE)
+            if start < 0:
+                buffer.clear()
+                break
+            del buffer[:start]
+            if len(buffer) < 4 or len(buffer) < 4 + buffer[2]:
+                break
+            length = buffer[2]
+            packet = bytes(buffer[:4 + length])
+            if (sum(packet[1:3 + length]) & 0xFF) != packet[3 + length]:
+                del buffer[:1]
+                continue
+            del buffer[:4 + length]
+            if packet[1] == RSP_NAK:
+                raise RuntimeError(f"Device rejected request (NAK 0x{packet[3]:02X})")
+            if packet[1] == command or (packet[1] == RSP_ACK and packet[3] == command):
+                return packet[3:3 + length]
+    raise TimeoutError("No response from device")
+
+
+def read_image(ser: serial.Serial) -> bytes:
+    image = bytearray()
+    expected_crc = None
+    while True:
+        ser.write(create_packet(CMD_BULK_READ, struct.pack('<H', len(image))))
+        payload = read_response(ser, CMD_BULK_READ)
+        offset, total, crc = struct.unpack_from('<HHI', payload, 0)
+        if offset != len(image):
+            raise RuntimeError(f"Unexpected chunk offset {offset}")
+        expected_crc = crc
+        image += payload[READ_HEADER_SIZE:]
+        if len(image) >= total or len(payload) == READ_HEADER_SIZE:
+            break
+    if zlib.crc32(image) != expected_crc:
+        raise RuntimeError("CRC mismatch in configuration read back from device")
+    return bytes(image)
+
+
+def write_image(ser: serial.Serial, image: bytes, save: bool) -> None:
+    ser.write(create_packet(CMD_BULK_WRITE, struct.pack('<BHI', OP_BEGIN, len(image), zlib.crc32(image))))
+    read_response(ser, CMD_BULK_WRITE)
+    chunk_size = MAX_PAYLOAD - 3
+    for offset in range(0, len(image), chunk_size):
+        ser.write(create_packet(CMD_BULK_WRITE, struct.pack('<BH', OP_DATA, offset) + image[offset:offset + chunk_size]))
+        read_response(ser, CMD_BULK_WRITE)
+    ser.write(create_packet(CMD_BULK_WRITE, bytes([OP_COMMIT, 1 if save else 0])))
+    read_response(ser, CMD_BULK_WRITE)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Read or write the complete LiDAR controller configuration")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("action", choices=["read", "write"], help="Read the device into FILE or write FILE to the device")
+    parser.add_argument("file", help="Configuration image file")
+    parser.add_argument("--no-save", action="store_true", help="Apply without saving to flash (write only)")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.05) as ser:
+        ser.reset_input_buffer()
+        started = time.time()
+        if args.action == "read":
+            image = read_image(ser)
+            with open(args.file, "wb") as f:
+                f.write(image)
+        else:
+            with open(args.file, "rb") as f:
+                image = f.read()
+            if not image or image[0] != IMAGE_VERSION:
+                print(f"{args.file} is not a version {IMAGE_VERSION} configuration image", file=sys.stderr)
+                return 1
+            write_image(ser, image, not args.no_save)
+        elapsed_ms = (time.time() - started) * 1000
+
+    print(f"{args.action.capitalize()} {len(image)} bytes (CRC-32 0x{zlib.crc32(image):08X}) in {elapsed_ms:.0f} ms")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,156 @@
+/**
+ * @file frame_codec_bench.cpp
+ * @brief Compression ratio and speed of the frame codec on recorded or synthetic traffic.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Usage: frame_codec_bench [frames.csv | log.bin]
+ *
+ * frames.csv is the output of recorder_dump.py --csv, log.bin a raw log
+ * saved with recorder_dump.py --raw. Without an argument a synthetic 1000 Hz
+ * trace is used: a slowly moving target with a few cm of noise, strength
+ * noise of tens of units and micros() timestamps with polling jitter.
+ *
+ * The frames are re-encoded as one stream, decoded back and compared; the
+ * decoder is also started mid-stream to check that it recovers at the next
+ * keyframe. Times are the best of several passes on this host, so they
+ * compare encodings rather than predict RP2040 cycle counts. Exits with 1 if
+ * any frame does not survive the round trip.
+ */
+
+#include "frame_stream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+/** @brief Bytes per frame without compression: distance, strength, temperature, timestamp and sensor. */
+static const double RAW_FRAME_BYTES = 11.0;
+/** @brief Timed passes over the trace; the fastest counts. */
+static const int BENCH_PASSES = 20;
+
+static bool readCsv(const std::string& path, std::vector<LidarFrame>& frames) {
+  std::ifstream file(path);
+  std::string line;
+  if (!file || !std::getline(file, line)) return false;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    unsigned long timestamp, sensor, distance, strength, temperature;
+    char comma;
+    if (!(fields >> timestamp >> comma >> sensor >> comma >> distance >> comma >> strength >> comma >> temperature)) {
+      return false;
+    }
+    frames.push_back({(uint16_t)distance, (uint16_t)strength, (uint16_t)temperature, (uint32_t)timestamp,
+                      (uint8_t)(sensor % MAX_LIDAR_SENSORS)});
+  }
+  return true;
+}
+
+static bool readLog(const std::string& path, std::vector<LidarFrame>& frames) {
+  std::ifstream file(path, std::ios::binary);
+  std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  RecorderLogStats stats;
+  if (!decodeRecorderLog(image, frames, stats)) return false;
+  printf("Log: %u sectors (%u bad, %u sequence gaps), %.2f bytes/frame as recorded\n", stats.sectors,
+         stats.bad_sectors, stats.sequence_gaps, (double)stats.data_bytes / frames.size());
+  return true;
+}
+
+static void synthesize(std::vector<LidarFrame>& frames, size_t count) {
+  std::mt19937 random(1);
+  std::normal_distribution<double> distance_noise(0.0, 1.0);
+  std::normal_distribution<double> strength_noise(0.0, 12.0);
+  std::uniform_int_distribution<int> poll_jitter(0, 30);
+  double target = 250.0;
+  double speed = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    speed = 0.999 * speed + 0.0005 * distance_noise(random);
+    target = std::min(1200.0, std::max(20.0, target + speed));
+    double strength = 40000.0 / target + strength_noise(random);
+    LidarFrame frame;
+    frame.distance = (uint16_t)(target + distance_noise(random));
+    frame.strength = (uint16_t)std::max(0.0, strength);
+    frame.temperature = (uint16_t)(2600 + (i / 30000));
+    frame.timestamp = (uint32_t)(1000000 + i * 1000 + poll_jitter(random));
+    frame.sensor_id = 0;
+    frames.push_back(frame);
+  }
+}
+
+static bool sameFrame(const LidarFrame& a, const LidarFrame& b) {
+  return a.distance == b.distance && a.strength == b.strength && a.temperature == b.temperature &&
+         a.timestamp == b.timestamp && a.sensor_id == b.sensor_id;
+}
+
+int main(int argc, char** argv) {
+  std::vector<LidarFrame> frames;
+  if (argc > 1) {
+    std::string path = argv[1];
+    bool csv = path.size() > 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (!(csv ? readCsv(path, frames) : readLog(path, frames)) || frames.empty()) {
+      fprintf(stderr, "Cannot read frames from %s\n", path.c_str());
+      return 2;
+    }
+  } else {
+    synthesize(frames, 200000);
+  }
+
+  std::vector<uint8_t> stream(frames.size() * FRAME_CODEC_MAX_FRAME_BYTES);
+  std::vector<size_t> boundaries;
+  size_t encoded = 0;
+  double encode_ns = 1e30;
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    FrameCodecState state;
+    frameCodecReset(state);
+    boundaries.clear();
+    encoded = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const LidarFrame& frame : frames) {
+      boundaries.push_back(encoded);
+      encoded += frameCodecEncode(state, frame, &stream[encoded]);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    encode_ns = std::min(encode_ns, elapsed.count() / frames.size());
+  }
+
+  std::vector<LidarFrame> decoded;
+  double decode_ns = 1e30;
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    FrameStreamDecoder decoder;
+    decoded.clear();
+    decoded.reserve(frames.size());
+    auto start = std::chrono::steady_clock::now();
+    decoder.decode(stream.data(), encoded, decoded);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    decode_ns = std::min(decode_ns, elapsed.count() / frames.size());
+  }
+
+  size_t mismatches = decoded.size() == frames.size() ? 0 : 1;
+  for (size_t i = 0; i < decoded.size() && i < frames.size(); i++) {
+    if (!sameFrame(decoded[i], frames[i])) mismatches++;
+  }
+
+  // Join at an arbitrary frame: everything from the next keyframe on must match
+  size_t join = frames.size() / 3;
+  FrameStreamDecoder joiner;
+  std::vector<LidarFrame> joined;
+  joiner.decode(&stream[boundaries[join]], encoded - boundaries[join], joined);
+  size_t skipped = joiner.undecodable();
+  for (size_t i = 0; i < joined.size(); i++) {
+    if (!sameFrame(joined[i], frames[join + skipped + i])) mismatches++;
+  }
+
+  double bytes_per_frame = (double)encoded / frames.size();
+  printf("Frames:          %zu\n", frames.size());
+  printf("Encoded:         %zu bytes, %.2f bytes/frame\n", encoded, bytes_per_frame);
+  printf("Ratio:           %.2f:1 against %.0f raw bytes/frame\n", RAW_FRAME_BYTES / bytes_per_frame, RAW_FRAME_BYTES);
+  printf("Encode:          %.1f ns/frame\n", encode_ns);
+  printf("Decode:          %.1f ns/frame\n", decode_ns);
+  printf("Mid-stream join: %zu frames skipped before the first keyframe\n", skipped);
+  printf("Round trip:      %s\n", mismatches == 0 ? "exact" : "MISMATCH");
+  return mismatches == 0 ? 0 : 1;
+}
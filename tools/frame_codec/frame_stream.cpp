@@ -0,0 +1,105 @@
+/**
+ * @file frame_stream.cpp
+ * @brief Host-side decoding of frame codec streams and recorder logs.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ */
+
+#include "frame_stream.h"
+#include <algorithm>
+#include <string.h>
+
+/**
+ * @brief Decodes every complete frame in a buffer.
+ * @param data The encoded bytes, starting at a frame boundary.
+ * @param length The number of bytes.
+ * @param frames Receives the decoded frames.
+ * @return The bytes consumed. Less than length if the buffer ends in a
+ *         partial frame (pass the rest again with more data) or holds a
+ *         malformed one.
+ */
+size_t FrameStreamDecoder::decode(const uint8_t* data, size_t length, std::vector<LidarFrame>& frames) {
+  size_t position = 0;
+  while (position < length) {
+    LidarFrame frame;
+    bool decoded;
+    size_t used = frameCodecDecode(state_, data + position, length - position, frame, decoded);
+    if (used == 0) break;
+    position += used;
+    if (decoded) {
+      frames.push_back(frame);
+    } else {
+      undecodable_++;
+    }
+  }
+  return position;
+}
+
+/**
+ * @brief Calculates the CRC-32 used in recorder sector headers (the same as zlib.crc32).
+ */
+uint32_t recorderCrc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Decodes a raw recorder log image, oldest sector first.
+ * @param image Whole sectors in device order, as saved by recorder_dump.py --raw.
+ * @param frames Receives the decoded frames.
+ * @param stats Receives the sector totals.
+ * @return True if at least one sector was decoded.
+ */
+bool decodeRecorderLog(const std::vector<uint8_t>& image, std::vector<LidarFrame>& frames, RecorderLogStats& stats) {
+  memset(&stats, 0, sizeof(stats));
+  std::vector<RecorderSectorHeader> headers;
+  std::vector<size_t> offsets;
+  uint32_t newest = 0;
+
+  for (size_t offset = 0; offset + RECORDER_SECTOR_SIZE <= image.size(); offset += RECORDER_SECTOR_SIZE) {
+    RecorderSectorHeader header;
+    memcpy(&header, &image[offset], sizeof(header));
+    if (header.magic != RECORDER_SECTOR_MAGIC) continue;
+    if (headers.empty() || (int32_t)(header.sequence - newest) > 0) newest = header.sequence;
+    headers.push_back(header);
+    offsets.push_back(offset);
+  }
+
+  // Oldest first: order by distance behind the newest sequence number
+  std::vector<size_t> order(headers.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return (uint32_t)(headers[a].sequence - newest - 1) < (uint32_t)(headers[b].sequence - newest - 1);
+  });
+
+  bool any = false;
+  for (size_t n = 0; n < order.size(); n++) {
+    const RecorderSectorHeader& header = headers[order[n]];
+    const uint8_t* data = &image[offsets[order[n]] + sizeof(RecorderSectorHeader)];
+    stats.sectors++;
+    if (n > 0 && header.sequence != headers[order[n - 1]].sequence + 1) stats.sequence_gaps++;
+
+    if (header.format != RECORDER_FORMAT_VERSION ||
+        header.data_bytes > RECORDER_SECTOR_SIZE - sizeof(RecorderSectorHeader) ||
+        recorderCrc32(data, header.data_bytes) != header.crc) {
+      stats.bad_sectors++;
+      continue;
+    }
+    FrameStreamDecoder decoder;
+    std::vector<LidarFrame> sector_frames;
+    if (decoder.decode(data, header.data_bytes, sector_frames) != header.data_bytes ||
+        sector_frames.size() != header.frame_count) {
+      stats.bad_sectors++;
+      continue;
+    }
+    frames.insert(frames.end(), sector_frames.begin(), sector_frames.end());
+    stats.data_bytes += header.data_bytes;
+    any = true;
+  }
+  return any;
+}
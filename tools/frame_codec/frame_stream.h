@@ -0,0 +1,75 @@
+/**
+ * @file frame_stream.h
+ * @brief Host-side decoding of frame codec streams and recorder logs.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Builds against the firmware's frame_codec.cpp, so the host decodes
+ * with exactly the code the device encodes with. See the Makefile.
+ */
+#ifndef FRAME_STREAM_H
+#define FRAME_STREAM_H
+
+#include "frame_codec.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/** @brief Must match RECORDER_SECTOR_MAGIC in recorder.h. */
+#define RECORDER_SECTOR_MAGIC 0x4345524CUL
+/** @brief Must match RECORDER_FORMAT_VERSION in recorder.h. */
+#define RECORDER_FORMAT_VERSION 2
+/** @brief Recorder log sector size (FLASH_SECTOR_SIZE on the device). */
+#define RECORDER_SECTOR_SIZE 4096
+
+/**
+ * @brief Must match RecorderSectorHeader in recorder.h.
+ */
+struct RecorderSectorHeader {
+  uint32_t magic;
+  uint32_t sequence;
+  uint32_t crc;
+  uint16_t data_bytes;
+  uint16_t frame_count;
+  uint8_t format;
+  uint8_t reserved[3];
+};
+
+/**
+ * @brief Totals from decodeRecorderLog().
+ */
+struct RecorderLogStats {
+  uint32_t sectors;         ///< Sectors with a valid header.
+  uint32_t bad_sectors;     ///< Sectors skipped for a CRC, format or decode error.
+  uint32_t sequence_gaps;   ///< Breaks in the sector sequence (sectors lost before they reached flash).
+  uint32_t data_bytes;      ///< Encoded frame bytes in the decoded sectors.
+};
+
+/**
+ * @brief Decodes a stream of concatenated frames, possibly arriving in pieces.
+ */
+class FrameStreamDecoder {
+ public:
+  FrameStreamDecoder() { reset(); }
+
+  /** @brief Forgets all predictors, as at the start of a stream or recorder sector. */
+  void reset() {
+    frameCodecReset(state_);
+    undecodable_ = 0;
+  }
+
+  size_t decode(const uint8_t* data, size_t length, std::vector<LidarFrame>& frames);
+
+  /** @brief Frames skipped because their sensor had no keyframe yet. */
+  uint32_t undecodable() const { return undecodable_; }
+
+ private:
+  FrameCodecState state_;
+  uint32_t undecodable_;
+};
+
+uint32_t recorderCrc32(const uint8_t* data, size_t length);
+bool decodeRecorderLog(const std::vector<uint8_t>& image, std::vector<LidarFrame>& frames, RecorderLogStats& stats);
+
+#endif // FRAME_STREAM_H
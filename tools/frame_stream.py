@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""
+LiDAR Frame Stream - decoder for the firmware's frame codec (frame_codec.h).
+
+Frames decode to (timestamp_us, sensor, distance_cm, strength, temperature) tuples.
+A FrameDecoder keeps per-sensor predictors across calls, exactly as the firmware's
+FrameCodecState does, so feed it one stream (or one recorder sector) from the start
+or from any frame boundary; frames of a sensor before its first keyframe are counted
+in `undecodable` and skipped. tools/frame_codec holds the same decoder in C++.
+"""
+
+SENSOR_MASK = 0x03
+DISTANCE_SHIFT = 2
+DISTANCE_MASK = 0x07
+DISTANCE_ESCAPE = 7
+TIMING_SHIFT = 5
+TIMING_MASK = 0x03
+TIMING_ESCAPE = 3
+EXTENDED = 0x80
+EXT_KEYFRAME = 0x01
+EXT_TEMPERATURE = 0x02
+MAX_SENSORS = 4
+
+
+def read_varint(data: bytes, pos: int) -> tuple:
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+
+
+def unzigzag(value: int) -> int:
+    return (value >> 1) ^ -(value & 1)
+
+
+def to_int32(value: int) -> int:
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+class Predictor:
+    def __init__(self):
+        self.valid = False
+        self.distance = 0
+        self.strength = 0
+        self.temperature = 0
+        self.timestamp = 0
+        self.interval_q4 = 0
+
+    def predicted_interval(self) -> int:
+        return ((self.interval_q4 + 8) >> 4) & 0xFFFFFFFF
+
+    def track_interval(self, interval: int) -> None:
+        interval_q4 = to_int32(interval << 4)
+        if self.interval_q4 == 0:
+            self.interval_q4 = interval_q4
+        else:
+            self.interval_q4 = to_int32(self.interval_q4 + ((interval_q4 - self.interval_q4) >> 3))
+
+
+class FrameDecoder:
+    def __init__(self):
+        self.reset()
+
+    def reset(self) -> None:
+        self.sensors = [Predictor() for _ in range(MAX_SENSORS)]
+        self.undecodable = 0
+
+    def decode_frame(self, data: bytes, pos: int) -> tuple:
+        """Decodes the frame at pos; returns (frame or None, next pos). Raises IndexError if truncated."""
+        header = data[pos]
+        pos += 1
+        extension = 0
+        if header & EXTENDED:
+            extension = data[pos]
+            pos += 1
+        sensor = header & SENSOR_MASK
+        p = self.sensors[sensor]
+
+        if extension & EXT_KEYFRAME:
+            values = []
+            for _ in range(5):
+                value, pos = read_varint(data, pos)
+                values.append(value)
+            p.distance, p.strength, p.temperature, p.timestamp, nominal = values
+            p.interval_q4 = nominal << 4
+            p.valid = True
+        else:
+            distance_code = (header >> DISTANCE_SHIFT) & DISTANCE_MASK
+            timing_code = (header >> TIMING_SHIFT) & TIMING_MASK
+            distance_delta = distance_code - 3
+            residual = {0: 0, 1: -1, 2: 1}.get(timing_code, 0)
+            temperature_delta = 0
+            if distance_code == DISTANCE_ESCAPE:
+                value, pos = read_varint(data, pos)
+                distance_delta = unzigzag(value)
+            value, pos = read_varint(data, pos)
+            strength_delta = unzigzag(value)
+            if timing_code == TIMING_ESCAPE:
+                value, pos = read_varint(data, pos)
+                residual = unzigzag(value)
+            if extension & EXT_TEMPERATURE:
+                value, pos = read_varint(data, pos)
+                temperature_delta = unzigzag(value)
+            if not p.valid:
+                self.undecodable += 1
+                return None, pos
+            interval = (p.predicted_interval() + residual) & 0xFFFFFFFF
+            p.distance = (p.distance + distance_delta) & 0xFFFF
+            p.strength = (p.strength + strength_delta) & 0xFFFF
+            p.temperature = (p.temperature + temperature_delta) & 0xFFFF
+            p.timestamp = (p.timestamp + interval) & 0xFFFFFFFF
+            p.track_interval(interval)
+
+        return (p.timestamp, sensor, p.distance, p.strength, p.temperature), pos
+
+    def decode(self, data: bytes, count: int = -1) -> list:
+        """Decodes up to count frames (all complete frames if count < 0)."""
+        frames = []
+        pos = 0
+        while pos < len(data) and count != 0:
+            try:
+                frame, pos = self.decode_frame(data, pos)
+            except IndexError:
+                break
+            if frame is not None:
+                frames.append(frame)
+            count -= 1
+        return frames
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+LiDAR GUI Benchmark - measures the GUI link from the host side: command round-trip
+time over protocol v1 and v2, pipelined v2 request throughput and, in normal
+operation, the sustained telemetry stream rate.
+
+Run it against firmware builds before and after a transport change and compare the
+reports. The telemetry test needs the device in normal operation; the others work
+in either mode.
+
+Usage: gui_benchmark.py --port COM5 [--baud 115200] [--count 500] [--seconds 5]
+"""
+
+import argparse
+import statistics
+import sys
+import time
+
+import serial
+
+from gui_protocol_v2 import GuiClientV2
+
+START_BYTE = 0x7E
+CMD_STATUS = ord('S')
+CMD_PROTOCOL_INFO = ord('P')
+CMD_SUBSCRIBE = ord('Y')
+CMD_TELEMETRY = ord('y')
+RESPONSE_TIMEOUT_S = 1.0
+
+
+def create_packet(command: int, payload: bytes = b'') -> bytes:
+    body = bytes([command, len(payload)]) + payload
+    return bytes([START_BYTE]) + body + bytes([sum(body) & 0xFF])
+
+
+def read_v1_response(ser: serial.Serial, command: int, buffer: bytearray) -> bytes:
+    deadline = time.time() + RESPONSE_TIMEOUT_S
+    while time.time() < deadline:
+        buffer += ser.read(ser.in_waiting or 1)
+        while True:
+            start = buffer.find(START_BYTE)
+            if start < 0:
+                buffer.clear()
+                break
+            del buffer[:start]
+            if len(buffer) < 4 or len(buffer) < 4 + buffer[2]:
+                break
+            length = buffer[2]
+            packet = bytes(buffer[:4 + length])
+            if (sum(packet[1:3 + length]) & 0xFF) != packet[3 + length]:
+                del buffer[:1]
+                continue
+            del buffer[:4 + length]
+            if packet[1] == command:
+                return packet[3:3 + length]
+    raise TimeoutError("No v1 response from device")
+
+
+def summarize(name: str, samples_s: list) -> None:
+    samples_us = sorted(s * 1e6 for s in samples_s)
+    p99 = samples_us[min(len(samples_us) - 1, int(len(samples_us) * 0.99))]
+    print(f"{name:<24} min {samples_us[0]:7.0f} us  median {statistics.median(samples_us):7.0f} us  "
+          f"p99 {p99:7.0f} us  ({len(samples_us)} requests)")
+
+
+def bench_v1_rtt(ser: serial.Serial, count: int) -> None:
+    buffer = bytearray()
+    samples = []
+    for _ in range(count):
+        started = time.perf_counter()
+        ser.write(create_packet(CMD_STATUS))
+        read_v1_response(ser, CMD_STATUS, buffer)
+        samples.append(time.perf_counter() - started)
+    summarize("v1 'S' round trip", samples)
+
+
+def bench_v2(ser: serial.Serial, count: int) -> None:
+    client = GuiClientV2(ser, 1)
+    _, info = client.request(CMD_PROTOCOL_INFO)
+    window = info[3]
+
+    samples = []
+    for _ in range(count):
+        started = time.perf_counter()
+        client.request(CMD_STATUS)
+        samples.append(time.perf_counter() - started)
+    summarize("v2 'S' round trip", samples)
+
+    client.window = window
+    sequences = []
+    started = time.perf_counter()
+    for _ in range(count):
+        if len(sequences) >= window:
+            client.result(sequences.pop(0))
+        sequences.append(client.send(CMD_STATUS))
+    for sequence in sequences:
+        client.result(sequence)
+    elapsed = time.perf_counter() - started
+    print(f"{f'v2 pipelined (window {window})':<24} {count / elapsed:7.0f} requests/s")
+
+
+def bench_telemetry(ser: serial.Serial, seconds: float) -> None:
+    client = GuiClientV2(ser, 1)
+    try:
+        client.request(CMD_SUBSCRIBE, bytes([1]))
+    except RuntimeError:
+        print("telemetry                skipped (device not in normal operation)")
+        return
+
+    client.unsolicited.clear()
+    records = 0
+    payload_bytes = 0
+    started = time.perf_counter()
+    while time.perf_counter() - started < seconds:
+        try:
+            client.poll(0.1)
+        except TimeoutError:
+            pass
+        for _, command, payload in client.unsolicited:
+            if command == CMD_TELEMETRY and len(payload) >= 4:
+                records += payload[2]
+                payload_bytes += len(payload)
+        client.unsolicited.clear()
+    elapsed = time.perf_counter() - started
+    client.request(CMD_SUBSCRIBE, bytes([0]))
+    print(f"{'telemetry (full rate)':<24} {records / elapsed:7.0f} records/s  {payload_bytes / elapsed / 1024:6.1f} KiB/s")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Measure GUI link round-trip time and throughput")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--count", type=int, default=500, help="Requests per test")
+    parser.add_argument("--seconds", type=float, default=5.0, help="Duration of the telemetry test")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.001) as ser:
+        ser.reset_input_buffer()
+        bench_v1_rtt(ser, args.count)
+        bench_v2(ser, args.count)
+        bench_telemetry(ser, args.seconds)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+LiDAR GUI Protocol v2 - host side of the pipelined GUI protocol.
+
+Every frame is 0x00 COBS(SEQ CMD PAYLOAD CRC16) 0x00, where CRC16 is CRC-16/CCITT-FALSE
+over SEQ, CMD and PAYLOAD, little-endian. Payloads may be up to 1 KiB. Every response
+echoes the request's SEQ, so several requests can be kept in flight; the device executes
+them in order. v1 packets and debug text on the same port are skipped.
+
+Import GuiClientV2 from other tools, or run this file to measure request throughput:
+
+Usage: gui_protocol_v2.py --port COM5 [--baud 115200] [--count 1000] [--window 8]
+"""
+
+import argparse
+import binascii
+import struct
+import sys
+import time
+
+import serial
+
+DELIMITER = 0x00
+RSP_ACK = 0x06
+RSP_NAK = 0x15
+CMD_PROTOCOL_INFO = ord('P')
+CMD_STATUS = ord('S')
+MAX_PAYLOAD = 1024
+RESPONSE_TIMEOUT_S = 1.0
+
+
+def crc16(data: bytes) -> int:
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray([0])
+    code_pos = 0
+    for byte in data:
+        if byte:
+            out.append(byte)
+        if not byte or len(out) - code_pos == 0xFF:
+            out[code_pos] = len(out) - code_pos
+            code_pos = len(out)
+            out.append(0)
+    out[code_pos] = len(out) - code_pos
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes:
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("invalid COBS block")
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(sequence: int, command: int, payload: bytes = b'') -> bytes:
+    body = bytes([sequence & 0xFF, command]) + payload
+    return bytes([DELIMITER]) + cobs_encode(body + struct.pack('<H', crc16(body))) + bytes([DELIMITER])
+
+
+def decode_frame(encoded: bytes):
+    """Returns (sequence, command, payload), or None if the frame is not a valid v2 frame."""
+    try:
+        body = cobs_decode(encoded)
+    except ValueError:
+        return None
+    if len(body) < 4 or crc16(body[:-2]) != struct.unpack_from('<H', body, len(body) - 2)[0]:
+        return None
+    return body[0], body[1], body[2:-2]
+
+
+class GuiClientV2:
+    """Sends v2 requests, keeping up to `window` in flight, and matches responses by SEQ."""
+
+    def __init__(self, ser: serial.Serial, window: int = 8):
+        self.ser = ser
+        self.window = window
+        self.next_sequence = 0
+        self.buffer = bytearray()
+        self.pending = {}
+        self.unsolicited = []
+
+    def send(self, command: int, payload: bytes = b'') -> int:
+        """Sends a request without waiting and returns its sequence ID."""
+        while sum(response is None for response in self.pending.values()) >= self.window:
+            self.poll()
+        sequence = self.next_sequence
+        self.next_sequence = (self.next_sequence + 1) & 0xFF
+        self.pending[sequence] = None
+        self.ser.write(encode_frame(sequence, command, payload))
+        return sequence
+
+    def poll(self, timeout: float = RESPONSE_TIMEOUT_S) -> None:
+        """Reads until at least one frame arrives or the timeout expires."""
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            self.buffer += self.ser.read(self.ser.in_waiting or 1)
+            if self._parse():
+                return
+        raise TimeoutError(f"No response for {len(self.pending)} outstanding request(s)")
+
+    def _parse(self) -> bool:
+        got_frame = False
+        while True:
+            start = self.buffer.find(DELIMITER)
+            if start < 0:
+                self.buffer.clear()
+                return got_frame
+            end = self.buffer.find(DELIMITER, start + 1)
+            if end < 0:
+                del self.buffer[:start]
+                return got_frame
+            encoded = bytes(self.buffer[start + 1:end])
+            if not encoded:
+                # Two delimiters in a row: the second one may open the next frame
+                del self.buffer[:start + 1]
+                continue
+            frame = decode_frame(encoded)
+            if frame is None:
+                # Text or a partial frame between two frames - resynchronise on the closing delimiter
+                del self.buffer[:end]
+                continue
+            del self.buffer[:end + 1]
+            sequence, command, payload = frame
+            if sequence in self.pending and self.pending[sequence] is None:
+                self.pending[sequence] = (command, payload)
+            else:
+                self.unsolicited.append(frame)
+            got_frame = True
+
+    def result(self, sequence: int) -> tuple:
+        """Waits for the response to a request and returns (command, payload)."""
+        while self.pending.get(sequence) is None:
+            self.poll()
+        command, payload = self.pending.pop(sequence)
+        if command == RSP_NAK:
+            raise RuntimeError(f"Request {sequence} rejected (NAK 0x{payload[0]:02X})")
+        return command, payload
+
+    def request(self, command: int, payload: bytes = b'') -> tuple:
+        return self.result(self.send(command, payload))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Measure pipelined GUI protocol v2 request throughput")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--count", type=int, default=1000, help="Number of status requests")
+    parser.add_argument("--window", type=int, default=0, help="Requests in flight (default: device window)")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.01) as ser:
+        ser.reset_input_buffer()
+        client = GuiClientV2(ser, 1)
+        _, info = client.request(CMD_PROTOCOL_INFO)
+        version, max_payload, device_window = info[0], info[1] | (info[2] << 8), info[3]
+        print(f"Device protocol v{version}, max payload {max_payload} bytes, window {device_window}")
+
+        for window in sorted({1, args.window or device_window}):
+            client.window = window
+            started = time.time()
+            sequences = []
+            for _ in range(args.count):
+                if len(sequences) >= window:
+                    client.result(sequences.pop(0))
+                sequences.append(client.send(CMD_STATUS))
+            for sequence in sequences:
+                client.result(sequence)
+            elapsed = time.time() - started
+            print(f"window {window:2d}: {args.count} requests in {elapsed * 1000:.0f} ms "
+                  f"({args.count / elapsed:.0f} req/s, {elapsed / args.count * 1e6:.0f} us/request)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
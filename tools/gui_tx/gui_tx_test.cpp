@@ -0,0 +1,142 @@
+/**
+ * @file gui_tx_test.cpp
+ * @brief Host test of the GUI transmit stage with a telemetry-only host.
+ * @author The Lidar-RP2040-REV-0-4 Team
+ * @version 1.0
+ * @date 2025-09-07
+ *
+ * @details Usage: gui_tx_test
+ *
+ * Builds gui_tx.cpp from the firmware unchanged. Serial is a 256-byte USB
+ * transmit FIFO, the size arduino-pico gives the CDC port, which the host
+ * empties at a fixed rate per 1 ms loop pass. Only streamed packets are sent,
+ * as with tools/telemetry_stream.py, so nothing ever forces a blocking flush.
+ * The cases are a burst larger than the FIFO (a 32-frame batch at decimation
+ * 1) and a loop stall as long as a flash erase. After each, the stage must
+ * drain and the stream must continue; the host must only ever see whole
+ * packets, in order. Exits with 1 if any check fails.
+ */
+
+#include "gui_tx.h"
+#include <cstdio>
+#include <deque>
+
+/** @brief USB transmit FIFO of the arduino-pico CDC port. */
+#define TEST_FIFO_SIZE 256
+/** @brief Size of a streamed 'y' packet with 4 records, as framed. */
+#define TEST_PACKET_SIZE 64
+/** @brief Bytes the host reads per 1 ms loop pass (well below USB full speed). */
+#define TEST_HOST_BYTES_PER_MS 320
+
+static int failures = 0;
+static uint32_t now_us = 0;
+static std::deque<uint8_t> fifo;
+static uint32_t sent = 0;          ///< Packets handed to the stage.
+static uint8_t next_expected = 0;  ///< Number of the next packet the host should see.
+static uint32_t received = 0;
+static uint32_t dropped = 0;
+
+#define CHECK(condition)                                             \
+  do {                                                               \
+    if (!(condition)) {                                              \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);    \
+      failures++;                                                    \
+    }                                                                \
+  } while (0)
+
+// Firmware dependencies of the stage
+Stream Serial;
+mutex_t serial_mutex;
+uint32_t micros() { return now_us; }
+void mutex_enter_blocking(mutex_t*) {}
+bool mutex_try_enter(mutex_t*, uint32_t*) { return true; }
+void mutex_exit(mutex_t*) {}
+void diagNoteGuiTraffic() {}
+
+int Stream::availableForWrite() {
+  return TEST_FIFO_SIZE - (int)fifo.size();
+}
+
+size_t Stream::write(const uint8_t* data, size_t size) {
+  // A blocking write waits for the host; the stage must never need one here
+  CHECK(size <= (size_t)availableForWrite());
+  fifo.insert(fifo.end(), data, data + size);
+  return size;
+}
+
+/**
+ * @brief Reads what the host takes in one pass and checks the packet sequence.
+ */
+static void hostRead() {
+  static uint8_t packet[TEST_PACKET_SIZE];
+  static size_t have = 0;
+  for (int i = 0; i < TEST_HOST_BYTES_PER_MS && !fifo.empty(); i++) {
+    packet[have++] = fifo.front();
+    fifo.pop_front();
+    if (have < TEST_PACKET_SIZE) continue;
+    have = 0;
+    CHECK(packet[0] == 0x7E && packet[TEST_PACKET_SIZE - 1] == (uint8_t)~packet[1]);
+    if (packet[1] != next_expected) {
+      // The stage drops whole packets only, so a gap is fine but a torn packet is not
+      CHECK((uint8_t)(packet[1] - next_expected) < 128);
+    }
+    next_expected = packet[1] + 1;
+    received++;
+  }
+}
+
+/**
+ * @brief Offers one streamed packet to the stage, as sendBatch() does.
+ */
+static void streamPacket() {
+  uint8_t packet[TEST_PACKET_SIZE];
+  memset(packet, 0x55, sizeof(packet));
+  packet[0] = 0x7E;
+  packet[1] = (uint8_t)sent;
+  packet[TEST_PACKET_SIZE - 1] = (uint8_t)~sent;
+  sent++;
+  if (!guiTxStage(packet, sizeof(packet), false, false)) dropped++;
+}
+
+/**
+ * @brief Runs loop passes of 1 ms, streaming packets_per_ms each pass.
+ */
+static void runPasses(int passes, int packets_per_ms) {
+  for (int i = 0; i < passes; i++) {
+    for (int p = 0; p < packets_per_ms; p++) streamPacket();
+    guiTxService();
+    now_us += 1000;
+    hostRead();
+  }
+}
+
+int main() {
+  printf("A burst larger than the USB FIFO drains\n");
+  for (int i = 0; i < 8; i++) streamPacket();
+  CHECK(dropped == 0);
+  runPasses(20, 0);
+  CHECK(guiTxEmpty());
+  CHECK(received == 8);
+
+  printf("Steady streaming keeps flowing\n");
+  runPasses(1000, 2);
+  CHECK(dropped == 0);
+  runPasses(20, 0);
+  CHECK(guiTxEmpty());
+  CHECK(received == sent);
+
+  printf("A 50 ms stall drops packets, then the stream recovers\n");
+  for (int i = 0; i < 100; i++) streamPacket();  // The loop stood still: no service, no host reads
+  CHECK(dropped > 0);
+  runPasses(50, 2);  // Catching up may drop a few more while the stage is full
+  uint32_t dropped_after_recovery = dropped;
+  runPasses(1000, 2);
+  CHECK(dropped == dropped_after_recovery);
+  runPasses(20, 0);
+  CHECK(guiTxEmpty());
+  CHECK(received + dropped == sent);
+
+  printf("%lu packets received, %lu dropped\n", (unsigned long)received, (unsigned long)dropped);
+  printf(failures ? "%d checks failed\n" : "All checks passed\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file Arduino.h
+ * @brief Host build: the parts of the arduino-pico core that globals.h and the host-built firmware sources use.
+ */
+#ifndef HOST_SHIM_ARDUINO_H
+#define HOST_SHIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+
+#ifndef XIP_BASE
+#define XIP_BASE 0x10000000u
+#endif
+
+#define __not_in_flash_func(f) f
+
+typedef unsigned int uint;
+
+using std::min;
+using std::max;
+
+uint32_t millis();
+uint32_t micros();
+void noInterrupts();
+void interrupts();
+
+class String {
+public:
+  String(const char* = "") {}
+  const char* c_str() const { return ""; }
+};
+
+/** @brief Host build: the USB serial calls of the GUI transmit stage, implemented by the test. */
+class Stream {
+public:
+  int availableForWrite();
+  size_t write(const uint8_t* data, size_t size);
+};
+extern Stream Serial;
+
+struct RP2040 {
+  void idleOtherCore();
+  void resumeOtherCore();
+};
+extern RP2040 rp2040;
+
+#endif // HOST_SHIM_ARDUINO_H
@@ -0,0 +1,10 @@
+/**
+ * @file LittleFS.h
+ * @brief Host build: empty stand-in, the config store writes the flash region directly.
+ */
+#ifndef HOST_SHIM_LITTLEFS_H
+#define HOST_SHIM_LITTLEFS_H
+
+#include <Arduino.h>
+
+#endif // HOST_SHIM_LITTLEFS_H
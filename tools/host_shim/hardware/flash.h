@@ -0,0 +1,17 @@
+/**
+ * @file flash.h
+ * @brief Host build: the pico-sdk flash calls, implemented by the test on a RAM image.
+ */
+#ifndef HOST_SHIM_HARDWARE_FLASH_H
+#define HOST_SHIM_HARDWARE_FLASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count);
+
+#endif // HOST_SHIM_HARDWARE_FLASH_H
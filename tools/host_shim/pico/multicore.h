@@ -0,0 +1,16 @@
+/**
+ * @file multicore.h
+ * @brief Host build: the pico-sdk mutex type named in globals.h and its calls.
+ */
+#ifndef HOST_SHIM_PICO_MULTICORE_H
+#define HOST_SHIM_PICO_MULTICORE_H
+
+#include <stdint.h>
+
+typedef struct { int owner; } mutex_t;
+
+void mutex_enter_blocking(mutex_t* mtx);
+bool mutex_try_enter(mutex_t* mtx, uint32_t* owner_out);
+void mutex_exit(mutex_t* mtx);
+
+#endif // HOST_SHIM_PICO_MULTICORE_H
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+LiDAR Params - lists, reads and writes the runtime globals by parameter ID ('Q', 'K' and
+'k' commands over GUI protocol v2).
+
+The parameter list, types, ranges and defaults are read from the device, so parameters
+added in newer firmware show up without updating this tool. Values are checked against
+the device's ranges before they are sent. Setting needs configuration mode; use 'W'
+(or the GUI) to save the new values to flash.
+
+Usage: params.py --port COM5 list
+       params.py --port COM5 get [NAME ...]
+       params.py --port COM5 set NAME=VALUE [NAME=VALUE ...]
+"""
+
+import argparse
+import struct
+import sys
+
+import serial
+
+from gui_protocol_v2 import GuiClientV2
+
+CMD_DISCOVER = ord('Q')
+CMD_GET = ord('K')
+CMD_SET = ord('k')
+TYPE_U32 = 0
+TYPE_F32 = 1
+FLAG_LEGACY_BLOCK = 0x01
+FLAG_RESTART = 0x02
+DESCRIPTOR_FIXED_SIZE = 16
+
+
+class Param:
+    def __init__(self, pid: int, ptype: int, flags: int, raw: bytes, name: str):
+        self.id = pid
+        self.type = ptype
+        self.flags = flags
+        self.name = name
+        self.min, self.max, self.default = struct.unpack('<fff' if ptype == TYPE_F32 else '<III', raw)
+
+    def pack(self, value) -> bytes:
+        return struct.pack('<f' if self.type == TYPE_F32 else '<I', value)
+
+    def unpack(self, raw: bytes):
+        return struct.unpack('<f' if self.type == TYPE_F32 else '<I', raw)[0]
+
+    def parse(self, text: str):
+        value = float(text) if self.type == TYPE_F32 else int(text, 0)
+        if not self.min <= value <= self.max:
+            raise ValueError(f"{self.name} must be between {self.min:g} and {self.max:g}")
+        return value
+
+
+def discover(client: GuiClientV2) -> list:
+    params = []
+    while True:
+        _, payload = client.request(CMD_DISCOVER, bytes([len(params)]))
+        total, _, count = payload[:3]
+        pos = 3
+        for _ in range(count):
+            pid, ptype, flags = payload[pos:pos + 3]
+            name_len = payload[pos + 15]
+            name = payload[pos + 16:pos + 16 + name_len].decode()
+            params.append(Param(pid, ptype, flags, payload[pos + 3:pos + 15], name))
+            pos += DESCRIPTOR_FIXED_SIZE + name_len
+        if len(params) >= total or count == 0:
+            return params
+
+
+def read_values(client: GuiClientV2, params: list) -> dict:
+    _, payload = client.request(CMD_GET, bytes(p.id for p in params))
+    by_id = {p.id: p for p in params}
+    return {payload[i]: by_id[payload[i]].unpack(payload[i + 1:i + 5]) for i in range(0, len(payload), 5)}
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="List, read and write LiDAR runtime parameters")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("action", choices=["list", "get", "set"], help="What to do")
+    parser.add_argument("args", nargs="*", help="Parameter names (get) or NAME=VALUE pairs (set)")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.01) as ser:
+        ser.reset_input_buffer()
+        client = GuiClientV2(ser, 1)
+        params = discover(client)
+        by_name = {p.name: p for p in params}
+
+        if args.action == "list":
+            values = read_values(client, params)
+            for p in params:
+                notes = " (after reset)" if p.flags & FLAG_RESTART else ""
+                print(f"{p.id:3d} {p.name:<36} {values[p.id]:>10g}  [{p.min:g} .. {p.max:g}, default {p.default:g}]{notes}")
+            return 0
+
+        if args.action == "get":
+            selected = [by_name[name] for name in args.args] if args.args else params
+            values = read_values(client, selected)
+            for p in selected:
+                print(f"{p.name}={values[p.id]:g}")
+            return 0
+
+        request = bytearray()
+        for pair in args.args:
+            name, _, text = pair.partition("=")
+            if name not in by_name:
+                print(f"Unknown parameter {name}", file=sys.stderr)
+                return 1
+            p = by_name[name]
+            try:
+                request += bytes([p.id]) + p.pack(p.parse(text))
+            except ValueError as error:
+                print(error, file=sys.stderr)
+                return 1
+        client.request(CMD_SET, bytes(request))
+        print(f"Set {len(args.args)} parameter(s); send 'W' to save them to flash")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""
+LiDAR Recorder Dump - downloads the flash frame recorder log ('H' command over GUI
+protocol v2), decodes it and writes the frames to CSV, oldest first.
+
+The report at the end gives the encoded size in bytes/frame, the recorder's counters
+since boot and any gaps in the sector sequence (sectors lost to a reset while their
+page was still in RAM). Recording stops once the log is full; use --erase to clear
+it and arm the next capture. The device must be in configuration mode.
+
+--raw saves the log's sectors oldest first, for tools/frame_codec.
+
+Usage: recorder_dump.py --port COM5 [--baud 115200] [--csv frames.csv] [--raw log.bin]
+       recorder_dump.py --port COM5 --erase
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import zlib
+
+import serial
+
+from frame_stream import FrameDecoder
+from gui_protocol_v2 import GuiClientV2
+
+CMD_RECORDER = ord('H')
+OP_INFO = 0
+OP_READ = 1
+OP_ERASE = 2
+SECTOR_MAGIC = 0x4345524C
+FORMAT_VERSION = 2  # Must match RECORDER_FORMAT_VERSION in recorder.h
+HEADER = struct.Struct('<IIIHHB3x')
+NO_SECTOR = 0xFFFF
+
+
+def decode_sector(data: bytes, frame_count: int) -> list:
+    """Returns (timestamp_us, sensor, distance, strength, temperature) tuples."""
+    return FrameDecoder().decode(data, frame_count)
+
+
+def read_sector_bytes(client: GuiClientV2, sector: int, offset: int, size: int) -> bytes:
+    data = bytearray()
+    while len(data) < size:
+        _, payload = client.request(CMD_RECORDER, struct.pack('<BHH', OP_READ, sector, offset + len(data)))
+        if len(payload) <= 4:
+            break
+        data += payload[4:]
+    return bytes(data[:size])
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Download and decode the LiDAR flash frame recorder log")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--csv", help="Write the decoded frames to this CSV file")
+    parser.add_argument("--raw", help="Write the raw log sectors, oldest first, to this file")
+    parser.add_argument("--erase", action="store_true", help="Erase the log instead of downloading it")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.01) as ser:
+        ser.reset_input_buffer()
+        client = GuiClientV2(ser, 4)
+        if args.erase:
+            client.request(CMD_RECORDER, bytes([OP_ERASE]))
+            print("Log erase started; it runs in the background")
+            return 0
+
+        _, info = client.request(CMD_RECORDER, bytes([OP_INFO]))
+        sector_count, newest, sector_size, busy = struct.unpack_from('<HHHB', info, 0)
+        recorded, dropped, encoded, written, erased = struct.unpack_from('<5I', info, 7)
+        missed, full = struct.unpack_from('<IB', info, 27) if len(info) >= 32 else (0, 0)
+        if newest == NO_SECTOR:
+            print(f"Log is empty ({sector_count} sectors of {sector_size} bytes)"
+                  f"{'; full - erase it to record' if full else ''}")
+            return 0
+
+        sectors = []
+        for sector in range(sector_count):
+            header = HEADER.unpack(read_sector_bytes(client, sector, 0, HEADER.size))
+            magic, sequence, crc, data_bytes, frame_count, fmt = header
+            if magic == SECTOR_MAGIC:
+                sectors.append((sequence, sector, crc, data_bytes, frame_count, fmt))
+        newest_sequence = max(s[0] for s in sectors if s[1] == newest)
+        sectors.sort(key=lambda s: (s[0] - newest_sequence - 1) & 0xFFFFFFFF)
+
+        frames = []
+        raw = bytearray()
+        total_bytes = 0
+        bad = 0
+        gaps = 0
+        previous = None
+        for sequence, sector, crc, data_bytes, frame_count, fmt in sectors:
+            if previous is not None and sequence != (previous + 1) & 0xFFFFFFFF:
+                gaps += 1
+            previous = sequence
+            data = read_sector_bytes(client, sector, HEADER.size, data_bytes)
+            header = HEADER.pack(SECTOR_MAGIC, sequence, crc, data_bytes, frame_count, fmt)
+            raw += (header + data).ljust(sector_size, b'\xff')
+            if fmt != FORMAT_VERSION or zlib.crc32(data) != crc:
+                bad += 1
+                continue
+            frames += decode_sector(data, frame_count)
+            total_bytes += data_bytes
+
+    if args.raw:
+        with open(args.raw, "wb") as f:
+            f.write(raw)
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["timestamp_us", "sensor", "distance_cm", "strength", "temperature"])
+            writer.writerows(frames)
+
+    span_s = ((frames[-1][0] - frames[0][0]) & 0xFFFFFFFF) / 1e6 if len(frames) > 1 else 0
+    print(f"{len(sectors)} sectors, {len(frames)} frames over {span_s:.1f} s, "
+          f"{total_bytes / max(1, len(frames)):.2f} bytes/frame ({bad} bad sectors, {gaps} sequence gaps)")
+    print(f"Since boot: {recorded} frames recorded, {dropped} dropped, {missed} missed at the sensors, "
+          f"{encoded / max(1, recorded):.2f} bytes/frame, {written} sectors written, {erased} erased"
+          f"{' (flash work pending)' if busy else ''}")
+    if full:
+        print("Log is full and recording has stopped; erase it with --erase to record again")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
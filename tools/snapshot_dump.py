@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+LiDAR Snapshot Dump - downloads the trigger snapshots ('N' command over GUI protocol v2)
+and writes each one to CSV, with the time of every sample relative to its trigger.
+
+Each snapshot holds the samples before and after a trigger latch fired, with the trigger
+stages of every sample, the velocity estimator state at the trigger and the
+configuration epoch (the CRC-32 that 'B' reports for the configuration in effect, as
+shown by config_transfer.py). Works in normal operation; snapshots kept in RAM are read
+first, then those persisted to flash.
+
+Usage: snapshot_dump.py --port COM5 [--baud 115200] [--csv snapshot]
+       (writes snapshot_<sequence>.csv per snapshot)
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import zlib
+
+import serial
+
+from gui_protocol_v2 import GuiClientV2
+
+CMD_SNAPSHOT = ord('N')
+OP_INFO = 0
+OP_READ = 1
+OP_READ_SEQUENCE = 2
+SOURCE_RAM = 0
+SOURCE_FLASH = 1
+SNAPSHOT_MAGIC = 0x504E534C
+FORMAT_VERSION = 1  # Must match SNAPSHOT_FORMAT_VERSION in snapshot.h
+HEADER = struct.Struct('<IIIIIHHHHB3xBBBB')
+ESTIMATOR = struct.Struct('<fIIB3x')
+HEADER_SIZE = HEADER.size + 2 * ESTIMATOR.size
+SAMPLE = struct.Struct('<IHHfBBBx')
+CRC_OFFSET = 12  # The CRC covers the record after its own field
+SOURCE_FUSED = 0x0F
+NO_FUSION = 0xFF
+FLAG_RAW = 0x01
+FLAG_DEBOUNCED = 0x02
+FLAG_LATCHED = 0x04
+LOAD_MODES = ["normal", "shed", "decimate"]
+FUSION_MODES = ["dual", "single A", "single B", "no sensor"]
+
+
+def read_record(client: GuiClientV2, source: int, index: int, size: int) -> bytes:
+    data = bytearray()
+    while len(data) < size:
+        _, payload = client.request(CMD_SNAPSHOT, struct.pack('<BBBH', OP_READ, source, index, len(data)))
+        if len(payload) <= 4:
+            break
+        data += payload[4:]
+        if source == SOURCE_RAM:
+            # A new snapshot moves the RAM indices; read the rest of this one by its number
+            return read_ram_record(client, HEADER.unpack_from(data, 0)[1], data, size)
+    return bytes(data[:size])
+
+
+def read_ram_record(client: GuiClientV2, sequence: int, data: bytearray, size: int) -> bytes:
+    """Reads the rest of a RAM snapshot by number. Raises RuntimeError once it has left RAM."""
+    while len(data) < size:
+        _, payload = client.request(CMD_SNAPSHOT, struct.pack('<BIH', OP_READ_SEQUENCE, sequence, len(data)))
+        if len(payload) <= 6:
+            break
+        data += payload[6:]
+    # Read the header again: the record must still be the same snapshot, and its CRC may be set by now
+    _, payload = client.request(CMD_SNAPSHOT, struct.pack('<BIH', OP_READ_SEQUENCE, sequence, 0))
+    header = payload[6:6 + HEADER.size]
+    if len(header) < HEADER.size or HEADER.unpack_from(header, 0)[1] != sequence:
+        raise RuntimeError(f"Snapshot {sequence} changed while reading")
+    data[8:12] = header[8:12]
+    return bytes(data[:size])
+
+
+def parse_record(data: bytes) -> dict:
+    """Returns the header fields and the samples in chronological order."""
+    (magic, sequence, crc, epoch, trigger_ts, capacity, first, count, trigger_index, fmt,
+     source, switch_code, load_mode, fusion_mode) = HEADER.unpack_from(data, 0)
+    estimators = [ESTIMATOR.unpack_from(data, HEADER.size + i * ESTIMATOR.size) for i in range(2)]
+    samples = []
+    for i in range(min(count, capacity)):
+        slot = (first + i) % capacity
+        samples.append(SAMPLE.unpack_from(data, HEADER_SIZE + slot * SAMPLE.size))
+    return {
+        "magic": magic, "sequence": sequence, "crc": crc, "epoch": epoch, "trigger_ts": trigger_ts,
+        "capacity": capacity, "trigger_index": trigger_index, "format": fmt, "source": source,
+        "switch_code": switch_code, "load_mode": load_mode, "fusion_mode": fusion_mode,
+        "estimators": estimators, "samples": samples,
+        "crc_ok": zlib.crc32(data[CRC_OFFSET:]) == crc,
+        "crc_set": crc != 0,
+    }
+
+
+def source_name(source: int) -> str:
+    return "fused" if source == SOURCE_FUSED else f"sensor {source}"
+
+
+def describe(record: dict, where: str) -> str:
+    lines = [f"Snapshot {record['sequence']} ({where}): {source_name(record['source'])}, "
+             f"switch {record['switch_code']}, {len(record['samples'])} samples "
+             f"({record['trigger_index']} before the trigger), config epoch 0x{record['epoch']:08X}, "
+             f"load mode {LOAD_MODES[record['load_mode']] if record['load_mode'] < len(LOAD_MODES) else record['load_mode']}"]
+    if record['fusion_mode'] != NO_FUSION:
+        mode = record['fusion_mode']
+        lines[0] += f", fusion {FUSION_MODES[mode] if mode < len(FUSION_MODES) else mode}"
+    count = 2 if record['source'] == SOURCE_FUSED else 1
+    for i, (velocity, last_movement, errors, history) in enumerate(record['estimators'][:count]):
+        lines.append(f"  estimator {i}: {velocity:.1f} cm/s, {history} frames of history, "
+                     f"last movement at {last_movement} ms, {errors} errors")
+    return "\n".join(lines)
+
+
+def write_csv(path: str, record: dict) -> None:
+    with open(path, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["time_us", "timestamp_us", "source", "distance_cm", "strength", "velocity_cms",
+                         "raw", "debounced", "latched", "switch_code"])
+        for timestamp, distance, strength, velocity, source, flags, switch_code in record['samples']:
+            relative = ((timestamp - record['trigger_ts'] + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+            writer.writerow([relative, timestamp, source, distance, strength, f"{velocity:.2f}",
+                             int(bool(flags & FLAG_RAW)), int(bool(flags & FLAG_DEBOUNCED)),
+                             int(bool(flags & FLAG_LATCHED)), switch_code])
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Download the LiDAR trigger snapshots")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--csv", help="Write each snapshot to <prefix>_<sequence>.csv")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.01) as ser:
+        ser.reset_input_buffer()
+        client = GuiClientV2(ser, 4)
+        _, info = client.request(CMD_SNAPSHOT, bytes([OP_INFO]))
+        ram_count, flash_slots, capturing, record_size, pre, post = struct.unpack_from('<BBBHHH', info, 0)
+        captured, merged, persisted, aborted = struct.unpack_from('<4I', info, 9)
+        print(f"{pre} + 1 + {post} samples per snapshot; since boot: {captured} captured, {merged} merged "
+              f"triggers, {persisted} persisted, {aborted} persist aborted"
+              f"{' (capture running)' if capturing else ''}")
+
+        records = {}
+        locations = [(SOURCE_RAM, i, "RAM") for i in range(ram_count)]
+        locations += [(SOURCE_FLASH, i, f"flash slot {i}") for i in range(flash_slots)]
+        for source, index, where in locations:
+            try:
+                data = read_record(client, source, index, record_size)
+            except RuntimeError:
+                continue  # Empty flash slot, or a RAM snapshot recycled while reading
+            record = parse_record(data)
+            if record['magic'] != SNAPSHOT_MAGIC or record['format'] != FORMAT_VERSION:
+                continue
+            if record['crc_set'] and not record['crc_ok']:
+                print(f"Snapshot {record['sequence']} ({where}): CRC mismatch, discarded")
+                continue
+            if record['sequence'] in records:
+                continue  # Persisted copy of a snapshot still in RAM
+            records[record['sequence']] = (record, where)
+
+    for sequence in sorted(records):
+        record, where = records[sequence]
+        print(describe(record, where))
+        if args.csv:
+            write_csv(f"{args.csv}_{sequence}.csv", record)
+    if not records:
+        print("No snapshots")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+LiDAR Telemetry Stream - subscribes to the binary telemetry stream over the GUI protocol
+('Y' command) and prints or logs the decoded records as CSV.
+
+Works in normal operation. Lost records (gaps in the sequence numbers) are counted and
+reported when the stream is stopped with Ctrl+C.
+
+Usage: telemetry_stream.py --port COM5 [--baud 115200] [--decimation 1] [-o telemetry.csv]
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import serial
+
+START_BYTE = 0x7E
+CMD_SUBSCRIBE = ord('Y')
+CMD_TELEMETRY = ord('y')
+RSP_ACK = 0x06
+RSP_NAK = 0x15
+HEADER_FORMAT = '<HBB'
+RECORD_FORMAT = '<IHHfBB'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+FLAG_TRIGGER = 0x01
+SOURCE_SHIFT = 4
+SOURCE_FUSED = 0x0F
+RESPONSE_TIMEOUT_S = 1.0
+
+
+def create_packet(command: int, payload: bytes = b'') -> bytes:
+    body = bytes([command, len(payload)]) + payload
+    return bytes([START_BYTE]) + body + bytes([sum(body) & 0xFF])
+
+
+def read_packets(ser: serial.Serial, buffer: bytearray):
+    """Yields (command, payload) for every valid packet in the buffer, skipping debug text."""
+    buffer += ser.read(ser.in_waiting or 1)
+    while True:
+        start = buffer.find(START_BYTE)
+        if start < 0:
+            buffer.clear()
+            return
+        del buffer[:start]
+        if len(buffer) < 4 or len(buffer) < 4 + buffer[2]:
+            return
+        length = buffer[2]
+        packet = bytes(buffer[:4 + length])
+        if (sum(packet[1:3 + length]) & 0xFF) != packet[3 + length]:
+            del buffer[:1]
+            continue
+        del buffer[:4 + length]
+        yield packet[1], packet[3:3 + length]
+
+
+def subscribe(ser: serial.Serial, buffer: bytearray, decimation: int) -> None:
+    ser.write(create_packet(CMD_SUBSCRIBE, bytes([decimation])))
+    deadline = time.time() + RESPONSE_TIMEOUT_S
+    while time.time() < deadline:
+        for command, payload in read_packets(ser, buffer):
+            if command == RSP_NAK:
+                raise RuntimeError(f"Device rejected subscription (NAK 0x{payload[0]:02X})")
+            if command == RSP_ACK and payload[:1] == bytes([CMD_SUBSCRIBE]):
+                return
+    raise TimeoutError("No subscription response from device")
+
+
+def decode_batch(payload: bytes) -> tuple:
+    first_sequence, count, decimation = struct.unpack_from(HEADER_FORMAT, payload, 0)
+    records = []
+    for i in range(count):
+        offset = HEADER_SIZE + i * RECORD_SIZE
+        if offset + RECORD_SIZE > len(payload):
+            break
+        timestamp, distance, strength, velocity, flags, queue_depth = struct.unpack_from(RECORD_FORMAT, payload, offset)
+        source = flags >> SOURCE_SHIFT
+        records.append(((first_sequence + i) & 0xFFFF, timestamp, distance, strength, velocity,
+                        int(bool(flags & FLAG_TRIGGER)), "fused" if source == SOURCE_FUSED else str(source),
+                        queue_depth))
+    return first_sequence, decimation, records
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Stream binary telemetry from the LiDAR controller")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--decimation", type=int, default=1, help="Send every Nth processed sample (1-255)")
+    parser.add_argument("-o", "--output", help="CSV file (default: print to stdout)")
+    args = parser.parse_args()
+    if not 1 <= args.decimation <= 255:
+        parser.error("--decimation must be 1-255")
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    out.write("sequence,timestamp_us,distance_cm,strength,velocity_cm_s,trigger,source,queue_depth\n")
+
+    received = 0
+    lost = 0
+    expected = None
+    started = time.time()
+    buffer = bytearray()
+    with serial.Serial(args.port, args.baud, timeout=0.05) as ser:
+        ser.reset_input_buffer()
+        subscribe(ser, buffer, args.decimation)
+        try:
+            while True:
+                for command, payload in read_packets(ser, buffer):
+                    if command != CMD_TELEMETRY or len(payload) < HEADER_SIZE:
+                        continue
+                    first_sequence, _, records = decode_batch(payload)
+                    if expected is not None:
+                        lost += (first_sequence - expected) & 0xFFFF
+                    expected = (first_sequence + len(records)) & 0xFFFF
+                    received += len(records)
+                    for record in records:
+                        out.write(",".join(f"{v:.2f}" if isinstance(v, float) else str(v) for v in record) + "\n")
+        except KeyboardInterrupt:
+            pass
+        finally:
+            ser.write(create_packet(CMD_SUBSCRIBE, bytes([0])))
+
+    if out is not sys.stdout:
+        out.close()
+    elapsed = max(time.time() - started, 1e-6)
+    print(f"Received {received} records ({received / elapsed:.0f}/s), lost {lost}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
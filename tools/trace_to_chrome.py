@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+LiDAR Trace Dump - fetches the on-device trace rings over the GUI protocol ('X' command)
+and writes them as Chrome trace JSON (open in chrome://tracing or ui.perfetto.dev).
+
+Works in normal operation, where the Core 1 pipeline trace points are recorded, and in
+configuration mode. Recording pauses while the rings are read. Core 0 and Core 1
+appear as two threads of one process so their timelines line up.
+
+Usage: trace_to_chrome.py --port COM5 [--baud 115200] [-o trace.json]
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+import serial
+
+START_BYTE = 0x7E
+CMD_TRACE = ord('X')
+RSP_NAK = 0x15
+EVENT_SIZE = 8
+RESPONSE_TIMEOUT_S = 1.0
+
+# Must match TraceId in trace.h
+TRACE_NAMES = [
+    "core0_state",
+    "core1_state",
+    "system_state",
+    "frame_parse",
+    "queue_pop",
+    "velocity",
+    "trigger",
+    "led_show",
+    "flash_write",
+    "gui_command",
+]
+
+
+def create_packet(command: int, payload: bytes = b'') -> bytes:
+    body = bytes([command, len(payload)]) + payload
+    return bytes([START_BYTE]) + body + bytes([sum(body) & 0xFF])
+
+
+def read_response(ser: serial.Serial, command: int) -> bytes:
+    """Returns the payload of the next valid response to command, skipping debug text."""
+    buffer = bytearray()
+    deadline = time.time() + RESPONSE_TIMEOUT_S
+    while time.time() < deadline:
+        buffer += ser.read(ser.in_waiting or 1)
+        while True:
+            start = buffer.find(START_BYTE)
+            if start < 0:
+                buffer.clear()
+                break
+            del buffer[:start]
+            if len(buffer) < 4 or len(buffer) < 4 + buffer[2]:
+                break
+            length = buffer[2]
+            packet = bytes(buffer[:4 + length])
+            if (sum(packet[1:3 + length]) & 0xFF) != packet[3 + length]:
+                del buffer[:1]
+                continue
+            del buffer[:4 + length]
+            if packet[1] == RSP_NAK:
+                raise RuntimeError(f"Device rejected trace request (NAK 0x{packet[3]:02X})")
+            if packet[1] == command:
+                return packet[3:3 + length]
+    raise TimeoutError("No trace response from device")
+
+
+def fetch_core(ser: serial.Serial, core: int) -> list:
+    events = []
+    index = 0
+    while True:
+        ser.write(create_packet(CMD_TRACE, bytes([core, index & 0xFF, index >> 8])))
+        payload = read_response(ser, CMD_TRACE)
+        total = payload[3] | (payload[4] << 8)
+        chunk = payload[5:]
+        for offset in range(0, len(chunk) - EVENT_SIZE + 1, EVENT_SIZE):
+            events.append(struct.unpack_from('<IBBH', chunk, offset))
+        index += len(chunk) // EVENT_SIZE
+        if index >= total or not chunk:
+            return events
+
+
+def to_chrome(events_by_core: dict) -> dict:
+    trace_events = []
+    for core, events in events_by_core.items():
+        trace_events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": core,
+                             "args": {"name": f"Core {core}"}})
+        wrap = 0
+        previous = None
+        for timestamp, event_type, trace_id, arg in events:
+            # micros() wraps every ~71 minutes
+            if previous is not None and timestamp < previous and previous - timestamp > 0x80000000:
+                wrap += 1 << 32
+            previous = timestamp
+            name = TRACE_NAMES[trace_id] if trace_id < len(TRACE_NAMES) else f"trace_{trace_id}"
+            event = {"name": name, "ph": chr(event_type), "ts": timestamp + wrap,
+                     "pid": 1, "tid": core, "args": {"arg": arg}}
+            if event["ph"] == 'i':
+                event["s"] = "t"
+            trace_events.append(event)
+    return {"traceEvents": trace_events, "displayTimeUnit": "ms"}
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Dump the LiDAR controller trace buffer as Chrome trace JSON")
+    parser.add_argument("--port", required=True, help="Serial port of the controller")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("-o", "--output", default="trace.json", help="Output JSON file")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.05) as ser:
+        ser.reset_input_buffer()
+        try:
+            events_by_core = {core: fetch_core(ser, core) for core in (0, 1)}
+        finally:
+            # Resume recording even if the dump failed part way
+            ser.write(create_packet(CMD_TRACE, bytes([0xFF])))
+
+    with open(args.output, "w") as f:
+        json.dump(to_chrome(events_by_core), f)
+    print(f"Wrote {sum(len(e) for e in events_by_core.values())} events to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())